@@ -1,6 +1,6 @@
 
 
-Texture2D diffuse : register(t0);
+Texture2D textures[] : register(t0, space1);
 SamplerState samplerState : register(s0);
 
 struct PixelInputType
@@ -9,9 +9,10 @@ struct PixelInputType
     float4 color : COLOR;
     float3 normal : NORMAL;
     float2 textureCoordinates : TEXCOORD0;
+    nointerpolation uint textureIndex : TEXTUREINDEX;
 };
 
 float4 Main(PixelInputType input) : SV_TARGET
 {
-    return diffuse.Sample(samplerState, input.textureCoordinates) * input.color;
+    return textures[NonUniformResourceIndex(input.textureIndex)].Sample(samplerState, input.textureCoordinates) * input.color;
 }
\ No newline at end of file
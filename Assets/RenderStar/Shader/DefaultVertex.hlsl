@@ -6,6 +6,11 @@ struct VertexInputType
     float3 color : COLOR;
     float3 normal : NORMAL;
     float2 textureCoordinates : TEXCOORD0;
+    float4 world0 : WORLD0;
+    float4 world1 : WORLD1;
+    float4 world2 : WORLD2;
+    float4 world3 : WORLD3;
+    uint textureIndex : TEXTUREINDEX;
 };
 
 struct PixelInputType
@@ -14,13 +19,16 @@ struct PixelInputType
     float4 color : COLOR;
     float3 normal : NORMAL;
     float2 textureCoordinates : TEXCOORD0;
+    nointerpolation uint textureIndex : TEXTUREINDEX;
 };
 
 PixelInputType Main(VertexInputType input)
 {
     PixelInputType output;
     
-    float4 worldPosition = float4(input.position, 1.0f);
+    float4x4 world = float4x4(input.world0, input.world1, input.world2, input.world3);
+
+    float4 worldPosition = mul(float4(input.position, 1.0f), world);
     
     output.position = worldPosition;
     
@@ -28,6 +36,7 @@ PixelInputType Main(VertexInputType input)
     output.normal = input.normal;
     
     output.textureCoordinates = input.textureCoordinates;
+    output.textureIndex = input.textureIndex;
 
     return output;
 }
\ No newline at end of file
@@ -0,0 +1,162 @@
+#pragma once
+
+#include "RenderStar/Util/Typedefs.hpp"
+
+using namespace RenderStar::Util;
+
+namespace RenderStar
+{
+	namespace Core
+	{
+        struct FreeListStatistics
+        {
+            Size capacity = 0;
+            Size usedSize = 0;
+            Size peakUsedSize = 0;
+            Size allocationCount = 0;
+            Size liveAllocationCount = 0;
+            Size freeBlockCount = 0;
+            Size largestFreeBlock = 0;
+
+            float GetFragmentation() const
+            {
+                const Size freeSize = capacity - usedSize;
+
+                if (freeSize == 0)
+                    return 0.0f;
+
+                return 1.0f - static_cast<float>(largestFreeBlock) / static_cast<float>(freeSize);
+            }
+        };
+
+        class FreeListAllocator
+        {
+
+        public:
+
+            FreeListAllocator() = default;
+
+            explicit FreeListAllocator(Size capacity)
+            {
+                Grow(capacity);
+            }
+
+            Optional<Size> Allocate(Size size)
+            {
+                if (size == 0)
+                    return Size(0);
+
+                auto block = freeBySize.lower_bound({ size, 0 });
+
+                if (block == freeBySize.end())
+                    return std::nullopt;
+
+                const Size blockSize = block->first;
+                const Size offset = block->second;
+
+                freeBySize.erase(block);
+                freeByOffset.erase(offset);
+
+                if (blockSize > size)
+                    InsertFreeBlock(offset + size, blockSize - size);
+
+                usedSize += size;
+                peakUsedSize = std::max(peakUsedSize, usedSize);
+
+                ++allocationCount;
+                ++liveAllocationCount;
+
+                return offset;
+            }
+
+            void Free(Size offset, Size size)
+            {
+                if (size == 0)
+                    return;
+
+                usedSize -= size;
+                --liveAllocationCount;
+
+                Release(offset, size);
+            }
+
+            void Grow(Size newCapacity)
+            {
+                if (newCapacity <= capacity)
+                    return;
+
+                const Size oldCapacity = capacity;
+
+                capacity = newCapacity;
+
+                Release(oldCapacity, newCapacity - oldCapacity);
+            }
+
+            Size GetCapacity() const
+            {
+                return capacity;
+            }
+
+            FreeListStatistics GetStatistics() const
+            {
+                FreeListStatistics out;
+
+                out.capacity = capacity;
+                out.usedSize = usedSize;
+                out.peakUsedSize = peakUsedSize;
+                out.allocationCount = allocationCount;
+                out.liveAllocationCount = liveAllocationCount;
+                out.freeBlockCount = freeByOffset.size();
+                out.largestFreeBlock = freeBySize.empty() ? 0 : freeBySize.rbegin()->first;
+
+                return out;
+            }
+
+        private:
+
+            void Release(Size offset, Size size)
+            {
+                auto next = freeByOffset.lower_bound(offset);
+
+                if (next != freeByOffset.end() && next->first == offset + size)
+                {
+                    size += next->second;
+
+                    freeBySize.erase({ next->second, next->first });
+                    next = freeByOffset.erase(next);
+                }
+
+                if (next != freeByOffset.begin())
+                {
+                    auto previous = std::prev(next);
+
+                    if (previous->first + previous->second == offset)
+                    {
+                        offset = previous->first;
+                        size += previous->second;
+
+                        freeBySize.erase({ previous->second, previous->first });
+                        freeByOffset.erase(previous);
+                    }
+                }
+
+                InsertFreeBlock(offset, size);
+            }
+
+            void InsertFreeBlock(Size offset, Size size)
+            {
+                freeByOffset[offset] = size;
+                freeBySize.insert({ size, offset });
+            }
+
+            Map<Size, Size> freeByOffset;
+            Set<Pair<Size, Size>> freeBySize;
+
+            Size capacity = 0;
+            Size usedSize = 0;
+            Size peakUsedSize = 0;
+            Size allocationCount = 0;
+            Size liveAllocationCount = 0;
+        };
+	}
+}
\ No newline at end of file
@@ -0,0 +1,411 @@
+#pragma once
+
+#include "RenderStar/Core/Logger.hpp"
+#include "RenderStar/Core/WorkStealingDeque.hpp"
+#include "RenderStar/Util/Typedefs.hpp"
+
+using namespace RenderStar::Util;
+
+namespace RenderStar
+{
+	namespace Core
+	{
+        struct Job
+        {
+            Function<void()> function;
+
+            Job* parent = nullptr;
+
+            AtomicInt unfinishedJobs = 0;
+            AtomicInt continuationCount = 0;
+            AtomicInt storedContinuations = 0;
+
+            AtomicInt references = 0;
+            std::atomic<uint> generation = 0;
+
+            Array<Job*, 16> continuations = {};
+        };
+
+        struct JobHandle
+        {
+            Job* job = nullptr;
+            uint generation = 0;
+        };
+
+        class JobSystem
+        {
+
+        public:
+
+            void Initialize(uint workerCount = 0)
+            {
+                if (running)
+                    return;
+
+                if (workerCount == 0)
+                    workerCount = std::max(1u, Thread::hardware_concurrency()) - 1;
+
+                workers.clear();
+
+                for (uint w = 0; w < workerCount + 1; ++w)
+                    workers.push_back(std::make_unique<Worker>());
+
+                externalWorker = std::make_unique<Worker>();
+
+                threadIndex = 0;
+                running = true;
+
+                for (uint w = 1; w < workerCount + 1; ++w)
+                    workers[w]->thread = Thread([this, w] { WorkerLoop(w); });
+
+                Logger_WriteConsole("Job system started with " + std::to_string(workerCount) + " worker thread(s).", LogLevel::INFORMATION);
+            }
+
+            JobHandle CreateJob(const Function<void()>& function)
+            {
+                return AllocateJob(function, nullptr);
+            }
+
+            JobHandle CreateChildJob(const JobHandle& parent, const Function<void()>& function)
+            {
+                parent.job->unfinishedJobs.fetch_add(1, std::memory_order_relaxed);
+
+                return AllocateJob(function, parent.job);
+            }
+
+            void AddContinuation(const JobHandle& ancestor, const JobHandle& continuation)
+            {
+                Job* job = ancestor.job;
+
+                job->references.fetch_add(1, std::memory_order_acquire);
+
+                if (job->generation.load(std::memory_order_acquire) == ancestor.generation)
+                {
+                    const int index = job->continuationCount.fetch_add(1, std::memory_order_acq_rel);
+
+                    if ((index & SealedContinuations) == 0)
+                    {
+                        if (index >= static_cast<int>(job->continuations.size()))
+                            Logger_ThrowError("Overflow", "Too many continuations attached to a single job.", true);
+
+                        job->continuations[index] = continuation.job;
+                        job->storedContinuations.fetch_add(1, std::memory_order_release);
+                        job->references.fetch_sub(1, std::memory_order_release);
+
+                        return;
+                    }
+                }
+
+                job->references.fetch_sub(1, std::memory_order_release);
+
+                Schedule(continuation.job);
+            }
+
+            void Run(const JobHandle& job)
+            {
+                Schedule(job.job);
+            }
+
+            void Wait(const JobHandle& job)
+            {
+                while (!IsFinished(job))
+                    Help();
+            }
+
+            void WaitUntil(const Function<bool()>& predicate)
+            {
+                while (!predicate())
+                    Help();
+            }
+
+            bool IsFinished(const JobHandle& job) const
+            {
+                return job.job->unfinishedJobs.load(std::memory_order_acquire) == 0 || job.job->generation.load(std::memory_order_acquire) != job.generation;
+            }
+
+            template<typename F>
+            void ParallelFor(Size count, Size batchSize, F&& function)
+            {
+                if (count == 0)
+                    return;
+
+                batchSize = std::max<Size>(1, batchSize);
+
+                if (!running || count <= batchSize)
+                {
+                    function(Size(0), count);
+                    return;
+                }
+
+                JobHandle root = CreateJob(nullptr);
+
+                for (Size begin = 0; begin < count; begin += batchSize)
+                {
+                    Size end = std::min(begin + batchSize, count);
+
+                    Run(CreateChildJob(root, [&function, begin, end] { function(begin, end); }));
+                }
+
+                Run(root);
+                Wait(root);
+            }
+
+            uint GetWorkerCount() const
+            {
+                return static_cast<uint>(workers.size());
+            }
+
+            uint GetThreadIndex() const
+            {
+                return threadIndex;
+            }
+
+            void Shutdown()
+            {
+                if (!running)
+                    return;
+
+                running = false;
+                wakeCondition.notify_all();
+
+                for (auto& worker : workers)
+                {
+                    if (worker->thread.joinable())
+                        worker->thread.join();
+                }
+
+                workers.clear();
+                externalWorker.reset();
+                injectedJobs.clear();
+                injectedJobCount.store(0, std::memory_order_relaxed);
+            }
+
+            static Shared<JobSystem> GetInstance()
+            {
+                static Shared<JobSystem> instance = std::make_shared<JobSystem>();
+
+                return instance;
+            }
+
+        private:
+
+            static const Size maxJobsPerThread = 4096;
+            static constexpr uint ExternalThread = std::numeric_limits<uint>::max();
+            static constexpr int SealedContinuations = 1 << 30;
+
+            struct Worker
+            {
+                WorkStealingDeque<Job*, maxJobsPerThread> queue;
+
+                Array<Job, maxJobsPerThread> jobs;
+                Size allocatedJobs = 0;
+
+                Thread thread;
+            };
+
+            void Schedule(Job* job)
+            {
+                if (!running)
+                {
+                    Execute(job);
+                    return;
+                }
+
+                if (threadIndex == ExternalThread)
+                {
+                    LockGuard<Mutex> lock(injectionMutex);
+
+                    injectedJobs.push_back(job);
+                    injectedJobCount.fetch_add(1, std::memory_order_release);
+                }
+                else if (!GetWorker().queue.Push(job))
+                {
+                    Execute(job);
+                    return;
+                }
+
+                if (sleepingWorkers.load(std::memory_order_relaxed) > 0)
+                    wakeCondition.notify_one();
+            }
+
+            Worker& GetWorker()
+            {
+                return *workers[threadIndex];
+            }
+
+            JobHandle AllocateJob(const Function<void()>& function, Job* parent)
+            {
+                if (workers.empty())
+                    Initialize();
+
+                Job* job = nullptr;
+
+                while (!job)
+                {
+                    if (threadIndex == ExternalThread)
+                    {
+                        LockGuard<Mutex> lock(externalMutex);
+
+                        job = TryAcquireSlot(*externalWorker);
+                    }
+                    else
+                        job = TryAcquireSlot(GetWorker());
+
+                    if (!job)
+                        Help();
+                }
+
+                job->function = function;
+                job->parent = parent;
+                job->unfinishedJobs.store(1, std::memory_order_relaxed);
+                job->continuationCount.store(0, std::memory_order_relaxed);
+                job->storedContinuations.store(0, std::memory_order_relaxed);
+
+                return { job, job->generation.load(std::memory_order_relaxed) };
+            }
+
+            Job* TryAcquireSlot(Worker& worker)
+            {
+                for (Size attempt = 0; attempt < maxJobsPerThread; ++attempt)
+                {
+                    Job& job = worker.jobs[worker.allocatedJobs++ & (maxJobsPerThread - 1)];
+
+                    int expected = 0;
+
+                    if (job.references.load(std::memory_order_relaxed) == 0 && job.references.compare_exchange_strong(expected, 1, std::memory_order_acquire))
+                        return &job;
+                }
+
+                return nullptr;
+            }
+
+            void Help()
+            {
+                Job* next = GetJob();
+
+                if (next)
+                    Execute(next);
+                else
+                    std::this_thread::yield();
+            }
+
+            Job* GetJob()
+            {
+                Job* job = nullptr;
+
+                const bool external = threadIndex == ExternalThread;
+
+                if (!external && GetWorker().queue.Pop(job))
+                    return job;
+
+                if (injectedJobCount.load(std::memory_order_acquire) > 0)
+                {
+                    LockGuard<Mutex> lock(injectionMutex);
+
+                    if (!injectedJobs.empty())
+                    {
+                        job = injectedJobs.front();
+
+                        injectedJobs.pop_front();
+                        injectedJobCount.fetch_sub(1, std::memory_order_relaxed);
+
+                        return job;
+                    }
+                }
+
+                const uint count = GetWorkerCount();
+                const uint self = external ? 0 : threadIndex;
+
+                for (uint attempt = external ? 0 : 1; attempt < count; ++attempt)
+                {
+                    Worker& victim = *workers[(self + attempt) % count];
+
+                    if (victim.queue.Steal(job))
+                        return job;
+                }
+
+                return nullptr;
+            }
+
+            void Execute(Job* job)
+            {
+                if (job->function)
+                    job->function();
+
+                Finish(job);
+            }
+
+            void Finish(Job* job)
+            {
+                if (job->unfinishedJobs.fetch_sub(1, std::memory_order_acq_rel) != 1)
+                    return;
+
+                const int continuationCount = std::min(job->continuationCount.fetch_or(SealedContinuations, std::memory_order_acq_rel), static_cast<int>(job->continuations.size()));
+
+                while (job->storedContinuations.load(std::memory_order_acquire) < continuationCount)
+                    std::this_thread::yield();
+
+                for (int c = 0; c < continuationCount; ++c)
+                    Schedule(job->continuations[c]);
+
+                Job* parent = job->parent;
+
+                job->generation.fetch_add(1, std::memory_order_release);
+                job->references.fetch_sub(1, std::memory_order_release);
+
+                if (parent)
+                    Finish(parent);
+            }
+
+            void WorkerLoop(uint index)
+            {
+                threadIndex = index;
+
+                uint idleSpins = 0;
+
+                while (running)
+                {
+                    Job* job = GetJob();
+
+                    if (job)
+                    {
+                        Execute(job);
+                        idleSpins = 0;
+
+                        continue;
+                    }
+
+                    if (++idleSpins < 64)
+                    {
+                        std::this_thread::yield();
+                        continue;
+                    }
+
+                    UniqueLock lock(wakeMutex);
+
+                    sleepingWorkers.fetch_add(1, std::memory_order_relaxed);
+                    wakeCondition.wait_for(lock, Milliseconds(1));
+                    sleepingWorkers.fetch_sub(1, std::memory_order_relaxed);
+
+                    idleSpins = 0;
+                }
+            }
+
+            inline static thread_local uint threadIndex = ExternalThread;
+
+            Vector<Unique<Worker>> workers;
+            Unique<Worker> externalWorker;
+
+            Mutex externalMutex;
+            Mutex injectionMutex;
+            Deque<Job*> injectedJobs;
+            AtomicInt injectedJobCount = 0;
+
+            Mutex wakeMutex;
+            ConditionVariable wakeCondition;
+            AtomicInt sleepingWorkers = 0;
+
+            AtomicBool running = false;
+        };
+	}
+}
\ No newline at end of file
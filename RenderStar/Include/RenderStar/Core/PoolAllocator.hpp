@@ -0,0 +1,396 @@
+#pragma once
+
+#include "RenderStar/Core/Logger.hpp"
+#include "RenderStar/Util/Typedefs.hpp"
+
+using namespace RenderStar::Util;
+
+namespace RenderStar
+{
+	namespace Core
+	{
+        struct PoolStatistics
+        {
+            String name;
+
+            Size blockSize = 0;
+            Size allocationCount = 0;
+            Size deallocationCount = 0;
+            Size liveCount = 0;
+            Size peakCount = 0;
+            Size slabCount = 0;
+            Size reservedBytes = 0;
+        };
+
+        class SlabPool;
+
+        class PoolRegistry
+        {
+
+        public:
+
+            void Register(SlabPool* pool)
+            {
+                LockGuard<Mutex> lock(mutex);
+
+                pools.push_back(pool);
+            }
+
+            void Unregister(SlabPool* pool)
+            {
+                LockGuard<Mutex> lock(mutex);
+
+                pools.erase(std::remove(pools.begin(), pools.end(), pool), pools.end());
+            }
+
+            Vector<PoolStatistics> GetStatistics();
+
+            void LogStatistics()
+            {
+                for (const PoolStatistics& statistics : GetStatistics())
+                    Logger_WriteConsole(statistics.name + ": " + std::to_string(statistics.liveCount) + " live, " + std::to_string(statistics.peakCount) + " peak, " + std::to_string(statistics.allocationCount) + " allocations, " + std::to_string(statistics.reservedBytes / 1024) + " KiB reserved", LogLevel::INFORMATION);
+            }
+
+            static Shared<PoolRegistry> GetInstance()
+            {
+                static Shared<PoolRegistry> instance = std::make_shared<PoolRegistry>();
+
+                return instance;
+            }
+
+        private:
+
+            Vector<SlabPool*> pools;
+            Mutex mutex;
+        };
+
+        class SlabPool
+        {
+
+        public:
+
+            struct FreeBlock
+            {
+                FreeBlock* next;
+            };
+
+            static constexpr Size BatchSize = 32;
+
+            SlabPool(Size blockSize, Size blockAlignment, const String& name) : blockSize((std::max(blockSize, sizeof(FreeBlock)) + blockAlignment - 1) / blockAlignment * blockAlignment), blockAlignment(std::max(blockAlignment, alignof(FreeBlock))), blocksPerSlab(std::max<Size>(64, 16384 / this->blockSize)), name(name), registry(PoolRegistry::GetInstance())
+            {
+                registry->Register(this);
+            }
+
+            SlabPool(const SlabPool&) = delete;
+            SlabPool& operator=(const SlabPool&) = delete;
+
+            ~SlabPool()
+            {
+                registry->Unregister(this);
+
+                for (void* slab : slabs)
+                    ::operator delete(slab, std::align_val_t(blockAlignment));
+            }
+
+            FreeBlock* AcquireBatch(Size& count)
+            {
+                LockGuard<Mutex> lock(mutex);
+
+                if (!freeList)
+                    AllocateSlab();
+
+                FreeBlock* head = freeList;
+                FreeBlock* tail = head;
+
+                count = 1;
+
+                while (count < BatchSize && tail->next)
+                {
+                    tail = tail->next;
+                    count++;
+                }
+
+                freeList = tail->next;
+                tail->next = nullptr;
+
+                return head;
+            }
+
+            void* Allocate()
+            {
+                FreeBlock* block = nullptr;
+
+                {
+                    LockGuard<Mutex> lock(mutex);
+
+                    if (!freeList)
+                        AllocateSlab();
+
+                    block = freeList;
+                    freeList = block->next;
+                }
+
+                RecordAllocation();
+
+                return block;
+            }
+
+            void Deallocate(void* pointer)
+            {
+                FreeBlock* block = static_cast<FreeBlock*>(pointer);
+
+                block->next = nullptr;
+
+                ReleaseBatch(block, block);
+                RecordDeallocation();
+            }
+
+            void ReleaseBatch(FreeBlock* head, FreeBlock* tail)
+            {
+                LockGuard<Mutex> lock(mutex);
+
+                tail->next = freeList;
+                freeList = head;
+            }
+
+            void RecordAllocation()
+            {
+                allocationCount.fetch_add(1, std::memory_order_relaxed);
+
+                const Size live = liveCount.fetch_add(1, std::memory_order_relaxed) + 1;
+                Size peak = peakCount.load(std::memory_order_relaxed);
+
+                while (live > peak && !peakCount.compare_exchange_weak(peak, live, std::memory_order_relaxed));
+            }
+
+            void RecordDeallocation()
+            {
+                deallocationCount.fetch_add(1, std::memory_order_relaxed);
+                liveCount.fetch_sub(1, std::memory_order_relaxed);
+            }
+
+            PoolStatistics GetStatistics()
+            {
+                PoolStatistics out;
+
+                out.name = name;
+                out.blockSize = blockSize;
+                out.allocationCount = allocationCount.load(std::memory_order_relaxed);
+                out.deallocationCount = deallocationCount.load(std::memory_order_relaxed);
+                out.liveCount = liveCount.load(std::memory_order_relaxed);
+                out.peakCount = peakCount.load(std::memory_order_relaxed);
+
+                LockGuard<Mutex> lock(mutex);
+
+                out.slabCount = slabs.size();
+                out.reservedBytes = slabs.size() * blocksPerSlab * blockSize;
+
+                return out;
+            }
+
+            static FreeBlock* FindTail(FreeBlock* block)
+            {
+                while (block->next)
+                    block = block->next;
+
+                return block;
+            }
+
+        private:
+
+            void AllocateSlab()
+            {
+                uchar* slab = static_cast<uchar*>(::operator new(blocksPerSlab * blockSize, std::align_val_t(blockAlignment)));
+
+                slabs.push_back(slab);
+
+                for (Size b = blocksPerSlab; b-- > 0;)
+                {
+                    FreeBlock* block = reinterpret_cast<FreeBlock*>(slab + b * blockSize);
+
+                    block->next = freeList;
+                    freeList = block;
+                }
+            }
+
+            const Size blockSize;
+            const Size blockAlignment;
+            const Size blocksPerSlab;
+
+            String name;
+
+            Vector<void*> slabs;
+            FreeBlock* freeList = nullptr;
+            Mutex mutex;
+
+            std::atomic<Size> allocationCount = 0;
+            std::atomic<Size> deallocationCount = 0;
+            std::atomic<Size> liveCount = 0;
+            std::atomic<Size> peakCount = 0;
+
+            Shared<PoolRegistry> registry;
+        };
+
+        inline Vector<PoolStatistics> PoolRegistry::GetStatistics()
+        {
+            LockGuard<Mutex> lock(mutex);
+
+            Vector<PoolStatistics> out;
+
+            for (SlabPool* pool : pools)
+                out.push_back(pool->GetStatistics());
+
+            return out;
+        }
+
+        class PoolThreadCache
+        {
+
+        public:
+
+            PoolThreadCache(SlabPool& pool, bool& isDestroyed) : pool(pool), isDestroyed(isDestroyed) { }
+
+            PoolThreadCache(const PoolThreadCache&) = delete;
+            PoolThreadCache& operator=(const PoolThreadCache&) = delete;
+
+            ~PoolThreadCache()
+            {
+                if (head)
+                    pool.ReleaseBatch(head, SlabPool::FindTail(head));
+
+                isDestroyed = true;
+            }
+
+            void* Allocate()
+            {
+                if (!head)
+                    head = pool.AcquireBatch(count);
+
+                SlabPool::FreeBlock* block = head;
+
+                head = block->next;
+                count--;
+
+                pool.RecordAllocation();
+
+                return block;
+            }
+
+            void Deallocate(void* pointer)
+            {
+                SlabPool::FreeBlock* block = static_cast<SlabPool::FreeBlock*>(pointer);
+
+                block->next = head;
+                head = block;
+                count++;
+
+                pool.RecordDeallocation();
+
+                if (count >= SlabPool::BatchSize * 2)
+                {
+                    SlabPool::FreeBlock* tail = head;
+
+                    for (Size b = 1; b < SlabPool::BatchSize; ++b)
+                        tail = tail->next;
+
+                    SlabPool::FreeBlock* released = head;
+
+                    head = tail->next;
+                    count -= SlabPool::BatchSize;
+
+                    pool.ReleaseBatch(released, tail);
+                }
+            }
+
+        private:
+
+            SlabPool& pool;
+            bool& isDestroyed;
+
+            SlabPool::FreeBlock* head = nullptr;
+            Size count = 0;
+        };
+
+        template<typename T>
+        class PoolAllocator
+        {
+
+        public:
+
+            typedef T value_type;
+
+            PoolAllocator() = default;
+
+            template<typename U>
+            PoolAllocator(const PoolAllocator<U>&) { }
+
+            T* allocate(Size count)
+            {
+                if (count != 1)
+                    return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t(alignof(T))));
+
+                PoolThreadCache* cache = GetThreadCache();
+
+                if (!cache)
+                    return static_cast<T*>(GetPool().Allocate());
+
+                return static_cast<T*>(cache->Allocate());
+            }
+
+            void deallocate(T* pointer, Size count)
+            {
+                if (count != 1)
+                {
+                    ::operator delete(pointer, std::align_val_t(alignof(T)));
+                    return;
+                }
+
+                PoolThreadCache* cache = GetThreadCache();
+
+                if (!cache)
+                    GetPool().Deallocate(pointer);
+                else
+                    cache->Deallocate(pointer);
+            }
+
+            template<typename U>
+            bool operator==(const PoolAllocator<U>&) const
+            {
+                return true;
+            }
+
+            template<typename U>
+            bool operator!=(const PoolAllocator<U>&) const
+            {
+                return false;
+            }
+
+            static SlabPool& GetPool()
+            {
+                static SlabPool* pool = new SlabPool(sizeof(T), alignof(T), TypeIndex(typeid(T)).name());
+
+                return *pool;
+            }
+
+        private:
+
+            static PoolThreadCache* GetThreadCache()
+            {
+                thread_local bool isDestroyed = false;
+
+                if (isDestroyed)
+                    return nullptr;
+
+                thread_local PoolThreadCache cache(GetPool(), isDestroyed);
+
+                return &cache;
+            }
+        };
+
+        template<typename T, typename... A>
+        Shared<T> MakePooled(A&&... arguments)
+        {
+            return std::allocate_shared<T>(PoolAllocator<T>(), std::forward<A>(arguments)...);
+        }
+	}
+}
\ No newline at end of file
@@ -0,0 +1,160 @@
+#pragma once
+
+#include "RenderStar/Util/Typedefs.hpp"
+
+using namespace RenderStar::Util;
+
+namespace RenderStar
+{
+	namespace Core
+	{
+        struct RingStatistics
+        {
+            Size capacity = 0;
+            Size usedSize = 0;
+            Size peakUsedSize = 0;
+            Size allocationCount = 0;
+            Size wrapCount = 0;
+            Size pendingFenceCount = 0;
+        };
+
+        class RingAllocator
+        {
+
+        public:
+
+            RingAllocator() = default;
+
+            explicit RingAllocator(Size capacity) : capacity(capacity) { }
+
+            Optional<Size> Allocate(Size size, Size alignment = 1)
+            {
+                if (size == 0 || size > capacity)
+                    return std::nullopt;
+
+                if (usedSize == 0)
+                {
+                    head = 0;
+                    tail = 0;
+                }
+
+                Size offset = Align(head, alignment);
+
+                if (head >= tail && usedSize < capacity)
+                {
+                    if (offset + size > capacity)
+                    {
+                        if (size > tail)
+                            return std::nullopt;
+
+                        Commit(capacity - head);
+
+                        head = 0;
+                        offset = 0;
+
+                        ++wrapCount;
+                    }
+                }
+                else if (offset + size > tail || usedSize == capacity)
+                    return std::nullopt;
+
+                Commit(offset + size - head);
+
+                head = offset + size;
+
+                ++allocationCount;
+
+                return offset;
+            }
+
+            void Close(ullong fenceValue)
+            {
+                if (openSize == 0)
+                    return;
+
+                submissions.push_back({ fenceValue, head, openSize });
+
+                openSize = 0;
+            }
+
+            void Retire(ullong completedValue)
+            {
+                Size retired = 0;
+
+                for (; retired < submissions.size() && submissions[retired].fenceValue <= completedValue; ++retired)
+                {
+                    usedSize -= submissions[retired].size;
+                    tail = submissions[retired].end;
+                }
+
+                submissions.erase(submissions.begin(), submissions.begin() + retired);
+            }
+
+            Optional<ullong> GetOldestFence() const
+            {
+                if (submissions.empty())
+                    return std::nullopt;
+
+                return submissions.front().fenceValue;
+            }
+
+            bool HasOpenAllocations() const
+            {
+                return openSize > 0;
+            }
+
+            Size GetCapacity() const
+            {
+                return capacity;
+            }
+
+            RingStatistics GetStatistics() const
+            {
+                RingStatistics out;
+
+                out.capacity = capacity;
+                out.usedSize = usedSize;
+                out.peakUsedSize = peakUsedSize;
+                out.allocationCount = allocationCount;
+                out.wrapCount = wrapCount;
+                out.pendingFenceCount = submissions.size();
+
+                return out;
+            }
+
+        private:
+
+            struct Submission
+            {
+                ullong fenceValue;
+
+                Size end;
+                Size size;
+            };
+
+            static Size Align(Size value, Size alignment)
+            {
+                return (value + alignment - 1) / alignment * alignment;
+            }
+
+            void Commit(Size size)
+            {
+                usedSize += size;
+                openSize += size;
+
+                peakUsedSize = std::max(peakUsedSize, usedSize);
+            }
+
+            Vector<Submission> submissions;
+
+            Size capacity = 0;
+            Size head = 0;
+            Size tail = 0;
+            Size usedSize = 0;
+            Size openSize = 0;
+            Size peakUsedSize = 0;
+            Size allocationCount = 0;
+            Size wrapCount = 0;
+        };
+	}
+}
\ No newline at end of file
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "RenderStar/Util/Typedefs.hpp"
+
+using namespace RenderStar::Util;
+
+namespace RenderStar
+{
+	namespace Core
+	{
+        template<typename T, Size C>
+        class WorkStealingDeque
+        {
+
+            static_assert((C & (C - 1)) == 0, "WorkStealingDeque capacity must be a power of two.");
+
+        public:
+
+            bool Push(T item)
+            {
+                slongint currentBottom = bottom.load(std::memory_order_relaxed);
+                slongint currentTop = top.load(std::memory_order_acquire);
+
+                if (currentBottom - currentTop >= static_cast<slongint>(C))
+                    return false;
+
+                buffer[currentBottom & mask].store(item, std::memory_order_relaxed);
+                bottom.store(currentBottom + 1, std::memory_order_release);
+
+                return true;
+            }
+
+            bool Pop(T& item)
+            {
+                slongint currentBottom = bottom.load(std::memory_order_relaxed) - 1;
+
+                bottom.store(currentBottom, std::memory_order_seq_cst);
+
+                slongint currentTop = top.load(std::memory_order_seq_cst);
+
+                if (currentTop > currentBottom)
+                {
+                    bottom.store(currentBottom + 1, std::memory_order_relaxed);
+                    return false;
+                }
+
+                item = buffer[currentBottom & mask].load(std::memory_order_relaxed);
+
+                if (currentTop != currentBottom)
+                    return true;
+
+                bool won = top.compare_exchange_strong(currentTop, currentTop + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+
+                bottom.store(currentBottom + 1, std::memory_order_relaxed);
+
+                return won;
+            }
+
+            bool Steal(T& item)
+            {
+                slongint currentTop = top.load(std::memory_order_seq_cst);
+                slongint currentBottom = bottom.load(std::memory_order_seq_cst);
+
+                if (currentTop >= currentBottom)
+                    return false;
+
+                T stolen = buffer[currentTop & mask].load(std::memory_order_relaxed);
+
+                if (!top.compare_exchange_strong(currentTop, currentTop + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                    return false;
+
+                item = stolen;
+
+                return true;
+            }
+
+            Size GetSize() const
+            {
+                slongint size = bottom.load(std::memory_order_relaxed) - top.load(std::memory_order_relaxed);
+
+                return size > 0 ? static_cast<Size>(size) : 0;
+            }
+
+        private:
+
+            static const Size mask = C - 1;
+
+            alignas(64) std::atomic<slongint> top = 0;
+            alignas(64) std::atomic<slongint> bottom = 0;
+
+            Array<std::atomic<T>, C> buffer;
+        };
+	}
+}
\ No newline at end of file
@@ -0,0 +1,298 @@
+#pragma once
+
+#include "RenderStar/ECS/Component.hpp"
+#include "RenderStar/ECS/Entity.hpp"
+#include "RenderStar/Util/Typedefs.hpp"
+
+using namespace RenderStar::Util;
+
+namespace RenderStar
+{
+	namespace ECS
+	{
+        template<typename T>
+        struct ComponentStorage
+        {
+            static constexpr bool IsShared = []()
+            {
+                if constexpr (std::is_base_of_v<Component, T>)
+                    return !T::IsStoredInline;
+                else
+                    return false;
+            }();
+
+            typedef std::conditional_t<IsShared, Shared<T>, T> Type;
+            typedef std::conditional_t<IsShared, Shared<T>, T*> Handle;
+
+            static T& Dereference(Type& value)
+            {
+                if constexpr (IsShared)
+                    return *value;
+                else
+                    return value;
+            }
+
+            static Handle GetHandle(Type& value)
+            {
+                if constexpr (IsShared)
+                    return value;
+                else
+                    return &value;
+            }
+        };
+
+        class ComponentColumn
+        {
+
+        public:
+
+            virtual ~ComponentColumn() { }
+
+            virtual Unique<ComponentColumn> CreateEmpty() const = 0;
+
+            virtual void MoveFrom(ComponentColumn& source, Size row) = 0;
+            virtual void AssignFrom(ComponentColumn& source, Size sourceRow, Size row) = 0;
+            virtual void SwapRemove(Size row) = 0;
+            virtual void Reserve(Size capacity) = 0;
+
+            virtual Component* GetComponent(Size row) = 0;
+
+            virtual bool IsOwned(Size row) const = 0;
+
+            virtual Size GetSize() const = 0;
+
+            void SetTicks(Size row, ullong addedTick, ullong changedTick)
+            {
+                addedTicks[row] = addedTick;
+                changedTicks[row] = changedTick;
+            }
+
+            void SetChangedTick(Size row, ullong tick)
+            {
+                changedTicks[row] = tick;
+            }
+
+            ullong GetAddedTick(Size row) const
+            {
+                return addedTicks[row];
+            }
+
+            ullong GetChangedTick(Size row) const
+            {
+                return changedTicks[row];
+            }
+
+        protected:
+
+            Vector<ullong> addedTicks;
+            Vector<ullong> changedTicks;
+        };
+
+        template<typename T>
+        class TypedComponentColumn : public ComponentColumn
+        {
+
+        public:
+
+            typedef typename ComponentStorage<T>::Type StorageType;
+
+            Unique<ComponentColumn> CreateEmpty() const override
+            {
+                return std::make_unique<TypedComponentColumn<T>>();
+            }
+
+            void Push(StorageType element, ullong tick)
+            {
+                elements.push_back(std::move(element));
+                addedTicks.push_back(tick);
+                changedTicks.push_back(tick);
+            }
+
+            void MoveFrom(ComponentColumn& source, Size row) override
+            {
+                TypedComponentColumn<T>& typedSource = static_cast<TypedComponentColumn<T>&>(source);
+
+                elements.push_back(std::move(typedSource.elements[row]));
+                addedTicks.push_back(typedSource.addedTicks[row]);
+                changedTicks.push_back(typedSource.changedTicks[row]);
+            }
+
+            void AssignFrom(ComponentColumn& source, Size sourceRow, Size row) override
+            {
+                TypedComponentColumn<T>& typedSource = static_cast<TypedComponentColumn<T>&>(source);
+
+                elements[row] = std::move(typedSource.elements[sourceRow]);
+                addedTicks[row] = typedSource.addedTicks[sourceRow];
+                changedTicks[row] = typedSource.changedTicks[sourceRow];
+            }
+
+            void SwapRemove(Size row) override
+            {
+                if (row != elements.size() - 1)
+                {
+                    elements[row] = std::move(elements.back());
+                    addedTicks[row] = addedTicks.back();
+                    changedTicks[row] = changedTicks.back();
+                }
+
+                elements.pop_back();
+                addedTicks.pop_back();
+                changedTicks.pop_back();
+            }
+
+            void Reserve(Size capacity) override
+            {
+                elements.reserve(capacity);
+                addedTicks.reserve(capacity);
+                changedTicks.reserve(capacity);
+            }
+
+            Component* GetComponent(Size row) override
+            {
+                if constexpr (std::is_base_of_v<Component, T>)
+                    return &ComponentStorage<T>::Dereference(elements[row]);
+                else
+                    return nullptr;
+            }
+
+            bool IsOwned(Size row) const override
+            {
+                if constexpr (ComponentStorage<T>::IsShared)
+                    return elements[row].use_count() == 1;
+                else
+                    return true;
+            }
+
+            Size GetSize() const override
+            {
+                return elements.size();
+            }
+
+            Vector<StorageType> elements;
+        };
+
+        class Archetype
+        {
+
+        public:
+
+            Archetype(Vector<Pair<TypeIndex, Unique<ComponentColumn>>>&& sortedColumns)
+            {
+                for (auto& column : sortedColumns)
+                {
+                    signature.push_back(column.first);
+                    columns.push_back(std::move(column.second));
+                }
+            }
+
+            const Vector<TypeIndex>& GetSignature() const
+            {
+                return signature;
+            }
+
+            bool Contains(const TypeIndex& type) const
+            {
+                return std::binary_search(signature.begin(), signature.end(), type);
+            }
+
+            template<Size S>
+            bool ContainsAll(const Array<TypeIndex, S>& types) const
+            {
+                for (const TypeIndex& type : types)
+                {
+                    if (!Contains(type))
+                        return false;
+                }
+
+                return true;
+            }
+
+            ComponentColumn* GetColumn(const TypeIndex& type)
+            {
+                auto iterator = std::lower_bound(signature.begin(), signature.end(), type);
+
+                if (iterator == signature.end() || *iterator != type)
+                    return nullptr;
+
+                return columns[iterator - signature.begin()].get();
+            }
+
+            template<typename T>
+            TypedComponentColumn<T>* GetColumn()
+            {
+                return static_cast<TypedComponentColumn<T>*>(GetColumn(TypeIndex(typeid(T))));
+            }
+
+            ComponentColumn* GetColumnAt(Size index)
+            {
+                return columns[index].get();
+            }
+
+            Size GetColumnCount() const
+            {
+                return columns.size();
+            }
+
+            Vector<Pair<TypeIndex, Unique<ComponentColumn>>> CreateEmptyColumns() const
+            {
+                Vector<Pair<TypeIndex, Unique<ComponentColumn>>> out;
+
+                for (Size c = 0; c < columns.size(); ++c)
+                    out.emplace_back(signature[c], columns[c]->CreateEmpty());
+
+                return out;
+            }
+
+            Size AddRow(Entity entity)
+            {
+                entities.push_back(entity);
+
+                return entities.size() - 1;
+            }
+
+            Entity RemoveRow(Size row)
+            {
+                for (auto& column : columns)
+                    column->SwapRemove(row);
+
+                Entity movedEntity = entities.back();
+
+                if (row != entities.size() - 1)
+                    entities[row] = movedEntity;
+                else
+                    movedEntity = NullEntity;
+
+                entities.pop_back();
+
+                return movedEntity;
+            }
+
+            void Reserve(Size capacity)
+            {
+                entities.reserve(capacity);
+
+                for (auto& column : columns)
+                    column->Reserve(capacity);
+            }
+
+            const Vector<Entity>& GetEntities() const
+            {
+                return entities;
+            }
+
+            Size GetSize() const
+            {
+                return entities.size();
+            }
+
+            UnorderedMap<TypeIndex, Archetype*> addEdges;
+            UnorderedMap<TypeIndex, Archetype*> removeEdges;
+
+        private:
+
+            Vector<TypeIndex> signature;
+            Vector<Unique<ComponentColumn>> columns;
+            Vector<Entity> entities;
+        };
+	}
+}
\ No newline at end of file
@@ -0,0 +1,299 @@
+#pragma once
+
+#include "RenderStar/ECS/Archetype.hpp"
+#include "RenderStar/ECS/Component.hpp"
+#include "RenderStar/ECS/Entity.hpp"
+#include "RenderStar/ECS/SystemRegistry.hpp"
+#include "RenderStar/ECS/World.hpp"
+#include "RenderStar/Util/Typedefs.hpp"
+
+using namespace RenderStar::Util;
+
+namespace RenderStar
+{
+	namespace ECS
+	{
+        enum class CommandType
+        {
+            CREATE,
+            DESTROY,
+            ADD_COMPONENT,
+            REMOVE_COMPONENT
+        };
+
+        class CommandBuffer
+        {
+
+        public:
+
+            Entity Create(const String& name)
+            {
+                Entity entity = World::GetInstance()->ReserveEntity();
+
+                Command command = { CommandType::CREATE, entity };
+                command.name = name;
+
+                commands.push_back(std::move(command));
+
+                return entity;
+            }
+
+            void Destroy(Entity entity)
+            {
+                commands.push_back({ CommandType::DESTROY, entity });
+            }
+
+            template<typename T>
+            void AddComponent(Entity entity, typename ComponentStorage<T>::Type component)
+            {
+                if constexpr (std::is_base_of_v<Component, T>)
+                    SystemRegistry::GetInstance()->Register<T>();
+
+                Unique<TypedComponentColumn<T>> column = std::make_unique<TypedComponentColumn<T>>();
+                column->Push(std::move(component), 0);
+
+                Command command = { CommandType::ADD_COMPONENT, entity, TypeIndex(typeid(T)) };
+                command.component = std::move(column);
+
+                commands.push_back(std::move(command));
+            }
+
+            template<typename T>
+            void RemoveComponent(Entity entity)
+            {
+                commands.push_back({ CommandType::REMOVE_COMPONENT, entity, TypeIndex(typeid(T)) });
+            }
+
+            void Playback(const Function<void(Entity, const String&)>& onCreate, const Function<void(Entity)>& onDestroy)
+            {
+                Playback({ this }, onCreate, onDestroy);
+            }
+
+            void Clear()
+            {
+                commands.clear();
+            }
+
+            bool IsEmpty() const
+            {
+                return commands.empty();
+            }
+
+            Size GetCommandCount() const
+            {
+                return commands.size();
+            }
+
+            static void Playback(const Vector<CommandBuffer*>& buffers, const Function<void(Entity, const String&)>& onCreate, const Function<void(Entity)>& onDestroy)
+            {
+                Shared<World> world = World::GetInstance();
+
+                UnorderedMap<Entity, Size> changeIndices;
+                Vector<PendingChanges> changes;
+                Vector<Entity> destroyedEntities;
+
+                auto GetChanges = [&](Entity entity) -> PendingChanges&
+                {
+                    auto iterator = changeIndices.find(entity);
+
+                    if (iterator != changeIndices.end())
+                        return changes[iterator->second];
+
+                    changeIndices[entity] = changes.size();
+                    changes.push_back({ entity });
+
+                    return changes.back();
+                };
+
+                for (CommandBuffer* buffer : buffers)
+                {
+                    for (Command& command : buffer->commands)
+                    {
+                        switch (command.type)
+                        {
+
+                        case CommandType::CREATE:
+
+                            if (onCreate)
+                                onCreate(command.entity, command.name);
+                            else
+                                world->CreateEntity(command.entity);
+
+                            break;
+
+                        case CommandType::DESTROY:
+                        {
+                            PendingChanges& pending = GetChanges(command.entity);
+
+                            if (!pending.isDestroyed)
+                            {
+                                pending.isDestroyed = true;
+                                destroyedEntities.push_back(command.entity);
+                            }
+
+                            break;
+                        }
+
+                        case CommandType::ADD_COMPONENT:
+                        {
+                            PendingChanges& pending = GetChanges(command.entity);
+
+                            if (pending.isDestroyed)
+                                break;
+
+                            pending.removedComponents.erase(std::remove(pending.removedComponents.begin(), pending.removedComponents.end(), command.componentType), pending.removedComponents.end());
+                            pending.EraseAdded(command.componentType);
+                            pending.addedComponents.emplace_back(command.componentType, std::move(command.component));
+
+                            break;
+                        }
+
+                        case CommandType::REMOVE_COMPONENT:
+                        {
+                            PendingChanges& pending = GetChanges(command.entity);
+
+                            if (pending.isDestroyed)
+                                break;
+
+                            pending.EraseAdded(command.componentType);
+
+                            if (std::find(pending.removedComponents.begin(), pending.removedComponents.end(), command.componentType) == pending.removedComponents.end())
+                                pending.removedComponents.push_back(command.componentType);
+
+                            break;
+                        }
+                        }
+                    }
+
+                    buffer->Clear();
+                }
+
+                for (PendingChanges& pending : changes)
+                {
+                    if (pending.isDestroyed || !world->IsValid(pending.entity))
+                        continue;
+
+                    if (pending.addedComponents.empty() && pending.removedComponents.empty())
+                        continue;
+
+                    Vector<TypeIndex> addedTypes;
+
+                    for (const auto& component : pending.addedComponents)
+                    {
+                        if (component.second->GetComponent(0))
+                            addedTypes.push_back(component.first);
+                    }
+
+                    for (const TypeIndex& type : pending.removedComponents)
+                    {
+                        Component* owned = world->GetOwnedComponent(pending.entity, type);
+
+                        if (owned)
+                            owned->CleanUp();
+                    }
+
+                    world->ApplyChanges(pending.entity, pending.addedComponents, pending.removedComponents);
+
+                    for (const TypeIndex& type : addedTypes)
+                    {
+                        Component* component = world->GetComponent(pending.entity, type);
+
+                        if (!component)
+                            continue;
+
+                        component->entity = pending.entity;
+                        component->Initialize();
+                    }
+                }
+
+                for (Entity entity : destroyedEntities)
+                {
+                    if (onDestroy)
+                        onDestroy(entity);
+                    else
+                        world->DestroyEntity(entity);
+                }
+            }
+
+            static CommandBuffer& GetThreadLocal()
+            {
+                thread_local CommandBuffer* buffer = nullptr;
+
+                if (!buffer)
+                {
+                    LockGuard<Mutex> lock(GetRegistryMutex());
+
+                    GetRegistry().push_back(std::make_unique<CommandBuffer>());
+                    buffer = GetRegistry().back().get();
+                }
+
+                return *buffer;
+            }
+
+            static Vector<CommandBuffer*> GetThreadLocalBuffers()
+            {
+                LockGuard<Mutex> lock(GetRegistryMutex());
+
+                Vector<CommandBuffer*> out;
+
+                for (const Unique<CommandBuffer>& buffer : GetRegistry())
+                {
+                    if (!buffer->IsEmpty())
+                        out.push_back(buffer.get());
+                }
+
+                return out;
+            }
+
+            static void PlaybackThreadLocal(const Function<void(Entity, const String&)>& onCreate, const Function<void(Entity)>& onDestroy)
+            {
+                Vector<CommandBuffer*> buffers = GetThreadLocalBuffers();
+
+                if (!buffers.empty())
+                    Playback(buffers, onCreate, onDestroy);
+            }
+
+        private:
+
+            struct Command
+            {
+                CommandType type;
+                Entity entity;
+                TypeIndex componentType = TypeIndex(typeid(void));
+
+                Unique<ComponentColumn> component;
+                String name;
+            };
+
+            struct PendingChanges
+            {
+                Entity entity;
+                bool isDestroyed = false;
+
+                Vector<Pair<TypeIndex, Unique<ComponentColumn>>> addedComponents;
+                Vector<TypeIndex> removedComponents;
+
+                void EraseAdded(const TypeIndex& type)
+                {
+                    addedComponents.erase(std::remove_if(addedComponents.begin(), addedComponents.end(), [&type](const auto& component) { return component.first == type; }), addedComponents.end());
+                }
+            };
+
+            static Vector<Unique<CommandBuffer>>& GetRegistry()
+            {
+                static Vector<Unique<CommandBuffer>> registry;
+
+                return registry;
+            }
+
+            static Mutex& GetRegistryMutex()
+            {
+                static Mutex mutex;
+
+                return mutex;
+            }
+
+            Vector<Command> commands;
+        };
+	}
+}
\ No newline at end of file
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "RenderStar/ECS/Entity.hpp"
 #include "RenderStar/Util/Typedefs.hpp"
 
 namespace RenderStar
@@ -17,8 +18,6 @@ namespace RenderStar
 {
 	namespace ECS
 	{
-		class GameObject;
-		
         class Component
         {
 
@@ -33,7 +32,11 @@ namespace RenderStar
 
             virtual void CleanUp() { }
 
-            Shared<GameObject> gameObject;
+            virtual bool IsThreadSafe() const { return true; }
+
+            static constexpr bool IsStoredInline = false;
+
+            Entity entity;
         };
 	}
 }
\ No newline at end of file
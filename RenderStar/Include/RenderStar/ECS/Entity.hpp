@@ -0,0 +1,53 @@
+#pragma once
+
+#include "RenderStar/Util/Typedefs.hpp"
+
+using namespace RenderStar::Util;
+
+namespace RenderStar
+{
+	namespace ECS
+	{
+        struct Entity
+        {
+            uint index = ~0u;
+            uint generation = 0;
+
+            bool IsNull() const
+            {
+                return index == ~0u;
+            }
+
+            ullong GetValue() const
+            {
+                return (static_cast<ullong>(generation) << 32) | index;
+            }
+
+            bool operator==(const Entity& other) const
+            {
+                return index == other.index && generation == other.generation;
+            }
+
+            bool operator!=(const Entity& other) const
+            {
+                return !(*this == other);
+            }
+
+            static Entity Create(uint index, uint generation)
+            {
+                return { index, generation };
+            }
+        };
+
+        static const Entity NullEntity = {};
+	}
+}
+
+template<>
+struct std::hash<RenderStar::ECS::Entity>
+{
+    size_t operator()(const RenderStar::ECS::Entity& entity) const
+    {
+        return std::hash<unsigned long long>()(entity.GetValue());
+    }
+};
\ No newline at end of file
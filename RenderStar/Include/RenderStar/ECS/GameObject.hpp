@@ -1,10 +1,16 @@
 #pragma once
 
+#include "RenderStar/Core/PoolAllocator.hpp"
+#include "RenderStar/ECS/CommandBuffer.hpp"
 #include "RenderStar/ECS/Component.hpp"
+#include "RenderStar/ECS/Entity.hpp"
+#include "RenderStar/ECS/SystemRegistry.hpp"
+#include "RenderStar/ECS/World.hpp"
 #include "RenderStar/Math/Transform.hpp"
 #include "RenderStar/Render/Renderer.hpp"
 #include "RenderStar/Util/Typedefs.hpp"
 
+using namespace RenderStar::Core;
 using namespace RenderStar::Math;
 using namespace RenderStar::Render;
 using namespace RenderStar::Util;
@@ -13,7 +19,9 @@ namespace RenderStar
 {
 	namespace ECS
 	{
-        class GameObject : public EnableShared<GameObject>
+        class GameObjectManager;
+
+        class GameObject
         {
 
         public:
@@ -22,88 +30,126 @@ namespace RenderStar
 
             bool isActive = true;
 
-            Shared<GameObject> parent;
-
-            List<Shared<GameObject>> children;
-            UnorderedMap<TypeIndex, Shared<Component>> components;
-
             template<typename T>
             Shared<T> AddComponent(Shared<T> component)
             {
                 if (!component)
                     return nullptr;
 
-                components[TypeIndex(typeid(T))] = component;
-                component->gameObject = shared_from_this();
+                SystemRegistry::GetInstance()->Register<T>();
+
+                if (World::GetInstance()->IsDeferringStructuralChanges())
+                {
+                    CommandBuffer::GetThreadLocal().AddComponent<T>(entity, component);
+                    return component;
+                }
+
+                if (!World::GetInstance()->IsValid(entity))
+                    return nullptr;
+
+                World::GetInstance()->AddComponent<T>(entity, component);
+                component->entity = entity;
                 component->Initialize();
 
                 return component;
             }
 
-            template<typename T>
-            Shared<T> GetComponent()
+            template<typename T> requires (std::is_base_of_v<Component, T> && !ComponentStorage<T>::IsShared)
+            T* AddComponent(T component)
             {
-                auto iterator = components.find(TypeIndex(typeid(T)));
+                SystemRegistry::GetInstance()->Register<T>();
 
-                if (iterator != components.end())
-                    return std::dynamic_pointer_cast<T>(iterator->second);
+                if (World::GetInstance()->IsDeferringStructuralChanges())
+                {
+                    CommandBuffer::GetThreadLocal().AddComponent<T>(entity, std::move(component));
+                    return nullptr;
+                }
 
-                return nullptr;
+                if (!World::GetInstance()->IsValid(entity))
+                    return nullptr;
+
+                T& added = World::GetInstance()->AddComponent<T>(entity, std::move(component));
+
+                added.entity = entity;
+                added.Initialize();
+
+                return &added;
             }
 
             template<typename T>
-            bool HasComponent()
+            void RemoveComponent()
             {
-                return components.count(TypeIndex(typeid(T))) > 0;
+                if (World::GetInstance()->IsDeferringStructuralChanges())
+                {
+                    CommandBuffer::GetThreadLocal().RemoveComponent<T>(entity);
+                    return;
+                }
+
+                Component* owned = World::GetInstance()->GetOwnedComponent(entity, TypeIndex(typeid(T)));
+
+                if (owned)
+                    owned->CleanUp();
+
+                World::GetInstance()->RemoveComponent<T>(entity);
             }
 
-            Shared<GameObject> AddChild(Shared<GameObject> child)
+            template<typename T>
+            typename ComponentStorage<T>::Handle GetComponent()
             {
-                if (child && child->parent != shared_from_this())
-                {
-                    children.push_back(child);
+                typename ComponentStorage<T>::Type* component = World::GetInstance()->GetComponent<T>(entity);
 
-                    child->parent = shared_from_this();
-                }
+                if (component)
+                    return ComponentStorage<T>::GetHandle(*component);
 
-                return child;
+                return nullptr;
             }
 
-            Shared<GameObject> GetChild(const String& name)
+            template<typename T>
+            bool HasComponent()
             {
-                for (auto& child : children)
-                    if (child->name == name)
-                        return child;
+                return World::GetInstance()->HasComponent<T>(entity);
+            }
 
-                return nullptr;
+            Entity GetEntity() const
+            {
+                return entity;
             }
 
-            void RemoveChild(Shared<GameObject> child)
+            Entity GetParentEntity() const
             {
-                if (child)
-                {
-                    child->parent.reset();
+                return parent;
+            }
 
-                    children.remove_if([&child](const Shared<GameObject>& gameObject)
-                        {
-                            return gameObject == child;
-                        });
-                }
+            const Vector<Entity>& GetChildEntities() const
+            {
+                return children;
             }
 
+            GameObject* GetParent();
+
+            GameObject* AddChild(GameObject* child);
+
+            GameObject* GetChild(const String& name);
+
+            void RemoveChild(GameObject* child);
+
             void Update()
             {
-                if (parent != nullptr)
-                    GetComponent<Transform>()->SetParent(parent->GetComponent<Transform>());
+                Update(nullptr);
+            }
 
+            void Update(Vector<Component*>* threadUnsafeComponents)
+            {
                 if (!isActive)
                     return;
 
-                for (auto& component : components)
-                    component.second->Update();
-
-                for (auto& child : children)
-                    child->Update();
+                World::GetInstance()->ForEachComponent(entity, [threadUnsafeComponents](Component* component)
+                {
+                    if (threadUnsafeComponents && !component->IsThreadSafe())
+                        threadUnsafeComponents->push_back(component);
+                    else
+                        component->Update();
+                });
             }
 
             void Render()
@@ -111,25 +157,41 @@ namespace RenderStar
                 if (!isActive)
                     return;
 
-                for (auto& component : components)
-                    component.second->Render();
+                World::GetInstance()->ForEachComponent(entity, [](Component* component) { component->Render(); });
+            }
+
+            static void* operator new(Size size)
+            {
+                if (size != sizeof(GameObject))
+                    return ::operator new(size);
+
+                return PoolAllocator<GameObject>().allocate(1);
+            }
 
-                for (auto& child : children)
-                    child->Render();
+            static void operator delete(void* pointer, Size size)
+            {
+                if (size != sizeof(GameObject))
+                    ::operator delete(pointer);
+                else
+                    PoolAllocator<GameObject>().deallocate(static_cast<GameObject*>(pointer), 1);
             }
 
             void CleanUp()
             {
-                for (auto& component : components)
-                    component.second->CleanUp();
+                World::GetInstance()->ForEachOwnedComponent(entity, [](Component* component) { component->CleanUp(); });
+                World::GetInstance()->DestroyEntity(entity);
+            }
 
-                components.clear();
+        private:
 
-                for (auto& child : children)
-                    child->CleanUp();
+            friend class GameObjectManager;
 
-                children.clear();
-            }
+            Entity entity;
+            Entity parent;
+
+            bool isActiveInHierarchy = true;
+
+            Vector<Entity> children;
         };
 	}
 }
\ No newline at end of file
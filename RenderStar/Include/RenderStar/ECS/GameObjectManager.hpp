@@ -1,10 +1,19 @@
 #pragma once
 
+#include "RenderStar/Core/JobSystem.hpp"
+#include "RenderStar/Core/Logger.hpp"
+#include "RenderStar/Core/Settings.hpp"
+#include "RenderStar/ECS/CommandBuffer.hpp"
+#include "RenderStar/ECS/Entity.hpp"
 #include "RenderStar/ECS/GameObject.hpp"
+#include "RenderStar/ECS/Prefab.hpp"
+#include "RenderStar/ECS/SystemRegistry.hpp"
 #include "RenderStar/ECS/Component.hpp"
+#include "RenderStar/ECS/World.hpp"
 #include "RenderStar/Math/Transform.hpp"
 #include "RenderStar/Util/Typedefs.hpp"
 
+using namespace RenderStar::Core;
 using namespace RenderStar::Math;
 using namespace RenderStar::Util;
 
@@ -12,59 +21,307 @@ namespace RenderStar
 {
 	namespace ECS
 	{
-        class GameObjectManager 
+        class GameObjectManager
         {
 
         public:
 
-            Shared<GameObject> Create(const String& name)
+            GameObject* Create(const String& name)
             {
-                Shared<GameObject> out = std::make_shared<GameObject>();
+                if (World::GetInstance()->IsDeferringStructuralChanges())
+                {
+                    Logger_ThrowError("DEFERRED", "Cannot create game object '" + name + "' while iterating, use CreateDeferred instead", false);
+                    return nullptr;
+                }
 
-                out->name = name;
-                out->AddComponent(Transform::Create());
-                registeredGameObjects[name] = out;
+                return Create(name, World::GetInstance()->CreateEntity());
+            }
+
+            Vector<GameObject*> Create(const Vector<String>& names, Vector<Pair<TypeIndex, Unique<ComponentColumn>>>& components)
+            {
+                if (World::GetInstance()->IsDeferringStructuralChanges())
+                {
+                    Logger_ThrowError("DEFERRED", "Cannot create " + std::to_string(names.size()) + " game objects while iterating, use CreateDeferred instead", false);
+                    return {};
+                }
+
+                const Vector<Entity> entities = World::GetInstance()->CreateEntities(components, names.size());
+
+                Vector<GameObject*> out;
+                out.reserve(entities.size());
+
+                for (Size n = 0; n < entities.size(); ++n)
+                {
+                    GameObject* gameObject = Track(names[n], entities[n]);
+
+                    World::GetInstance()->ForEachComponent(gameObject->entity, [gameObject](Component* component)
+                    {
+                        component->entity = gameObject->entity;
+                        component->Initialize();
+                    });
+
+                    out.push_back(gameObject);
+                }
 
                 return out;
             }
 
-            Shared<GameObject> Get(const String& name)
+            Entity CreateDeferred(const String& name)
             {
-                auto iterator = registeredGameObjects.find(name);
+                return CommandBuffer::GetThreadLocal().Create(name);
+            }
+
+            CommandBuffer& GetCommandBuffer()
+            {
+                return CommandBuffer::GetThreadLocal();
+            }
+
+            void FlushCommandBuffers()
+            {
+                CommandBuffer::PlaybackThreadLocal([this](Entity entity, const String& name) { Create(name, World::GetInstance()->CreateEntity(entity)); }, [this](Entity entity) { Remove(entity); });
+            }
+
+            Vector<GameObject*> Instantiate(const Shared<Prefab>& prefab, Size count)
+            {
+                if (World::GetInstance()->IsDeferringStructuralChanges())
+                {
+                    Logger_ThrowError("DEFERRED", "Cannot instantiate prefab '" + prefab->GetName() + "' while iterating", false);
+                    return {};
+                }
 
-                if (iterator != registeredGameObjects.end())
-                    return iterator->second;
+                Reserve(gameObjects.size() + count);
+                TransformSystem::GetInstance()->Reserve(TransformSystem::GetInstance()->GetCount() + count);
+
+                Vector<Transform> transforms(count);
+
+                for (Transform& transform : transforms)
+                {
+                    transform.SetLocalPosition(prefab->GetLocalPosition());
+                    transform.SetLocalRotation(prefab->GetLocalRotation());
+                    transform.SetLocalScale(prefab->GetLocalScale());
+                }
+
+                Vector<Pair<TypeIndex, Unique<ComponentColumn>>> components = prefab->CreateComponents(count);
+                components.push_back(CreateComponents(transforms));
+
+                return Create(Vector<String>(count, prefab->GetName()), components);
+            }
+
+            GameObject* Get(Entity entity) const
+            {
+                if (entity.index >= slots.size())
+                    return nullptr;
+
+                GameObject* gameObject = slots[entity.index].get();
+
+                if (!gameObject || gameObject->entity != entity)
+                    return nullptr;
+
+                return gameObject;
+            }
+
+            GameObject* Get(const String& name) const
+            {
+                auto iterator = nameIndex.find(name);
+
+                if (iterator != nameIndex.end())
+                    return Get(iterator->second);
 
                 return nullptr;
             }
 
+            bool IsValid(Entity entity) const
+            {
+                return Get(entity) != nullptr;
+            }
+
             void Update()
             {
-                for (auto& gameObject : registeredGameObjects)
-                    gameObject.second->Update();
+                const ullong frameTick = World::GetInstance()->AdvanceTick();
+
+                World::GetInstance()->PruneChanges(previousFrameTick);
+                previousFrameTick = frameTick;
+
+                const bool batched = Settings::GetInstance()->Get<bool>("batchedComponentDispatch");
+
+                if (batched)
+                    SynchronizeActiveStates();
+
+                World::GetInstance()->SetDeferringStructuralChanges(true);
+
+                if (batched)
+                    SystemRegistry::GetInstance()->UpdateAll(Settings::GetInstance()->Get<bool>("parallelUpdate"), std::max<Size>(1, Settings::GetInstance()->Get<uint>("parallelUpdateBatchSize")));
+                else if (Settings::GetInstance()->Get<bool>("parallelUpdate"))
+                    UpdateParallel();
+                else
+                {
+                    for (GameObject* gameObject : gameObjects)
+                    {
+                        if (gameObject->parent.IsNull())
+                            UpdateHierarchy(gameObject, nullptr);
+                    }
+                }
+
+                World::GetInstance()->SetDeferringStructuralChanges(false);
+
+                FlushCommandBuffers();
+            }
+
+            void UpdateParallel()
+            {
+                Vector<GameObject*> rootGameObjects;
+
+                for (GameObject* gameObject : gameObjects)
+                {
+                    if (gameObject->parent.IsNull())
+                        rootGameObjects.push_back(gameObject);
+                }
+
+                const Size batchSize = std::max<Size>(1, Settings::GetInstance()->Get<uint>("parallelUpdateBatchSize"));
+                Vector<Vector<Component*>> threadUnsafeComponents((rootGameObjects.size() + batchSize - 1) / batchSize);
+
+                JobSystem::GetInstance()->ParallelFor(rootGameObjects.size(), batchSize, [&](Size begin, Size end)
+                {
+                    Vector<Component*>& deferred = threadUnsafeComponents[begin / batchSize];
+
+                    for (Size g = begin; g < end; ++g)
+                        UpdateHierarchy(rootGameObjects[g], &deferred);
+                });
+
+                for (auto& batch : threadUnsafeComponents)
+                {
+                    for (Component* component : batch)
+                        component->Update();
+                }
             }
 
             void Render()
             {
-                for (auto& gameObject : registeredGameObjects)
-                    gameObject.second->Render();
+                const bool batched = Settings::GetInstance()->Get<bool>("batchedComponentDispatch");
+
+                if (batched)
+                    SynchronizeActiveStates();
+
+                World::GetInstance()->SetDeferringStructuralChanges(true);
+
+                if (batched)
+                    SystemRegistry::GetInstance()->RenderAll(Settings::GetInstance()->Get<bool>("parallelRender"), std::max<Size>(1, Settings::GetInstance()->Get<uint>("parallelRenderBatchSize")));
+                else
+                {
+                    for (GameObject* gameObject : gameObjects)
+                    {
+                        if (gameObject->parent.IsNull())
+                            RenderHierarchy(gameObject);
+                    }
+                }
+
+                World::GetInstance()->SetDeferringStructuralChanges(false);
+
+                FlushCommandBuffers();
             }
 
-            void CleanUp()
+            template<typename Filter, typename F>
+            void ForEachChange(ullong sinceTick, F&& function)
             {
-                for (auto& gameObject : registeredGameObjects)
-                    gameObject.second->CleanUp();
+                if constexpr (Filter::Change == ChangeType::REMOVED)
+                    World::GetInstance()->ForEachChange<Filter>(sinceTick, function);
+                else
+                {
+                    World::GetInstance()->ForEachChange<Filter>(sinceTick, [this, &function](Entity entity, typename Filter::Type& component)
+                    {
+                        GameObject* gameObject = Get(entity);
+
+                        if (gameObject)
+                            function(gameObject, component);
+                    });
+                }
             }
 
-            void Remove(const String& name)
+            void CleanUp()
             {
-                auto iterator = registeredGameObjects.find(name);
+                for (GameObject* gameObject : gameObjects)
+                    gameObject->CleanUp();
 
-                if (iterator != registeredGameObjects.end())
+                gameObjects.clear();
+                denseIndices.clear();
+                slots.clear();
+                nameIndex.clear();
+            }
+
+            void Remove(Entity entity)
+            {
+                if (World::GetInstance()->IsDeferringStructuralChanges())
                 {
-                    iterator->second->CleanUp();
-                    registeredGameObjects.erase(iterator);
+                    CommandBuffer::GetThreadLocal().Destroy(entity);
+                    return;
                 }
+
+                GameObject* gameObject = Get(entity);
+
+                if (!gameObject)
+                    return;
+
+                GameObject* parent = Get(gameObject->parent);
+
+                if (parent)
+                    parent->children.erase(std::remove(parent->children.begin(), parent->children.end(), entity), parent->children.end());
+
+                Vector<Entity> children = gameObject->children;
+
+                for (Entity child : children)
+                    Remove(child);
+
+                gameObject->CleanUp();
+
+                auto name = nameIndex.find(gameObject->name);
+
+                if (name != nameIndex.end() && name->second == entity)
+                    nameIndex.erase(name);
+
+                const uint denseIndex = denseIndices[entity.index];
+
+                gameObjects[denseIndex] = gameObjects.back();
+                denseIndices[gameObjects[denseIndex]->entity.index] = denseIndex;
+                gameObjects.pop_back();
+
+                denseIndices[entity.index] = InvalidIndex;
+                slots[entity.index].reset();
+            }
+
+            void Remove(const String& name)
+            {
+                GameObject* gameObject = Get(name);
+
+                if (gameObject)
+                    Remove(gameObject->entity);
+            }
+
+            void Reserve(Size count)
+            {
+                gameObjects.reserve(count);
+                nameIndex.reserve(count);
+            }
+
+            const Vector<GameObject*>& GetGameObjects() const
+            {
+                return gameObjects;
+            }
+
+            Size GetCount() const
+            {
+                return gameObjects.size();
+            }
+
+            template<typename T>
+            static Pair<TypeIndex, Unique<ComponentColumn>> CreateComponents(Vector<Shared<T>>& components)
+            {
+                return CreateColumn<T>(components);
+            }
+
+            template<typename T> requires (std::is_base_of_v<Component, T> && !ComponentStorage<T>::IsShared)
+            static Pair<TypeIndex, Unique<ComponentColumn>> CreateComponents(Vector<T>& components)
+            {
+                return CreateColumn<T>(components);
             }
 
             static Shared<GameObjectManager> GetInstance()
@@ -76,10 +333,196 @@ namespace RenderStar
 
         private:
 
-            UnorderedMap<String, Shared<GameObject>> registeredGameObjects;
+            static constexpr uint InvalidIndex = ~0u;
+
+            template<typename T>
+            static Pair<TypeIndex, Unique<ComponentColumn>> CreateColumn(Vector<typename ComponentStorage<T>::Type>& components)
+            {
+                SystemRegistry::GetInstance()->Register<T>();
+
+                Unique<TypedComponentColumn<T>> column = std::make_unique<TypedComponentColumn<T>>();
+                column->Reserve(components.size());
+
+                for (typename ComponentStorage<T>::Type& component : components)
+                    column->Push(std::move(component), 0);
+
+                return { TypeIndex(typeid(T)), std::move(column) };
+            }
+
+            GameObject* Create(const String& name, Entity entity)
+            {
+                GameObject* out = Track(name, entity);
+
+                if (out)
+                    out->AddComponent(Transform::Create());
+
+                return out;
+            }
+
+            GameObject* Track(const String& name, Entity entity)
+            {
+                if (entity.IsNull())
+                    return nullptr;
+
+                Unique<GameObject> gameObject = std::make_unique<GameObject>();
+                GameObject* out = gameObject.get();
+
+                out->name = name;
+                out->entity = entity;
+
+                const uint index = out->entity.index;
+
+                if (index >= slots.size())
+                {
+                    slots.resize(index + 1);
+                    denseIndices.resize(index + 1, InvalidIndex);
+                }
+
+                slots[index] = std::move(gameObject);
+                denseIndices[index] = static_cast<uint>(gameObjects.size());
+                gameObjects.push_back(out);
+
+                nameIndex[name] = out->entity;
+
+                return out;
+            }
+
+            void SynchronizeActiveStates()
+            {
+                for (GameObject* gameObject : gameObjects)
+                {
+                    if (gameObject->parent.IsNull())
+                        SynchronizeActiveState(gameObject, true);
+                }
+            }
+
+            void SynchronizeActiveState(GameObject* gameObject, bool isParentActive)
+            {
+                const bool isActive = isParentActive && gameObject->isActive;
+
+                if (isActive != gameObject->isActiveInHierarchy)
+                {
+                    if (isActive)
+                        World::GetInstance()->RemoveComponent<Inactive>(gameObject->entity);
+                    else
+                        World::GetInstance()->AddComponent<Inactive>(gameObject->entity, {});
+
+                    gameObject->isActiveInHierarchy = isActive;
+                }
+
+                for (Entity child : gameObject->children)
+                {
+                    GameObject* childObject = Get(child);
 
-            static GameObjectManager instance;
+                    if (childObject)
+                        SynchronizeActiveState(childObject, isActive);
+                }
+            }
+
+            void UpdateHierarchy(GameObject* gameObject, Vector<Component*>* threadUnsafeComponents)
+            {
+                if (!gameObject->isActive)
+                    return;
+
+                gameObject->Update(threadUnsafeComponents);
+
+                for (Entity child : gameObject->children)
+                {
+                    GameObject* childObject = Get(child);
+
+                    if (childObject)
+                        UpdateHierarchy(childObject, threadUnsafeComponents);
+                }
+            }
 
+            void RenderHierarchy(GameObject* gameObject)
+            {
+                if (!gameObject->isActive)
+                    return;
+
+                gameObject->Render();
+
+                for (Entity child : gameObject->children)
+                {
+                    GameObject* childObject = Get(child);
+
+                    if (childObject)
+                        RenderHierarchy(childObject);
+                }
+            }
+
+            Vector<Unique<GameObject>> slots;
+            Vector<uint> denseIndices;
+            Vector<GameObject*> gameObjects;
+
+            UnorderedMap<String, Entity> nameIndex;
+
+            ullong previousFrameTick = 1;
         };
+
+        inline GameObject* GameObject::GetParent()
+        {
+            return GameObjectManager::GetInstance()->Get(parent);
+        }
+
+        inline GameObject* GameObject::AddChild(GameObject* child)
+        {
+            if (!child || child == this || child->parent == entity)
+                return child;
+
+            for (GameObject* ancestor = this; ancestor; ancestor = ancestor->GetParent())
+            {
+                if (ancestor == child)
+                    return nullptr;
+            }
+
+            GameObject* previousParent = child->GetParent();
+
+            if (previousParent)
+                previousParent->RemoveChild(child);
+
+            children.push_back(child->entity);
+            child->parent = entity;
+
+            Transform* childTransform = child->GetComponent<Transform>();
+
+            if (childTransform)
+                childTransform->SetParent(GetComponent<Transform>());
+
+            return child;
+        }
+
+        inline GameObject* GameObject::GetChild(const String& name)
+        {
+            GameObject* child = GameObjectManager::GetInstance()->Get(name);
+
+            if (child && child->parent == entity)
+                return child;
+
+            for (Entity childEntity : children)
+            {
+                child = GameObjectManager::GetInstance()->Get(childEntity);
+
+                if (child && child->name == name)
+                    return child;
+            }
+
+            return nullptr;
+        }
+
+        inline void GameObject::RemoveChild(GameObject* child)
+        {
+            if (!child || child->parent != entity)
+                return;
+
+            child->parent = NullEntity;
+
+            children.erase(std::remove(children.begin(), children.end(), child->entity), children.end());
+
+            Transform* childTransform = child->GetComponent<Transform>();
+
+            if (childTransform)
+                childTransform->SetParent(nullptr);
+        }
 	}
 }
\ No newline at end of file
@@ -0,0 +1,132 @@
+#pragma once
+
+#include "RenderStar/Core/PoolAllocator.hpp"
+#include "RenderStar/ECS/Archetype.hpp"
+#include "RenderStar/ECS/Component.hpp"
+#include "RenderStar/ECS/SystemRegistry.hpp"
+#include "RenderStar/Util/Typedefs.hpp"
+
+using namespace RenderStar::Core;
+using namespace RenderStar::Util;
+
+namespace RenderStar
+{
+	namespace ECS
+	{
+        class Prefab : public EnableShared<Prefab>
+        {
+
+        public:
+
+            template<typename T>
+            Shared<Prefab> AddComponent(Shared<T> component)
+            {
+                SystemRegistry::GetInstance()->Register<T>();
+
+                components.push_back({ TypeIndex(typeid(T)), [component](Size count) -> Unique<ComponentColumn>
+                {
+                    Unique<TypedComponentColumn<T>> column = std::make_unique<TypedComponentColumn<T>>();
+                    column->Reserve(count);
+
+                    for (Size i = 0; i < count; ++i)
+                        column->Push(MakePooled<T>(*component), 0);
+
+                    return column;
+                }});
+
+                return shared_from_this();
+            }
+
+            template<typename T>
+            Shared<Prefab> AddSharedComponent(Shared<T> component)
+            {
+                SystemRegistry::GetInstance()->Register<T>();
+
+                components.push_back({ TypeIndex(typeid(T)), [component](Size count) -> Unique<ComponentColumn>
+                {
+                    Unique<TypedComponentColumn<T>> column = std::make_unique<TypedComponentColumn<T>>();
+                    column->Reserve(count);
+
+                    for (Size i = 0; i < count; ++i)
+                        column->Push(component, 0);
+
+                    return column;
+                }});
+
+                return shared_from_this();
+            }
+
+            void SetLocalPosition(const Vector3f& position)
+            {
+                localPosition = position;
+            }
+
+            void SetLocalRotation(const Vector3f& rotation)
+            {
+                localRotation = rotation;
+            }
+
+            void SetLocalScale(const Vector3f& scale)
+            {
+                localScale = scale;
+            }
+
+            const Vector3f& GetLocalPosition() const
+            {
+                return localPosition;
+            }
+
+            const Vector3f& GetLocalRotation() const
+            {
+                return localRotation;
+            }
+
+            const Vector3f& GetLocalScale() const
+            {
+                return localScale;
+            }
+
+            String GetName() const
+            {
+                return name;
+            }
+
+            Vector<Pair<TypeIndex, Unique<ComponentColumn>>> CreateComponents(Size count = 1) const
+            {
+                Vector<Pair<TypeIndex, Unique<ComponentColumn>>> out;
+
+                out.reserve(components.size() + 1);
+
+                for (const PrefabComponent& component : components)
+                    out.emplace_back(component.type, component.instantiate(count));
+
+                return out;
+            }
+
+            static Shared<Prefab> Create(const String& name)
+            {
+                Shared<Prefab> out = std::make_shared<Prefab>();
+
+                out->name = name;
+
+                return out;
+            }
+
+        private:
+
+            struct PrefabComponent
+            {
+                TypeIndex type;
+                Function<Unique<ComponentColumn>(Size)> instantiate;
+            };
+
+            String name;
+
+            Vector3f localPosition = { 0.0f, 0.0f, 0.0f };
+            Vector3f localRotation = { 0.0f, 0.0f, 0.0f };
+            Vector3f localScale = { 1.0f, 1.0f, 1.0f };
+
+            Vector<PrefabComponent> components;
+        };
+	}
+}
\ No newline at end of file
@@ -0,0 +1,186 @@
+#pragma once
+
+#include "RenderStar/Core/JobSystem.hpp"
+#include "RenderStar/ECS/Archetype.hpp"
+#include "RenderStar/ECS/Component.hpp"
+#include "RenderStar/ECS/World.hpp"
+#include "RenderStar/Util/Typedefs.hpp"
+
+using namespace RenderStar::Core;
+using namespace RenderStar::Util;
+
+namespace RenderStar
+{
+	namespace ECS
+	{
+        struct Inactive { };
+
+        typedef Function<void(Size, Size, const Function<void(Size, Size)>&)> ParallelRecorder;
+
+        class SystemRegistry
+        {
+
+        public:
+
+            template<typename T>
+            void Register()
+            {
+                static std::once_flag once;
+
+                std::call_once(once, [this]()
+                {
+                    System system = { TypeIndex(typeid(T)) };
+
+                    if constexpr (requires(Span<typename ComponentStorage<T>::Type> components) { T::UpdateAll(components); } || !std::is_same_v<decltype(&T::Update), decltype(&Component::Update)>)
+                        system.update = &UpdateRange<T>;
+
+                    if constexpr (requires(Span<typename ComponentStorage<T>::Type> components) { T::RenderAll(components); } || !std::is_same_v<decltype(&T::Render), decltype(&Component::Render)>)
+                        system.render = &RenderRange<T>;
+
+                    LockGuard<Mutex> lock(registrationMutex);
+
+                    pendingSystems.push_back(std::move(system));
+                });
+            }
+
+            void UpdateAll(bool parallel, Size batchSize)
+            {
+                Synchronize();
+
+                for (System& system : systems)
+                {
+                    if (!system.update)
+                        continue;
+
+                    for (ComponentColumn* column : system.columns)
+                    {
+                        const Size size = column->GetSize();
+
+                        if (size == 0)
+                            continue;
+
+                        if (parallel && size > batchSize && column->GetComponent(0)->IsThreadSafe())
+                            JobSystem::GetInstance()->ParallelFor(size, batchSize, [&system, column](Size begin, Size end) { system.update(column, begin, end); });
+                        else
+                            system.update(column, 0, size);
+                    }
+                }
+            }
+
+            void RenderAll(bool parallel, Size batchSize)
+            {
+                Synchronize();
+
+                for (System& system : systems)
+                {
+                    if (!system.render)
+                        continue;
+
+                    for (ComponentColumn* column : system.columns)
+                    {
+                        const Size size = column->GetSize();
+
+                        if (size == 0)
+                            continue;
+
+                        if (parallel && parallelRecorder && size > batchSize && column->GetComponent(0)->IsThreadSafe())
+                            parallelRecorder(size, batchSize, [&system, column](Size begin, Size end) { system.render(column, begin, end); });
+                        else
+                            system.render(column, 0, size);
+                    }
+                }
+            }
+
+            void SetParallelRecorder(const ParallelRecorder& recorder)
+            {
+                parallelRecorder = recorder;
+            }
+
+            Size GetSystemCount() const
+            {
+                return systems.size();
+            }
+
+            static Shared<SystemRegistry> GetInstance()
+            {
+                static Shared<SystemRegistry> instance = std::make_shared<SystemRegistry>();
+
+                return instance;
+            }
+
+        private:
+
+            struct System
+            {
+                TypeIndex type;
+
+                void (*update)(ComponentColumn*, Size, Size) = nullptr;
+                void (*render)(ComponentColumn*, Size, Size) = nullptr;
+
+                Vector<ComponentColumn*> columns;
+                Size archetypeCount = 0;
+            };
+
+            template<typename T>
+            static void UpdateRange(ComponentColumn* column, Size begin, Size end)
+            {
+                Span<typename ComponentStorage<T>::Type> components(static_cast<TypedComponentColumn<T>*>(column)->elements.data() + begin, end - begin);
+
+                if constexpr (requires { T::UpdateAll(components); })
+                    T::UpdateAll(components);
+                else
+                {
+                    for (typename ComponentStorage<T>::Type& component : components)
+                        ComponentStorage<T>::Dereference(component).Update();
+                }
+            }
+
+            template<typename T>
+            static void RenderRange(ComponentColumn* column, Size begin, Size end)
+            {
+                Span<typename ComponentStorage<T>::Type> components(static_cast<TypedComponentColumn<T>*>(column)->elements.data() + begin, end - begin);
+
+                if constexpr (requires { T::RenderAll(components); })
+                    T::RenderAll(components);
+                else
+                {
+                    for (typename ComponentStorage<T>::Type& component : components)
+                        ComponentStorage<T>::Dereference(component).Render();
+                }
+            }
+
+            void Synchronize()
+            {
+                {
+                    LockGuard<Mutex> lock(registrationMutex);
+
+                    for (System& system : pendingSystems)
+                        systems.push_back(std::move(system));
+
+                    pendingSystems.clear();
+                }
+
+                const Vector<Archetype*>& archetypes = World::GetInstance()->GetArchetypes();
+                const TypeIndex inactiveType = TypeIndex(typeid(Inactive));
+
+                for (System& system : systems)
+                {
+                    for (; system.archetypeCount < archetypes.size(); ++system.archetypeCount)
+                    {
+                        Archetype* archetype = archetypes[system.archetypeCount];
+
+                        if (archetype->Contains(system.type) && !archetype->Contains(inactiveType))
+                            system.columns.push_back(archetype->GetColumn(system.type));
+                    }
+                }
+            }
+
+            Vector<System> systems;
+            Vector<System> pendingSystems;
+
+            ParallelRecorder parallelRecorder;
+
+            Mutex registrationMutex;
+        };
+	}
+}
\ No newline at end of file
@@ -0,0 +1,721 @@
+#pragma once
+
+#include "RenderStar/ECS/Archetype.hpp"
+#include "RenderStar/ECS/Component.hpp"
+#include "RenderStar/Util/Typedefs.hpp"
+
+using namespace RenderStar::Util;
+
+namespace RenderStar
+{
+	namespace ECS
+	{
+        enum class ChangeType
+        {
+            ADDED,
+            CHANGED,
+            REMOVED
+        };
+
+        template<typename T>
+        struct Added
+        {
+            typedef T Type;
+
+            static constexpr ChangeType Change = ChangeType::ADDED;
+        };
+
+        template<typename T>
+        struct Changed
+        {
+            typedef T Type;
+
+            static constexpr ChangeType Change = ChangeType::CHANGED;
+        };
+
+        template<typename T>
+        struct Removed
+        {
+            typedef T Type;
+
+            static constexpr ChangeType Change = ChangeType::REMOVED;
+        };
+
+        class World
+        {
+
+        public:
+
+            World()
+            {
+                emptyArchetype = GetOrCreateArchetype({});
+            }
+
+            Entity CreateEntity()
+            {
+                return CreateEntity(ReserveEntity());
+            }
+
+            Entity CreateEntity(Entity reservedEntity)
+            {
+                if (reservedEntity.index >= records.size())
+                    records.resize(reservedEntity.index + 1);
+
+                EntityRecord& record = records[reservedEntity.index];
+
+                if (record.archetype || record.generation != reservedEntity.generation)
+                    return NullEntity;
+
+                record.archetype = emptyArchetype;
+                record.row = emptyArchetype->AddRow(reservedEntity);
+
+                entityCount++;
+
+                return reservedEntity;
+            }
+
+            Vector<Entity> CreateEntities(Vector<Pair<TypeIndex, Unique<ComponentColumn>>>& components, Size count)
+            {
+                std::sort(components.begin(), components.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+
+                Vector<TypeIndex> signature;
+
+                for (const auto& component : components)
+                    signature.push_back(component.first);
+
+                Archetype* target = nullptr;
+                auto existing = archetypes.find(signature);
+
+                if (existing != archetypes.end())
+                    target = existing->second.get();
+                else
+                {
+                    Vector<Pair<TypeIndex, Unique<ComponentColumn>>> columns;
+
+                    for (const auto& component : components)
+                        columns.emplace_back(component.first, component.second->CreateEmpty());
+
+                    target = GetOrCreateArchetype(std::move(columns));
+                }
+
+                target->Reserve(target->GetSize() + count);
+
+                Vector<ComponentColumn*> targetColumns;
+
+                for (const auto& component : components)
+                    targetColumns.push_back(target->GetColumn(component.first));
+
+                Vector<Entity> out(count);
+
+                for (Size row = 0; row < count; ++row)
+                {
+                    const Entity entity = ReserveEntity();
+
+                    if (entity.index >= records.size())
+                        records.resize(entity.index + 1);
+
+                    for (Size c = 0; c < components.size(); ++c)
+                        targetColumns[c]->MoveFrom(*components[c].second, row);
+
+                    EntityRecord& record = records[entity.index];
+
+                    record.archetype = target;
+                    record.row = target->AddRow(entity);
+
+                    for (Size c = 0; c < components.size(); ++c)
+                        MarkAdded(targetColumns[c], record.row, components[c].first, entity);
+
+                    out[row] = entity;
+                }
+
+                entityCount += count;
+
+                return out;
+            }
+
+            Entity ReserveEntity()
+            {
+                {
+                    LockGuard<Mutex> lock(reservationMutex);
+
+                    if (!freeIndices.empty())
+                    {
+                        uint index = freeIndices.back();
+                        freeIndices.pop_back();
+
+                        return Entity::Create(index, records[index].generation);
+                    }
+                }
+
+                return Entity::Create(nextIndex.fetch_add(1, std::memory_order_relaxed), 0);
+            }
+
+            void DestroyEntity(Entity entity)
+            {
+                if (!IsValid(entity))
+                    return;
+
+                EntityRecord& record = records[entity.index];
+
+                for (const TypeIndex& type : record.archetype->GetSignature())
+                    LogChange(type, ChangeType::REMOVED, entity);
+
+                RemoveRow(record.archetype, record.row);
+
+                record.archetype = nullptr;
+                record.row = 0;
+                record.generation++;
+
+                entityCount--;
+
+                LockGuard<Mutex> lock(reservationMutex);
+
+                freeIndices.push_back(entity.index);
+            }
+
+            bool IsValid(Entity entity) const
+            {
+                return entity.index < records.size() && records[entity.index].generation == entity.generation && records[entity.index].archetype != nullptr;
+            }
+
+            template<typename T>
+            typename ComponentStorage<T>::Type& AddComponent(Entity entity, typename ComponentStorage<T>::Type component)
+            {
+                EntityRecord& record = records[entity.index];
+                const TypeIndex type = TypeIndex(typeid(T));
+
+                if (record.archetype->Contains(type))
+                {
+                    TypedComponentColumn<T>* column = record.archetype->GetColumn<T>();
+
+                    column->elements[record.row] = std::move(component);
+
+                    MarkAdded(column, record.row, type, entity);
+
+                    return column->elements[record.row];
+                }
+
+                Archetype* target = GetAddTarget<T>(record.archetype);
+
+                MoveEntity(entity, target);
+
+                TypedComponentColumn<T>* column = target->GetColumn<T>();
+                column->Push(std::move(component), 0);
+
+                MarkAdded(column, record.row, type, entity);
+
+                return column->elements.back();
+            }
+
+            void ApplyChanges(Entity entity, Vector<Pair<TypeIndex, Unique<ComponentColumn>>>& addedComponents, const Vector<TypeIndex>& removedComponents)
+            {
+                if (!IsValid(entity))
+                    return;
+
+                EntityRecord& record = records[entity.index];
+                Archetype* source = record.archetype;
+
+                Vector<TypeIndex> signature;
+
+                for (const TypeIndex& type : source->GetSignature())
+                {
+                    if (std::find(removedComponents.begin(), removedComponents.end(), type) == removedComponents.end())
+                        signature.push_back(type);
+                    else
+                        LogChange(type, ChangeType::REMOVED, entity);
+                }
+
+                for (const auto& component : addedComponents)
+                {
+                    if (!std::binary_search(signature.begin(), signature.end(), component.first))
+                        signature.insert(std::lower_bound(signature.begin(), signature.end(), component.first), component.first);
+                }
+
+                Archetype* target = source;
+
+                if (signature != source->GetSignature())
+                {
+                    auto existing = archetypes.find(signature);
+
+                    if (existing != archetypes.end())
+                        target = existing->second.get();
+                    else
+                    {
+                        Vector<Pair<TypeIndex, Unique<ComponentColumn>>> columns;
+
+                        for (const TypeIndex& type : signature)
+                        {
+                            ComponentColumn* column = source->GetColumn(type);
+
+                            if (!column)
+                            {
+                                for (const auto& component : addedComponents)
+                                {
+                                    if (component.first == type)
+                                        column = component.second.get();
+                                }
+                            }
+
+                            columns.emplace_back(type, column->CreateEmpty());
+                        }
+
+                        target = GetOrCreateArchetype(std::move(columns));
+                    }
+                }
+
+                if (target == source)
+                {
+                    for (auto& component : addedComponents)
+                    {
+                        ComponentColumn* column = source->GetColumn(component.first);
+
+                        column->AssignFrom(*component.second, 0, record.row);
+
+                        MarkAdded(column, record.row, component.first, entity);
+                    }
+
+                    return;
+                }
+
+                for (Size c = 0; c < target->GetColumnCount(); ++c)
+                {
+                    const TypeIndex& type = target->GetSignature()[c];
+                    ComponentColumn* added = nullptr;
+
+                    for (const auto& component : addedComponents)
+                    {
+                        if (component.first == type)
+                            added = component.second.get();
+                    }
+
+                    if (added)
+                        target->GetColumnAt(c)->MoveFrom(*added, 0);
+                    else
+                        target->GetColumnAt(c)->MoveFrom(*source->GetColumn(type), record.row);
+                }
+
+                Size targetRow = target->AddRow(entity);
+
+                RemoveRow(source, record.row);
+
+                record.archetype = target;
+                record.row = targetRow;
+
+                for (const auto& component : addedComponents)
+                    MarkAdded(target->GetColumn(component.first), targetRow, component.first, entity);
+            }
+
+            void Reserve(Entity entity, Size count)
+            {
+                if (!IsValid(entity))
+                    return;
+
+                Archetype* archetype = records[entity.index].archetype;
+
+                archetype->Reserve(archetype->GetSize() + count);
+            }
+
+            template<typename T>
+            void MarkChanged(Entity entity)
+            {
+                MarkChanged(entity, TypeIndex(typeid(T)));
+            }
+
+            void MarkChanged(Entity entity, const TypeIndex& type)
+            {
+                if (!IsValid(entity))
+                    return;
+
+                EntityRecord& record = records[entity.index];
+                ComponentColumn* column = record.archetype->GetColumn(type);
+
+                if (!column || column->GetChangedTick(record.row) == tick)
+                    return;
+
+                column->SetChangedTick(record.row, tick);
+
+                LogChange(type, ChangeType::CHANGED, entity);
+            }
+
+            template<typename Filter, typename F>
+            void ForEachChange(ullong sinceTick, F&& function)
+            {
+                typedef typename Filter::Type T;
+
+                auto log = changeLogs.find(TypeIndex(typeid(T)));
+
+                if (log == changeLogs.end())
+                    return;
+
+                const Vector<Pair<Entity, ullong>>& entries = log->second->entries[static_cast<Size>(Filter::Change)];
+                const Size end = entries.size();
+
+                for (Size e = FindFirstChange(entries, sinceTick); e < end; ++e)
+                {
+                    const Entity entity = entries[e].first;
+
+                    if constexpr (Filter::Change == ChangeType::REMOVED)
+                        function(entity);
+                    else
+                    {
+                        if (!IsValid(entity))
+                            continue;
+
+                        EntityRecord& record = records[entity.index];
+                        TypedComponentColumn<T>* column = record.archetype->GetColumn<T>();
+
+                        if (!column)
+                            continue;
+
+                        const ullong componentTick = Filter::Change == ChangeType::ADDED ? column->GetAddedTick(record.row) : column->GetChangedTick(record.row);
+
+                        if (componentTick == entries[e].second)
+                            function(entity, ComponentStorage<T>::Dereference(column->elements[record.row]));
+                    }
+                }
+            }
+
+            template<typename Filter>
+            Size GetChangeCount(ullong sinceTick) const
+            {
+                auto log = changeLogs.find(TypeIndex(typeid(typename Filter::Type)));
+
+                if (log == changeLogs.end())
+                    return 0;
+
+                const Vector<Pair<Entity, ullong>>& entries = log->second->entries[static_cast<Size>(Filter::Change)];
+
+                return entries.size() - FindFirstChange(entries, sinceTick);
+            }
+
+            void PruneChanges(ullong olderThanTick)
+            {
+                for (auto& log : changeLogs)
+                {
+                    for (auto& entries : log.second->entries)
+                        entries.erase(entries.begin(), entries.begin() + FindFirstChange(entries, olderThanTick - 1));
+                }
+            }
+
+            ullong AdvanceTick()
+            {
+                return tick++;
+            }
+
+            ullong GetTick() const
+            {
+                return tick;
+            }
+
+            void SetDeferringStructuralChanges(bool deferring)
+            {
+                isDeferringStructuralChanges = deferring;
+            }
+
+            bool IsDeferringStructuralChanges() const
+            {
+                return isDeferringStructuralChanges;
+            }
+
+            template<typename T>
+            void RemoveComponent(Entity entity)
+            {
+                if (!HasComponent<T>(entity))
+                    return;
+
+                LogChange(TypeIndex(typeid(T)), ChangeType::REMOVED, entity);
+
+                MoveEntity(entity, GetRemoveTarget(records[entity.index].archetype, TypeIndex(typeid(T))));
+            }
+
+            template<typename T>
+            typename ComponentStorage<T>::Type* GetComponent(Entity entity)
+            {
+                if (!IsValid(entity))
+                    return nullptr;
+
+                EntityRecord& record = records[entity.index];
+                TypedComponentColumn<T>* column = record.archetype->GetColumn<T>();
+
+                if (!column)
+                    return nullptr;
+
+                return &column->elements[record.row];
+            }
+
+            Component* GetComponent(Entity entity, const TypeIndex& type)
+            {
+                if (!IsValid(entity))
+                    return nullptr;
+
+                EntityRecord& record = records[entity.index];
+                ComponentColumn* column = record.archetype->GetColumn(type);
+
+                if (!column)
+                    return nullptr;
+
+                return column->GetComponent(record.row);
+            }
+
+            Component* GetOwnedComponent(Entity entity, const TypeIndex& type)
+            {
+                if (!IsValid(entity))
+                    return nullptr;
+
+                EntityRecord& record = records[entity.index];
+                ComponentColumn* column = record.archetype->GetColumn(type);
+
+                if (!column || !column->IsOwned(record.row))
+                    return nullptr;
+
+                return column->GetComponent(record.row);
+            }
+
+            template<typename T>
+            bool HasComponent(Entity entity) const
+            {
+                return IsValid(entity) && records[entity.index].archetype->Contains(TypeIndex(typeid(T)));
+            }
+
+            template<typename F>
+            void ForEachComponent(Entity entity, F&& function)
+            {
+                if (!IsValid(entity))
+                    return;
+
+                EntityRecord& record = records[entity.index];
+
+                for (Size c = 0; c < record.archetype->GetColumnCount(); ++c)
+                {
+                    Component* component = record.archetype->GetColumnAt(c)->GetComponent(record.row);
+
+                    if (component)
+                        function(component);
+                }
+            }
+
+            template<typename F>
+            void ForEachOwnedComponent(Entity entity, F&& function)
+            {
+                if (!IsValid(entity))
+                    return;
+
+                EntityRecord& record = records[entity.index];
+
+                for (Size c = 0; c < record.archetype->GetColumnCount(); ++c)
+                {
+                    ComponentColumn* column = record.archetype->GetColumnAt(c);
+                    Component* component = column->GetComponent(record.row);
+
+                    if (component && column->IsOwned(record.row))
+                        function(component);
+                }
+            }
+
+            template<typename... T, typename F>
+            void ForEach(F&& function)
+            {
+                const Array<TypeIndex, sizeof...(T)> types = { TypeIndex(typeid(T))... };
+
+                for (Archetype* archetype : archetypeList)
+                {
+                    const Size size = archetype->GetSize();
+
+                    if (size == 0 || !archetype->ContainsAll(types))
+                        continue;
+
+                    const Entity* entities = archetype->GetEntities().data();
+
+                    std::apply([&](auto*... columns)
+                    {
+                        for (Size r = 0; r < size; ++r)
+                        {
+                            if constexpr (std::is_invocable_v<F, Entity, T&...>)
+                                function(entities[r], ComponentStorage<T>::Dereference(columns[r])...);
+                            else
+                                function(ComponentStorage<T>::Dereference(columns[r])...);
+                        }
+
+                    }, std::make_tuple(archetype->GetColumn<T>()->elements.data()...));
+                }
+            }
+
+            Size GetEntityCount() const
+            {
+                return entityCount;
+            }
+
+            const Vector<Archetype*>& GetArchetypes() const
+            {
+                return archetypeList;
+            }
+
+            Size GetArchetypeCount() const
+            {
+                return archetypeList.size();
+            }
+
+            static Shared<World> GetInstance()
+            {
+                static Shared<World> instance = std::make_shared<World>();
+
+                return instance;
+            }
+
+        private:
+
+            struct EntityRecord
+            {
+                Archetype* archetype = nullptr;
+                Size row = 0;
+                uint generation = 0;
+            };
+
+            struct ChangeLog
+            {
+                Array<Vector<Pair<Entity, ullong>>, 3> entries;
+                Mutex mutex;
+            };
+
+            static Size FindFirstChange(const Vector<Pair<Entity, ullong>>& entries, ullong sinceTick)
+            {
+                return std::partition_point(entries.begin(), entries.end(), [sinceTick](const Pair<Entity, ullong>& entry) { return entry.second <= sinceTick; }) - entries.begin();
+            }
+
+            void LogChange(const TypeIndex& type, ChangeType change, Entity entity)
+            {
+                ChangeLog& log = *changeLogs.find(type)->second;
+
+                LockGuard<Mutex> lock(log.mutex);
+
+                log.entries[static_cast<Size>(change)].emplace_back(entity, tick);
+            }
+
+            void MarkAdded(ComponentColumn* column, Size row, const TypeIndex& type, Entity entity)
+            {
+                const bool wasAdded = column->GetAddedTick(row) == tick;
+                const bool wasChanged = column->GetChangedTick(row) == tick;
+
+                column->SetTicks(row, tick, tick);
+
+                if (!wasAdded)
+                    LogChange(type, ChangeType::ADDED, entity);
+
+                if (!wasChanged)
+                    LogChange(type, ChangeType::CHANGED, entity);
+            }
+
+            Archetype* GetOrCreateArchetype(Vector<Pair<TypeIndex, Unique<ComponentColumn>>>&& sortedColumns)
+            {
+                Vector<TypeIndex> signature;
+
+                for (const auto& column : sortedColumns)
+                    signature.push_back(column.first);
+
+                auto iterator = archetypes.find(signature);
+
+                if (iterator != archetypes.end())
+                    return iterator->second.get();
+
+                Unique<Archetype> archetype = std::make_unique<Archetype>(std::move(sortedColumns));
+                Archetype* out = archetype.get();
+
+                for (const TypeIndex& type : signature)
+                {
+                    if (changeLogs.find(type) == changeLogs.end())
+                        changeLogs.emplace(type, std::make_unique<ChangeLog>());
+                }
+
+                archetypes.emplace(std::move(signature), std::move(archetype));
+                archetypeList.push_back(out);
+
+                return out;
+            }
+
+            template<typename T>
+            Archetype* GetAddTarget(Archetype* source)
+            {
+                const TypeIndex type = TypeIndex(typeid(T));
+                auto edge = source->addEdges.find(type);
+
+                if (edge != source->addEdges.end())
+                    return edge->second;
+
+                Vector<Pair<TypeIndex, Unique<ComponentColumn>>> columns = source->CreateEmptyColumns();
+
+                auto position = std::lower_bound(columns.begin(), columns.end(), type, [](const auto& column, const TypeIndex& value) { return column.first < value; });
+                columns.emplace(position, type, std::make_unique<TypedComponentColumn<T>>());
+
+                Archetype* target = GetOrCreateArchetype(std::move(columns));
+
+                source->addEdges[type] = target;
+                target->removeEdges[type] = source;
+
+                return target;
+            }
+
+            Archetype* GetRemoveTarget(Archetype* source, const TypeIndex& type)
+            {
+                auto edge = source->removeEdges.find(type);
+
+                if (edge != source->removeEdges.end())
+                    return edge->second;
+
+                Vector<Pair<TypeIndex, Unique<ComponentColumn>>> columns = source->CreateEmptyColumns();
+
+                columns.erase(std::remove_if(columns.begin(), columns.end(), [&type](const auto& column) { return column.first == type; }), columns.end());
+
+                Archetype* target = GetOrCreateArchetype(std::move(columns));
+
+                source->removeEdges[type] = target;
+                target->addEdges[type] = source;
+
+                return target;
+            }
+
+            void MoveEntity(Entity entity, Archetype* target)
+            {
+                EntityRecord& record = records[entity.index];
+                Archetype* source = record.archetype;
+
+                for (Size c = 0; c < source->GetColumnCount(); ++c)
+                {
+                    ComponentColumn* targetColumn = target->GetColumn(source->GetSignature()[c]);
+
+                    if (targetColumn)
+                        targetColumn->MoveFrom(*source->GetColumnAt(c), record.row);
+                }
+
+                Size targetRow = target->AddRow(entity);
+
+                RemoveRow(source, record.row);
+
+                record.archetype = target;
+                record.row = targetRow;
+            }
+
+            void RemoveRow(Archetype* archetype, Size row)
+            {
+                Entity movedEntity = archetype->RemoveRow(row);
+
+                if (!movedEntity.IsNull())
+                    records[movedEntity.index].row = row;
+            }
+
+            Map<Vector<TypeIndex>, Unique<Archetype>> archetypes;
+            Vector<Archetype*> archetypeList;
+            Archetype* emptyArchetype = nullptr;
+
+            Vector<EntityRecord> records;
+            Vector<uint> freeIndices;
+            std::atomic<uint> nextIndex = 0;
+            Size entityCount = 0;
+            Mutex reservationMutex;
+
+            UnorderedMap<TypeIndex, Unique<ChangeLog>> changeLogs;
+            ullong tick = 1;
+
+            AtomicBool isDeferringStructuralChanges = false;
+        };
+	}
+}
\ No newline at end of file
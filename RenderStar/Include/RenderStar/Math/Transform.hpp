@@ -1,6 +1,8 @@
 #pragma once
 
 #include "RenderStar/ECS/Component.hpp"
+#include "RenderStar/ECS/World.hpp"
+#include "RenderStar/Math/TransformSystem.hpp"
 #include "RenderStar/Util/Typedefs.hpp"
 
 using namespace RenderStar::ECS;
@@ -15,155 +17,157 @@ namespace RenderStar
             
         public:
 
+            static constexpr bool IsStoredInline = true;
+
+            Transform() : system(TransformSystem::GetInstance().get()), handle(system->Allocate()) { }
+
+            Transform(const Transform&) = delete;
+            Transform& operator=(const Transform&) = delete;
+
+            Transform(Transform&& other) noexcept : Component(other), system(other.system), handle(other.handle)
+            {
+                other.handle = InvalidTransformHandle;
+            }
+
+            Transform& operator=(Transform&& other) noexcept
+            {
+                if (this == &other)
+                    return *this;
+
+                system->Release(handle);
+
+                entity = other.entity;
+                system = other.system;
+                handle = other.handle;
+
+                other.handle = InvalidTransformHandle;
+
+                return *this;
+            }
+
+            ~Transform()
+            {
+                system->Release(handle);
+            }
+
             void SetLocalPosition(const XMVector& position) 
             {
-                localPosition = position;
-                MarkDirty();
+                system->SetLocalPosition(handle, position);
+
+                World::GetInstance()->MarkChanged<Transform>(entity);
             }
 
             void SetLocalPosition(const Vector3f& position)
             {
-                localPosition = DirectX::XMLoadFloat3(&position);
-                MarkDirty();
+                system->SetLocalPosition(handle, DirectX::XMLoadFloat3(&position));
+
+                World::GetInstance()->MarkChanged<Transform>(entity);
             }
 
             void SetLocalRotation(const XMVector& rotation) 
             {
-                localRotation = rotation;
-                MarkDirty();
+                system->SetLocalRotation(handle, rotation);
+
+                World::GetInstance()->MarkChanged<Transform>(entity);
             }
 
             void SetLocalRotation(const Vector3f& rotation)
 			{
-				localRotation = DirectX::XMLoadFloat3(&rotation);
-				MarkDirty();
+				system->SetLocalRotation(handle, DirectX::XMLoadFloat3(&rotation));
+
+				World::GetInstance()->MarkChanged<Transform>(entity);
 			}
 
             void SetLocalScale(const XMVector& scale) 
             {
-                localScale = scale;
-                MarkDirty();
+                system->SetLocalScale(handle, scale);
+
+                World::GetInstance()->MarkChanged<Transform>(entity);
             }
 
             void SetLocalScale(const Vector3f& scale)
             {
-				localScale = DirectX::XMLoadFloat3(&scale);
-				MarkDirty();
+				system->SetLocalScale(handle, DirectX::XMLoadFloat3(&scale));
+
+				World::GetInstance()->MarkChanged<Transform>(entity);
             }
 
             XMVector GetLocalPosition() const
 			{
-				return localPosition;
+				return system->GetLocalPosition(handle);
 			}
 
             XMVector GetLocalRotation() const
             {
-				return localRotation;
+				return system->GetLocalRotation(handle);
             }
 
             XMVector GetLocalScale() const
             {
-				return localScale;
+				return system->GetLocalScale(handle);
             }
 
-            XMVector GetWorldPosition()
+            XMVector GetWorldPosition() const
             {
-                UpdateWorldMatrixIfNeeded();
-                return worldMatrix.r[3];
+                return GetWorldMatrix().r[3];
             }
 
             XMVector GetForwardVector() const
             {
-                return DirectX::XMVector3Normalize(XMVector3TransformNormal(DirectX::XMVectorSet(0, 0, 1, 0), worldMatrix));
+                return DirectX::XMVector3Normalize(XMVector3TransformNormal(DirectX::XMVectorSet(0, 0, 1, 0), GetWorldMatrix()));
             }
 
             XMVector GetRightVector() const
             {
-                return DirectX::XMVector3Normalize(XMVector3TransformNormal(DirectX::XMVectorSet(1, 0, 0, 0), worldMatrix));
+                return DirectX::XMVector3Normalize(XMVector3TransformNormal(DirectX::XMVectorSet(1, 0, 0, 0), GetWorldMatrix()));
             }
 
             XMVector GetUpVector() const
             {
-                return DirectX::XMVector3Normalize(XMVector3TransformNormal(DirectX::XMVectorSet(0, 1, 0, 0), worldMatrix));
+                return DirectX::XMVector3Normalize(XMVector3TransformNormal(DirectX::XMVectorSet(0, 1, 0, 0), GetWorldMatrix()));
             }
 
-            Matrix4f GetWorldMatrix()
+            Matrix4f GetWorldMatrix() const
             {
-                UpdateWorldMatrixIfNeeded();
-
-                return worldMatrix;
+                return system->GetWorldMatrix(handle);
             }
 
             void Translate(const XMVector& translation) 
             {
-                SetLocalPosition(DirectX::XMVectorAdd(localPosition, translation));
+                SetLocalPosition(DirectX::XMVectorAdd(GetLocalPosition(), translation));
             }
 
             void Rotate(const XMVector& rotation) 
             {
-                SetLocalRotation(DirectX::XMVectorAdd(localRotation, rotation));
-                WrapAngles();
+                SetLocalRotation(DirectX::XMVectorModAngles(DirectX::XMVectorAdd(GetLocalRotation(), rotation)));
             }
 
             void ScaleBy(const XMVector& scale) 
             {
-                SetLocalScale(DirectX::XMVectorMultiply(localScale, scale));
+                SetLocalScale(DirectX::XMVectorMultiply(GetLocalScale(), scale));
             }
 
-            void SetParent(Shared<Transform> parent)
+            void SetParent(const Transform* parent)
             {
-				parentTransform = parent;
+				system->SetParent(handle, parent ? parent->handle : InvalidTransformHandle);
 
-				MarkDirty();
-			}
-
-			static Shared<Transform> Create()
-			{
-				return std::make_shared<Transform>();
+				World::GetInstance()->MarkChanged<Transform>(entity);
 			}
 
-        private:
-
-            void MarkDirty() 
-            {
-                if (!isDirty) 
-                    isDirty = true;
-            }
-
-            void UpdateWorldMatrixIfNeeded() 
+            TransformHandle GetHandle() const
             {
-                if (isDirty) 
-                {
-                    RecalculateWorldMatrix();
-                    isDirty = false;
-                }
+                return handle;
             }
 
-            void RecalculateWorldMatrix()
-            {
-                Matrix4f scaleMatrix = DirectX::XMMatrixScalingFromVector(localScale);
-                Matrix4f rotationMatrix = DirectX::XMMatrixRotationRollPitchYawFromVector(localRotation);
-                Matrix4f translationMatrix = DirectX::XMMatrixTranslationFromVector(localPosition);
-
-                worldMatrix = DirectX::XMMatrixMultiply(scaleMatrix, rotationMatrix);
-                worldMatrix = DirectX::XMMatrixMultiply(worldMatrix, translationMatrix);
-
-                if (parentTransform)
-                    worldMatrix = DirectX::XMMatrixMultiply(worldMatrix, parentTransform->GetWorldMatrix());
-            }
-
-            void WrapAngles() 
-            {
-                localRotation = DirectX::XMVectorModAngles(localRotation);
-            }
+			static Transform Create()
+			{
+				return Transform();
+			}
 
-            XMVector localPosition = DirectX::XMVectorSet(0.0f, 0.0f, 0.0f, 0.0f);
-            XMVector localRotation = DirectX::XMVectorSet(0.0f, 0.0f, 0.0f, 1.0f);
-            XMVector localScale = DirectX::XMVectorSet(1.0f, 1.0f, 1.0f, 1.0f);
-            Matrix4f worldMatrix = DirectX::XMMatrixIdentity();
-            bool isDirty = true;
+        private:
 
-            Shared<Transform> parentTransform = nullptr;
+            TransformSystem* system;
+            TransformHandle handle = InvalidTransformHandle;
 		};
 	}
 }
\ No newline at end of file
@@ -0,0 +1,408 @@
+#pragma once
+
+#include "RenderStar/Util/Typedefs.hpp"
+
+using namespace RenderStar::Util;
+
+namespace RenderStar
+{
+	namespace Math
+	{
+        struct TransformHandle
+        {
+            uint index = ~0u;
+            uint generation = 0;
+
+            bool IsNull() const
+            {
+                return index == ~0u;
+            }
+
+            bool operator==(const TransformHandle& other) const
+            {
+                return index == other.index && generation == other.generation;
+            }
+
+            bool operator!=(const TransformHandle& other) const
+            {
+                return !(*this == other);
+            }
+        };
+
+        static const TransformHandle InvalidTransformHandle = {};
+
+        class TransformSystem
+        {
+
+        public:
+
+            TransformHandle Allocate()
+            {
+                TransformHandle handle;
+
+                if (!freeHandles.empty())
+                {
+                    handle.index = freeHandles.back();
+                    freeHandles.pop_back();
+                }
+                else
+                {
+                    handle.index = static_cast<uint>(handleToSlot.size());
+                    handleToSlot.push_back(InvalidSlot);
+                    generations.push_back(0);
+                }
+
+                handle.generation = generations[handle.index];
+                handleToSlot[handle.index] = static_cast<uint>(slotToHandle.size());
+
+                slotToHandle.push_back(handle);
+                parentHandles.push_back(InvalidTransformHandle);
+                parentSlots.push_back(InvalidSlot);
+                depths.push_back(0);
+                localPositions.push_back(DirectX::XMVectorSet(0.0f, 0.0f, 0.0f, 0.0f));
+                localRotations.push_back(DirectX::XMVectorSet(0.0f, 0.0f, 0.0f, 1.0f));
+                localScales.push_back(DirectX::XMVectorSet(1.0f, 1.0f, 1.0f, 1.0f));
+                worldMatrices.push_back(DirectX::XMMatrixIdentity());
+                dirtyFlags.push_back(1);
+
+                hasDirtyNodes = true;
+
+                return handle;
+            }
+
+            void Reserve(Size count)
+            {
+                handleToSlot.reserve(count);
+                generations.reserve(count);
+                slotToHandle.reserve(count);
+                parentHandles.reserve(count);
+                parentSlots.reserve(count);
+                depths.reserve(count);
+                localPositions.reserve(count);
+                localRotations.reserve(count);
+                localScales.reserve(count);
+                worldMatrices.reserve(count);
+                dirtyFlags.reserve(count);
+            }
+
+            void Release(TransformHandle handle)
+            {
+                if (!IsValid(handle))
+                    return;
+
+                const uint slot = handleToSlot[handle.index];
+
+                slotToHandle[slot] = InvalidTransformHandle;
+                handleToSlot[handle.index] = InvalidSlot;
+                generations[handle.index]++;
+                freeHandles.push_back(handle.index);
+
+                releasedNodeCount++;
+                isOrderDirty = true;
+            }
+
+            bool IsValid(TransformHandle handle) const
+            {
+                return handle.index < handleToSlot.size() && generations[handle.index] == handle.generation && handleToSlot[handle.index] != InvalidSlot;
+            }
+
+            bool SetParent(TransformHandle handle, TransformHandle parent)
+            {
+                if (!IsValid(handle))
+                    return false;
+
+                if (!IsValid(parent))
+                    parent = InvalidTransformHandle;
+
+                const uint slot = handleToSlot[handle.index];
+
+                if (parentHandles[slot] == parent)
+                    return true;
+
+                for (uint ancestor = GetSlot(parent); ancestor != InvalidSlot; ancestor = GetParentSlot(ancestor))
+                {
+                    if (ancestor == slot)
+                        return false;
+                }
+
+                parentHandles[slot] = parent;
+
+                isOrderDirty = true;
+                MarkDirty(slot);
+
+                return true;
+            }
+
+            TransformHandle GetParent(TransformHandle handle) const
+            {
+                return parentHandles[handleToSlot[handle.index]];
+            }
+
+            void SetLocalPosition(TransformHandle handle, const XMVector& position)
+            {
+                const uint slot = handleToSlot[handle.index];
+
+                localPositions[slot] = position;
+                MarkDirty(slot);
+            }
+
+            void SetLocalRotation(TransformHandle handle, const XMVector& rotation)
+            {
+                const uint slot = handleToSlot[handle.index];
+
+                localRotations[slot] = rotation;
+                MarkDirty(slot);
+            }
+
+            void SetLocalScale(TransformHandle handle, const XMVector& scale)
+            {
+                const uint slot = handleToSlot[handle.index];
+
+                localScales[slot] = scale;
+                MarkDirty(slot);
+            }
+
+            XMVector GetLocalPosition(TransformHandle handle) const
+            {
+                return localPositions[handleToSlot[handle.index]];
+            }
+
+            XMVector GetLocalRotation(TransformHandle handle) const
+            {
+                return localRotations[handleToSlot[handle.index]];
+            }
+
+            XMVector GetLocalScale(TransformHandle handle) const
+            {
+                return localScales[handleToSlot[handle.index]];
+            }
+
+            Matrix4f GetWorldMatrix(TransformHandle handle) const
+            {
+                return ComputeWorldMatrix(handleToSlot[handle.index]);
+            }
+
+            void Update()
+            {
+                if (isOrderDirty)
+                    Reorder();
+
+                if (!hasDirtyNodes)
+                    return;
+
+                const Size count = slotToHandle.size();
+
+                Matrix4f* worlds = worldMatrices.data();
+                const uint* parents = parentSlots.data();
+                uchar* dirty = dirtyFlags.data();
+
+                Size updatedCount = 0;
+
+                for (Size n = 0; n < count; ++n)
+                {
+                    const uint parent = parents[n];
+
+                    if (parent != InvalidSlot)
+                        dirty[n] |= dirty[parent];
+
+                    if (!dirty[n])
+                        continue;
+
+                    Matrix4f local = ComputeLocalMatrix(static_cast<uint>(n));
+
+                    worlds[n] = parent != InvalidSlot ? DirectX::XMMatrixMultiply(local, worlds[parent]) : local;
+
+                    updatedCount++;
+                }
+
+                std::fill(dirtyFlags.begin(), dirtyFlags.end(), uchar(0));
+
+                lastUpdatedCount = updatedCount;
+                hasDirtyNodes = false;
+            }
+
+            const Matrix4f* GetWorldMatrices() const
+            {
+                return worldMatrices.data();
+            }
+
+            uint GetSlot(TransformHandle handle) const
+            {
+                return IsValid(handle) ? handleToSlot[handle.index] : InvalidSlot;
+            }
+
+            Size GetCount() const
+            {
+                return slotToHandle.size();
+            }
+
+            Size GetLastUpdatedCount() const
+            {
+                return lastUpdatedCount;
+            }
+
+            static Shared<TransformSystem> GetInstance()
+            {
+                static Shared<TransformSystem> instance = std::make_shared<TransformSystem>();
+
+                return instance;
+            }
+
+        private:
+
+            static constexpr uint InvalidSlot = ~0u;
+
+            void MarkDirty(uint slot)
+            {
+                dirtyFlags[slot] = 1;
+                hasDirtyNodes = true;
+            }
+
+            Matrix4f ComputeLocalMatrix(uint slot) const
+            {
+                Matrix4f scaleMatrix = DirectX::XMMatrixScalingFromVector(localScales[slot]);
+                Matrix4f rotationMatrix = DirectX::XMMatrixRotationRollPitchYawFromVector(localRotations[slot]);
+                Matrix4f translationMatrix = DirectX::XMMatrixTranslationFromVector(localPositions[slot]);
+
+                return DirectX::XMMatrixMultiply(DirectX::XMMatrixMultiply(scaleMatrix, rotationMatrix), translationMatrix);
+            }
+
+            Matrix4f ComputeWorldMatrix(uint slot) const
+            {
+                uint stale = InvalidSlot;
+
+                for (uint ancestor = slot; ancestor != InvalidSlot; ancestor = GetParentSlot(ancestor))
+                {
+                    if (dirtyFlags[ancestor])
+                        stale = ancestor;
+                }
+
+                if (stale == InvalidSlot)
+                    return worldMatrices[slot];
+
+                Matrix4f world = ComputeLocalMatrix(slot);
+
+                for (uint ancestor = slot; ancestor != stale;)
+                {
+                    ancestor = GetParentSlot(ancestor);
+                    world = DirectX::XMMatrixMultiply(world, ComputeLocalMatrix(ancestor));
+                }
+
+                const uint parent = GetParentSlot(stale);
+
+                return parent != InvalidSlot ? DirectX::XMMatrixMultiply(world, worldMatrices[parent]) : world;
+            }
+
+            uint GetParentSlot(uint slot) const
+            {
+                return GetSlot(parentHandles[slot]);
+            }
+
+            void Reorder()
+            {
+                const Size count = slotToHandle.size();
+
+                Vector<uint> order;
+                order.reserve(count - releasedNodeCount);
+
+                for (uint slot = 0; slot < count; ++slot)
+                {
+                    if (slotToHandle[slot] == InvalidTransformHandle)
+                        continue;
+
+                    if (!parentHandles[slot].IsNull() && !IsValid(parentHandles[slot]))
+                    {
+                        parentHandles[slot] = InvalidTransformHandle;
+                        dirtyFlags[slot] = 1;
+                        hasDirtyNodes = true;
+                    }
+
+                    order.push_back(slot);
+                }
+
+                Vector<uint> computedDepths(count, InvalidSlot);
+
+                for (uint slot : order)
+                    computedDepths[slot] = ComputeDepth(slot, computedDepths);
+
+                std::stable_sort(order.begin(), order.end(), [&computedDepths](uint a, uint b) { return computedDepths[a] < computedDepths[b]; });
+
+                Permute(slotToHandle, order);
+                Permute(parentHandles, order);
+                Permute(localPositions, order);
+                Permute(localRotations, order);
+                Permute(localScales, order);
+                Permute(worldMatrices, order);
+                Permute(dirtyFlags, order);
+
+                depths.resize(order.size());
+
+                for (Size n = 0; n < order.size(); ++n)
+                {
+                    depths[n] = computedDepths[order[n]];
+                    handleToSlot[slotToHandle[n].index] = static_cast<uint>(n);
+                }
+
+                parentSlots.resize(order.size());
+
+                for (Size n = 0; n < order.size(); ++n)
+                    parentSlots[n] = GetSlot(parentHandles[n]);
+
+                releasedNodeCount = 0;
+                isOrderDirty = false;
+            }
+
+            uint ComputeDepth(uint slot, Vector<uint>& computedDepths) const
+            {
+                uint ancestor = slot;
+                uint length = 0;
+
+                while (ancestor != InvalidSlot && computedDepths[ancestor] == InvalidSlot)
+                {
+                    ancestor = GetParentSlot(ancestor);
+                    length++;
+                }
+
+                uint depth = (ancestor == InvalidSlot ? 0 : computedDepths[ancestor] + 1) + length;
+
+                for (uint node = slot; node != ancestor; node = GetParentSlot(node))
+                    computedDepths[node] = --depth;
+
+                return computedDepths[slot];
+            }
+
+            template<typename T>
+            static void Permute(Vector<T>& values, const Vector<uint>& order)
+            {
+                Vector<T> permuted;
+                permuted.reserve(order.size());
+
+                for (uint slot : order)
+                    permuted.push_back(values[slot]);
+
+                values = std::move(permuted);
+            }
+
+            Vector<TransformHandle> slotToHandle;
+            Vector<uint> handleToSlot;
+            Vector<uint> generations;
+            Vector<uint> freeHandles;
+
+            Vector<TransformHandle> parentHandles;
+            Vector<uint> parentSlots;
+            Vector<uint> depths;
+
+            Vector<XMVector> localPositions;
+            Vector<XMVector> localRotations;
+            Vector<XMVector> localScales;
+            Vector<Matrix4f> worldMatrices;
+            Vector<uchar> dirtyFlags;
+
+            Size releasedNodeCount = 0;
+            Size lastUpdatedCount = 0;
+
+            bool isOrderDirty = false;
+            AtomicBool hasDirtyNodes = false;
+        };
+	}
+}
\ No newline at end of file
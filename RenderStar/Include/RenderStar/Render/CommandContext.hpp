@@ -0,0 +1,570 @@
+#pragma once
+
+#include <d3d12.h>
+#include "RenderStar/Render/ResourceStateTracker.hpp"
+#include "RenderStar/Util/Typedefs.hpp"
+
+using namespace RenderStar::Util;
+
+namespace RenderStar
+{
+	namespace Render
+	{
+        enum class RenderCommandType
+        {
+            SET_ROOT_SIGNATURE,
+            SET_PIPELINE_STATE,
+            SET_DESCRIPTOR_HEAPS,
+            SET_ROOT_DESCRIPTOR_TABLE,
+            SET_ROOT_CONSTANT_BUFFER_VIEW,
+            SET_VERTEX_BUFFER,
+            SET_INDEX_BUFFER,
+            SET_PRIMITIVE_TOPOLOGY,
+            SET_RENDER_TARGETS,
+            SET_VIEWPORT,
+            SET_SCISSOR_RECT,
+            CLEAR_RENDER_TARGET,
+            CLEAR_DEPTH_STENCIL,
+            RESOURCE_BARRIER,
+            ALIASING_BARRIER,
+            DISCARD_RESOURCE,
+            COPY_BUFFER_REGION,
+            DRAW_INDEXED
+        };
+
+        struct RenderCommand
+        {
+            RenderCommandType type;
+            uint slot = 0;
+
+            Array<ullong, 5> arguments = {};
+
+            bool operator==(const RenderCommand&) const = default;
+        };
+
+        struct CommandStatistics
+        {
+            Size commandCount = 0;
+            Size drawCount = 0;
+            Size indexCount = 0;
+            Size instanceCount = 0;
+            Size barrierCount = 0;
+            Size barrierBatchCount = 0;
+            Size discardCount = 0;
+            Size copyCount = 0;
+            Size copyBytes = 0;
+
+            Size rootSignatureChanges = 0;
+            Size pipelineStateChanges = 0;
+            Size descriptorHeapChanges = 0;
+            Size descriptorTableChanges = 0;
+            Size constantBufferChanges = 0;
+            Size vertexBufferChanges = 0;
+            Size indexBufferChanges = 0;
+
+            Size redundantStateChanges = 0;
+
+            void Merge(const CommandStatistics& other)
+            {
+                commandCount += other.commandCount;
+                drawCount += other.drawCount;
+                indexCount += other.indexCount;
+                instanceCount += other.instanceCount;
+                barrierCount += other.barrierCount;
+                barrierBatchCount += other.barrierBatchCount;
+                discardCount += other.discardCount;
+                copyCount += other.copyCount;
+                copyBytes += other.copyBytes;
+                rootSignatureChanges += other.rootSignatureChanges;
+                pipelineStateChanges += other.pipelineStateChanges;
+                descriptorHeapChanges += other.descriptorHeapChanges;
+                descriptorTableChanges += other.descriptorTableChanges;
+                constantBufferChanges += other.constantBufferChanges;
+                vertexBufferChanges += other.vertexBufferChanges;
+                indexBufferChanges += other.indexBufferChanges;
+                redundantStateChanges += other.redundantStateChanges;
+            }
+        };
+
+        class CommandStream
+        {
+
+        public:
+
+            static constexpr Size NoDifference = ~Size(0);
+
+            void Append(const RenderCommand& command)
+            {
+                commands.push_back(command);
+            }
+
+            void Append(const CommandStream& other)
+            {
+                commands.insert(commands.end(), other.commands.begin(), other.commands.end());
+            }
+
+            void Clear()
+            {
+                commands.clear();
+            }
+
+            const Vector<RenderCommand>& GetCommands() const
+            {
+                return commands;
+            }
+
+            Size GetSize() const
+            {
+                return commands.size();
+            }
+
+            Size FindFirstDifference(const CommandStream& other) const
+            {
+                const Size count = std::min(commands.size(), other.commands.size());
+
+                for (Size c = 0; c < count; ++c)
+                {
+                    if (!(commands[c] == other.commands[c]))
+                        return c;
+                }
+
+                return commands.size() == other.commands.size() ? NoDifference : count;
+            }
+
+            static String ToString(const RenderCommand& command)
+            {
+                static const Array<const char*, 18> names =
+                {
+                    "SetRootSignature", "SetPipelineState", "SetDescriptorHeaps", "SetRootDescriptorTable", "SetRootConstantBufferView", "SetVertexBuffer", "SetIndexBuffer", "SetPrimitiveTopology", "SetRenderTargets",
+                    "SetViewport", "SetScissorRect", "ClearRenderTarget", "ClearDepthStencil", "ResourceBarrier", "AliasingBarrier", "DiscardResource", "CopyBufferRegion", "DrawIndexed"
+                };
+
+                String out = String(names[static_cast<Size>(command.type)]) + "(" + std::to_string(command.slot);
+
+                for (ullong argument : command.arguments)
+                    out += ", " + std::to_string(argument);
+
+                return out + ")";
+            }
+
+        private:
+
+            Vector<RenderCommand> commands;
+        };
+
+        class CommandContext
+        {
+
+        public:
+
+            virtual ~CommandContext() = default;
+
+            virtual void SetRootSignature(ID3D12RootSignature* rootSignature) = 0;
+            virtual void SetPipelineState(ID3D12PipelineState* pipelineState) = 0;
+            virtual void SetDescriptorHeaps(ID3D12DescriptorHeap* cbvSrvUavHeap, ID3D12DescriptorHeap* samplerHeap) = 0;
+            virtual void SetRootDescriptorTable(UINT slot, D3D12_GPU_DESCRIPTOR_HANDLE handle) = 0;
+            virtual void SetRootConstantBufferView(UINT slot, D3D12_GPU_VIRTUAL_ADDRESS address) = 0;
+            virtual void SetVertexBuffer(UINT slot, const D3D12_VERTEX_BUFFER_VIEW& view) = 0;
+            virtual void SetIndexBuffer(const D3D12_INDEX_BUFFER_VIEW& view) = 0;
+            virtual void SetPrimitiveTopology(D3D12_PRIMITIVE_TOPOLOGY topology) = 0;
+            virtual void SetRenderTargets(D3D12_CPU_DESCRIPTOR_HANDLE renderTarget, D3D12_CPU_DESCRIPTOR_HANDLE depthStencil) = 0;
+            virtual void SetViewport(const D3D12_VIEWPORT& viewport) = 0;
+            virtual void SetScissorRect(const D3D12_RECT& rect) = 0;
+            virtual void ClearRenderTarget(D3D12_CPU_DESCRIPTOR_HANDLE renderTarget, const float color[4]) = 0;
+            virtual void ClearDepthStencil(D3D12_CPU_DESCRIPTOR_HANDLE depthStencil, float depth) = 0;
+            virtual void ResourceBarriers(Span<const D3D12_RESOURCE_BARRIER> barriers) = 0;
+            virtual void DiscardResource(ID3D12Resource* resource) = 0;
+            virtual void CopyBufferRegion(ID3D12Resource* destination, UINT64 destinationOffset, ID3D12Resource* source, UINT64 sourceOffset, UINT64 size) = 0;
+            virtual void DrawIndexed(UINT indexCount, UINT instanceCount, UINT startIndex, INT baseVertex, UINT startInstance) = 0;
+
+            virtual ID3D12GraphicsCommandList* GetCommandList() const = 0;
+
+            void TransitionResource(ID3D12Resource* resource, D3D12_RESOURCE_STATES state)
+            {
+                stateTracker.Transition(resource, state);
+            }
+
+            void AliasResource(ID3D12Resource* before, ID3D12Resource* after)
+            {
+                stateTracker.Alias(before, after);
+            }
+
+            void FlushBarriers()
+            {
+                if (!stateTracker.HasPendingBarriers())
+                    return;
+
+                ResourceBarriers(stateTracker.GetPendingBarriers());
+
+                stateTracker.ClearPendingBarriers();
+            }
+
+            ResourceStateTracker& GetStateTracker()
+            {
+                return stateTracker;
+            }
+
+        protected:
+
+            ResourceStateTracker stateTracker;
+        };
+
+        class D3D12CommandContext : public CommandContext
+        {
+
+        public:
+
+            void SetCommandList(ID3D12GraphicsCommandList* commandList)
+            {
+                this->commandList = commandList;
+            }
+
+            void Reset(ResourceStateRegistry* registry = nullptr)
+            {
+                descriptorHeapChanges = 0;
+
+                stateTracker.Reset(registry);
+            }
+
+            void SetRootSignature(ID3D12RootSignature* rootSignature) override
+            {
+                commandList->SetGraphicsRootSignature(rootSignature);
+            }
+
+            void SetPipelineState(ID3D12PipelineState* pipelineState) override
+            {
+                commandList->SetPipelineState(pipelineState);
+            }
+
+            void SetDescriptorHeaps(ID3D12DescriptorHeap* cbvSrvUavHeap, ID3D12DescriptorHeap* samplerHeap) override
+            {
+                ID3D12DescriptorHeap* descriptorHeaps[] = { cbvSrvUavHeap, samplerHeap };
+                commandList->SetDescriptorHeaps(samplerHeap ? 2 : 1, descriptorHeaps);
+
+                descriptorHeapChanges++;
+            }
+
+            void SetRootDescriptorTable(UINT slot, D3D12_GPU_DESCRIPTOR_HANDLE handle) override
+            {
+                commandList->SetGraphicsRootDescriptorTable(slot, handle);
+            }
+
+            void SetRootConstantBufferView(UINT slot, D3D12_GPU_VIRTUAL_ADDRESS address) override
+            {
+                commandList->SetGraphicsRootConstantBufferView(slot, address);
+            }
+
+            void SetVertexBuffer(UINT slot, const D3D12_VERTEX_BUFFER_VIEW& view) override
+            {
+                commandList->IASetVertexBuffers(slot, 1, &view);
+            }
+
+            void SetIndexBuffer(const D3D12_INDEX_BUFFER_VIEW& view) override
+            {
+                commandList->IASetIndexBuffer(&view);
+            }
+
+            void SetPrimitiveTopology(D3D12_PRIMITIVE_TOPOLOGY topology) override
+            {
+                commandList->IASetPrimitiveTopology(topology);
+            }
+
+            void SetRenderTargets(D3D12_CPU_DESCRIPTOR_HANDLE renderTarget, D3D12_CPU_DESCRIPTOR_HANDLE depthStencil) override
+            {
+                commandList->OMSetRenderTargets(1, &renderTarget, FALSE, &depthStencil);
+            }
+
+            void SetViewport(const D3D12_VIEWPORT& viewport) override
+            {
+                commandList->RSSetViewports(1, &viewport);
+            }
+
+            void SetScissorRect(const D3D12_RECT& rect) override
+            {
+                commandList->RSSetScissorRects(1, &rect);
+            }
+
+            void ClearRenderTarget(D3D12_CPU_DESCRIPTOR_HANDLE renderTarget, const float color[4]) override
+            {
+                FlushBarriers();
+
+                commandList->ClearRenderTargetView(renderTarget, color, 0, nullptr);
+            }
+
+            void ClearDepthStencil(D3D12_CPU_DESCRIPTOR_HANDLE depthStencil, float depth) override
+            {
+                FlushBarriers();
+
+                commandList->ClearDepthStencilView(depthStencil, D3D12_CLEAR_FLAG_DEPTH, depth, 0, 0, nullptr);
+            }
+
+            void ResourceBarriers(Span<const D3D12_RESOURCE_BARRIER> barriers) override
+            {
+                if (!barriers.empty())
+                    commandList->ResourceBarrier(static_cast<UINT>(barriers.size()), barriers.data());
+            }
+
+            void DiscardResource(ID3D12Resource* resource) override
+            {
+                FlushBarriers();
+
+                commandList->DiscardResource(resource, nullptr);
+            }
+
+            void CopyBufferRegion(ID3D12Resource* destination, UINT64 destinationOffset, ID3D12Resource* source, UINT64 sourceOffset, UINT64 size) override
+            {
+                FlushBarriers();
+
+                commandList->CopyBufferRegion(destination, destinationOffset, source, sourceOffset, size);
+            }
+
+            void DrawIndexed(UINT indexCount, UINT instanceCount, UINT startIndex, INT baseVertex, UINT startInstance) override
+            {
+                FlushBarriers();
+
+                commandList->DrawIndexedInstanced(indexCount, instanceCount, startIndex, baseVertex, startInstance);
+            }
+
+            ID3D12GraphicsCommandList* GetCommandList() const override
+            {
+                return commandList;
+            }
+
+            Size GetDescriptorHeapChanges() const
+            {
+                return descriptorHeapChanges;
+            }
+
+        private:
+
+            ID3D12GraphicsCommandList* commandList = nullptr;
+
+            Size descriptorHeapChanges = 0;
+        };
+
+        class RecordingCommandContext : public CommandContext
+        {
+
+        public:
+
+            void Reset(ResourceStateRegistry* registry = nullptr)
+            {
+                stream.Clear();
+                statistics = {};
+                redundantCommands.clear();
+                state = {};
+
+                stateTracker.Reset(registry);
+            }
+
+            void SetRootSignature(ID3D12RootSignature* rootSignature) override
+            {
+                Record({ RenderCommandType::SET_ROOT_SIGNATURE, 0, { ToArgument(rootSignature) } }, state.rootSignature);
+                statistics.rootSignatureChanges++;
+            }
+
+            void SetPipelineState(ID3D12PipelineState* pipelineState) override
+            {
+                Record({ RenderCommandType::SET_PIPELINE_STATE, 0, { ToArgument(pipelineState) } }, state.pipelineState);
+                statistics.pipelineStateChanges++;
+            }
+
+            void SetDescriptorHeaps(ID3D12DescriptorHeap* cbvSrvUavHeap, ID3D12DescriptorHeap* samplerHeap) override
+            {
+                Record({ RenderCommandType::SET_DESCRIPTOR_HEAPS, 0, { ToArgument(cbvSrvUavHeap), ToArgument(samplerHeap) } }, state.descriptorHeaps);
+                statistics.descriptorHeapChanges++;
+            }
+
+            void SetRootDescriptorTable(UINT slot, D3D12_GPU_DESCRIPTOR_HANDLE handle) override
+            {
+                Record({ RenderCommandType::SET_ROOT_DESCRIPTOR_TABLE, slot, { handle.ptr } }, state.descriptorTables[std::min<Size>(slot, MaxRootSlots - 1)]);
+                statistics.descriptorTableChanges++;
+            }
+
+            void SetRootConstantBufferView(UINT slot, D3D12_GPU_VIRTUAL_ADDRESS address) override
+            {
+                Record({ RenderCommandType::SET_ROOT_CONSTANT_BUFFER_VIEW, slot, { address } }, state.constantBuffers[std::min<Size>(slot, MaxRootSlots - 1)]);
+                statistics.constantBufferChanges++;
+            }
+
+            void SetVertexBuffer(UINT slot, const D3D12_VERTEX_BUFFER_VIEW& view) override
+            {
+                Record({ RenderCommandType::SET_VERTEX_BUFFER, slot, { view.BufferLocation, view.SizeInBytes, view.StrideInBytes } }, state.vertexBuffers[std::min<Size>(slot, MaxVertexBufferSlots - 1)]);
+                statistics.vertexBufferChanges++;
+            }
+
+            void SetIndexBuffer(const D3D12_INDEX_BUFFER_VIEW& view) override
+            {
+                Record({ RenderCommandType::SET_INDEX_BUFFER, 0, { view.BufferLocation, view.SizeInBytes, static_cast<ullong>(view.Format) } }, state.indexBuffer);
+                statistics.indexBufferChanges++;
+            }
+
+            void SetPrimitiveTopology(D3D12_PRIMITIVE_TOPOLOGY topology) override
+            {
+                Record({ RenderCommandType::SET_PRIMITIVE_TOPOLOGY, 0, { static_cast<ullong>(topology) } }, state.primitiveTopology);
+            }
+
+            void SetRenderTargets(D3D12_CPU_DESCRIPTOR_HANDLE renderTarget, D3D12_CPU_DESCRIPTOR_HANDLE depthStencil) override
+            {
+                Record({ RenderCommandType::SET_RENDER_TARGETS, 0, { renderTarget.ptr, depthStencil.ptr } });
+            }
+
+            void SetViewport(const D3D12_VIEWPORT& viewport) override
+            {
+                Record({ RenderCommandType::SET_VIEWPORT, 0, { static_cast<ullong>(viewport.Width), static_cast<ullong>(viewport.Height) } });
+            }
+
+            void SetScissorRect(const D3D12_RECT& rect) override
+            {
+                Record({ RenderCommandType::SET_SCISSOR_RECT, 0, { static_cast<ullong>(rect.right - rect.left), static_cast<ullong>(rect.bottom - rect.top) } });
+            }
+
+            void ClearRenderTarget(D3D12_CPU_DESCRIPTOR_HANDLE renderTarget, const float color[4]) override
+            {
+                FlushBarriers();
+
+                Record({ RenderCommandType::CLEAR_RENDER_TARGET, 0, { renderTarget.ptr } });
+            }
+
+            void ClearDepthStencil(D3D12_CPU_DESCRIPTOR_HANDLE depthStencil, float depth) override
+            {
+                FlushBarriers();
+
+                Record({ RenderCommandType::CLEAR_DEPTH_STENCIL, 0, { depthStencil.ptr } });
+            }
+
+            void ResourceBarriers(Span<const D3D12_RESOURCE_BARRIER> barriers) override
+            {
+                if (barriers.empty())
+                    return;
+
+                for (const D3D12_RESOURCE_BARRIER& barrier : barriers)
+                {
+                    switch (barrier.Type)
+                    {
+
+                    case D3D12_RESOURCE_BARRIER_TYPE_ALIASING:
+                        Record({ RenderCommandType::ALIASING_BARRIER, 0, { ToArgument(barrier.Aliasing.pResourceBefore), ToArgument(barrier.Aliasing.pResourceAfter) } });
+                        break;
+
+                    default:
+                        Record({ RenderCommandType::RESOURCE_BARRIER, 0, { ToArgument(barrier.Transition.pResource), static_cast<ullong>(barrier.Transition.StateBefore), static_cast<ullong>(barrier.Transition.StateAfter) } });
+                        break;
+                    }
+                }
+
+                statistics.barrierCount += barriers.size();
+                statistics.barrierBatchCount++;
+            }
+
+            void DiscardResource(ID3D12Resource* resource) override
+            {
+                FlushBarriers();
+
+                Record({ RenderCommandType::DISCARD_RESOURCE, 0, { ToArgument(resource) } });
+
+                statistics.discardCount++;
+            }
+
+            void CopyBufferRegion(ID3D12Resource* destination, UINT64 destinationOffset, ID3D12Resource* source, UINT64 sourceOffset, UINT64 size) override
+            {
+                FlushBarriers();
+
+                Record({ RenderCommandType::COPY_BUFFER_REGION, 0, { ToArgument(destination), destinationOffset, ToArgument(source), size } });
+
+                statistics.copyCount++;
+                statistics.copyBytes += size;
+            }
+
+            void DrawIndexed(UINT indexCount, UINT instanceCount, UINT startIndex, INT baseVertex, UINT startInstance) override
+            {
+                FlushBarriers();
+
+                Record({ RenderCommandType::DRAW_INDEXED, 0, { indexCount, instanceCount, startIndex, static_cast<ullong>(static_cast<slongint>(baseVertex)), startInstance } });
+
+                statistics.drawCount++;
+                statistics.indexCount += static_cast<Size>(indexCount) * instanceCount;
+                statistics.instanceCount += instanceCount;
+            }
+
+            ID3D12GraphicsCommandList* GetCommandList() const override
+            {
+                return nullptr;
+            }
+
+            void Append(const RecordingCommandContext& other)
+            {
+                for (Size command : other.redundantCommands)
+                    redundantCommands.push_back(stream.GetSize() + command);
+
+                stream.Append(other.stream);
+                statistics.Merge(other.statistics);
+            }
+
+            const CommandStream& GetStream() const
+            {
+                return stream;
+            }
+
+            const CommandStatistics& GetStatistics() const
+            {
+                return statistics;
+            }
+
+            const Vector<Size>& GetRedundantCommands() const
+            {
+                return redundantCommands;
+            }
+
+        private:
+
+            static constexpr Size MaxRootSlots = 16;
+            static constexpr Size MaxVertexBufferSlots = 4;
+
+            struct TrackedState
+            {
+                Optional<RenderCommand> rootSignature;
+                Optional<RenderCommand> pipelineState;
+                Optional<RenderCommand> descriptorHeaps;
+                Optional<RenderCommand> indexBuffer;
+                Optional<RenderCommand> primitiveTopology;
+
+                Array<Optional<RenderCommand>, MaxVertexBufferSlots> vertexBuffers;
+                Array<Optional<RenderCommand>, MaxRootSlots> descriptorTables;
+                Array<Optional<RenderCommand>, MaxRootSlots> constantBuffers;
+            };
+
+            template<typename T>
+            static ullong ToArgument(T* pointer)
+            {
+                return static_cast<ullong>(reinterpret_cast<uintptr_t>(pointer));
+            }
+
+            void Record(const RenderCommand& command)
+            {
+                stream.Append(command);
+                statistics.commandCount++;
+            }
+
+            void Record(const RenderCommand& command, Optional<RenderCommand>& current)
+            {
+                if (current && *current == command)
+                {
+                    redundantCommands.push_back(stream.GetSize());
+                    statistics.redundantStateChanges++;
+                }
+
+                current = command;
+
+                Record(command);
+            }
+
+            CommandStream stream;
+            CommandStatistics statistics;
+
+            Vector<Size> redundantCommands;
+
+            TrackedState state;
+        };
+	}
+}
\ No newline at end of file
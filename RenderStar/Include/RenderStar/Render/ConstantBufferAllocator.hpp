@@ -0,0 +1,310 @@
+#pragma once
+
+#include "RenderStar/Core/Settings.hpp"
+#include "RenderStar/Render/Renderer.hpp"
+#include "RenderStar/Util/Typedefs.hpp"
+
+using namespace RenderStar::Core;
+using namespace RenderStar::Util;
+
+namespace RenderStar
+{
+	namespace Render
+	{
+        struct ConstantAllocation
+        {
+            void* data = nullptr;
+
+            D3D12_GPU_VIRTUAL_ADDRESS gpuAddress = 0;
+        };
+
+        struct ConstantBufferStatistics
+        {
+            Size allocationCount = 0;
+            Size peakFrameBytes = 0;
+            Size pageCount = 0;
+        };
+
+        class ConstantBufferAllocator
+        {
+
+        public:
+
+            static constexpr Size Alignment = D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT;
+
+            void Initialize()
+            {
+                pageSize = std::max<Size>(Settings::GetInstance()->Get<uint>("constantBufferPageSize"), MinimumPageSize);
+                pageSize = (pageSize + Alignment - 1) & ~(Alignment - 1);
+            }
+
+            void Reset()
+            {
+                currentFrame = Renderer::GetInstance()->GetFrameIndex();
+
+                FrameSlot& slot = frameSlots[currentFrame];
+
+                const ullong cursor = slot.cursor.load(std::memory_order_relaxed);
+                const Size frameBytes = static_cast<Size>(cursor >> 32) * pageSize + static_cast<Size>(cursor & 0xFFFFFFFFull);
+
+                statistics.peakFrameBytes = std::max(statistics.peakFrameBytes, frameBytes);
+
+                slot.cursor.store(0, std::memory_order_release);
+
+                epoch.fetch_add(1, std::memory_order_release);
+            }
+
+            ConstantAllocation Allocate(Size size)
+            {
+                const Size alignedSize = (size + Alignment - 1) & ~(Alignment - 1);
+
+                ThreadBlock& block = GetThreadBlock();
+
+                if (block.epoch != epoch.load(std::memory_order_acquire) || block.offset + alignedSize > block.size)
+                    AcquireBlock(block, alignedSize);
+
+                ConstantAllocation out = { block.data + block.offset, block.gpuAddress + block.offset };
+
+                block.offset += alignedSize;
+                block.allocationCount++;
+
+                return out;
+            }
+
+            D3D12_GPU_VIRTUAL_ADDRESS Push(const void* data, Size size)
+            {
+                ConstantAllocation allocation = Allocate(size);
+
+                memcpy(allocation.data, data, size);
+
+                return allocation.gpuAddress;
+            }
+
+            template<typename T>
+            D3D12_GPU_VIRTUAL_ADDRESS Push(const T& data)
+            {
+                return Push(&data, sizeof(T));
+            }
+
+            ConstantBufferStatistics GetStatistics()
+            {
+                ConstantBufferStatistics out = statistics;
+
+                for (FrameSlot& slot : frameSlots)
+                {
+                    out.allocationCount += slot.allocationCount.load(std::memory_order_relaxed);
+                    out.pageCount += slot.pageCount.load(std::memory_order_acquire);
+                }
+
+                return out;
+            }
+
+            void LogStatistics()
+            {
+                const ConstantBufferStatistics out = GetStatistics();
+
+                Logger_WriteConsole("Constant buffers: " + std::to_string(out.allocationCount) + " allocations, " + std::to_string(out.peakFrameBytes / 1024) + " KiB peak per frame, " + std::to_string(out.pageCount) + " pages of " + std::to_string(pageSize / 1024) + " KiB", LogLevel::INFORMATION);
+            }
+
+            void CleanUp()
+            {
+                for (FrameSlot& slot : frameSlots)
+                {
+                    for (Unique<Page>& page : slot.pages)
+                    {
+                        if (page && page->resource)
+                        {
+                            page->resource->Unmap(0, nullptr);
+
+                            Renderer::GetInstance()->ReleaseDeferred(std::move(page->resource));
+                        }
+
+                        page.reset();
+                    }
+
+                    slot.pageCount.store(0, std::memory_order_release);
+                    slot.cursor.store(0, std::memory_order_release);
+                }
+            }
+
+            static Shared<ConstantBufferAllocator> GetInstance()
+            {
+                static Shared<ConstantBufferAllocator> instance = std::make_shared<ConstantBufferAllocator>();
+
+                return instance;
+            }
+
+        private:
+
+            static constexpr Size MinimumPageSize = 65536;
+            static constexpr Size MaxFrameCount = 4;
+            static constexpr Size MaxPagesPerFrame = 256;
+            static constexpr Size BlockSize = 16384;
+
+            struct Page
+            {
+                ComPtr<ID3D12Resource> resource;
+                Unique<uchar[]> memory;
+
+                uchar* data = nullptr;
+
+                D3D12_GPU_VIRTUAL_ADDRESS gpuAddress = 0;
+            };
+
+            struct FrameSlot
+            {
+                Array<Unique<Page>, MaxPagesPerFrame> pages;
+
+                std::atomic<ullong> cursor = 0;
+                std::atomic<Size> pageCount = 0;
+                std::atomic<Size> allocationCount = 0;
+            };
+
+            struct ThreadBlock
+            {
+                ullong epoch = 0;
+
+                uchar* data = nullptr;
+
+                D3D12_GPU_VIRTUAL_ADDRESS gpuAddress = 0;
+
+                Size offset = 0;
+                Size size = 0;
+                Size allocationCount = 0;
+                Size slotIndex = 0;
+            };
+
+            static ThreadBlock& GetThreadBlock()
+            {
+                thread_local ThreadBlock block;
+
+                return block;
+            }
+
+            void AcquireBlock(ThreadBlock& block, Size alignedSize)
+            {
+                if (alignedSize > pageSize)
+                {
+                    Logger_ThrowError("FAILED", "Constant block of " + std::to_string(alignedSize) + " bytes exceeds the constant buffer page size", true);
+                    return;
+                }
+
+                if (block.allocationCount > 0)
+                    frameSlots[block.slotIndex].allocationCount.fetch_add(block.allocationCount, std::memory_order_relaxed);
+
+                const ullong currentEpoch = epoch.load(std::memory_order_acquire);
+
+                FrameSlot& slot = frameSlots[currentFrame];
+
+                const Size blockSize = std::max(std::min(BlockSize, pageSize), alignedSize);
+
+                ullong cursor = slot.cursor.load(std::memory_order_acquire);
+
+                while (true)
+                {
+                    const Size pageIndex = static_cast<Size>(cursor >> 32);
+                    const Size offset = static_cast<Size>(cursor & 0xFFFFFFFFull);
+
+                    if (offset + alignedSize <= pageSize)
+                    {
+                        const Size reserved = std::min(blockSize, pageSize - offset);
+
+                        if (!slot.cursor.compare_exchange_weak(cursor, cursor + reserved, std::memory_order_acq_rel, std::memory_order_acquire))
+                            continue;
+
+                        Page& page = GetPage(slot, pageIndex);
+
+                        block.epoch = currentEpoch;
+                        block.data = page.data + offset;
+                        block.gpuAddress = page.gpuAddress + offset;
+                        block.offset = 0;
+                        block.size = reserved;
+                        block.allocationCount = 0;
+                        block.slotIndex = currentFrame;
+
+                        return;
+                    }
+
+                    cursor = AdvancePage(slot, cursor);
+                }
+            }
+
+            Page& GetPage(FrameSlot& slot, Size pageIndex)
+            {
+                if (pageIndex >= slot.pageCount.load(std::memory_order_acquire))
+                {
+                    LockGuard<Mutex> lock(mutex);
+
+                    while (slot.pageCount.load(std::memory_order_relaxed) <= pageIndex)
+                    {
+                        slot.pages[slot.pageCount.load(std::memory_order_relaxed)] = CreatePage();
+                        slot.pageCount.fetch_add(1, std::memory_order_release);
+                    }
+                }
+
+                return *slot.pages[pageIndex];
+            }
+
+            ullong AdvancePage(FrameSlot& slot, ullong observed)
+            {
+                LockGuard<Mutex> lock(mutex);
+
+                const ullong cursor = slot.cursor.load(std::memory_order_acquire);
+
+                if (cursor != observed)
+                    return cursor;
+
+                const ullong nextPage = (observed >> 32) + 1;
+
+                if (nextPage >= MaxPagesPerFrame)
+                    Logger_ThrowError("FAILED", "Constant buffer allocator ran out of pages for this frame", true);
+
+                const ullong next = nextPage << 32;
+
+                slot.cursor.store(next, std::memory_order_release);
+
+                return next;
+            }
+
+            Unique<Page> CreatePage()
+            {
+                Unique<Page> out = std::make_unique<Page>();
+
+                if (Renderer::GetInstance()->IsHeadless())
+                {
+                    out->memory = std::make_unique<uchar[]>(pageSize + Alignment);
+                    out->gpuAddress = (static_cast<D3D12_GPU_VIRTUAL_ADDRESS>(reinterpret_cast<uintptr_t>(out->memory.get())) + Alignment - 1) & ~static_cast<D3D12_GPU_VIRTUAL_ADDRESS>(Alignment - 1);
+                    out->data = reinterpret_cast<uchar*>(static_cast<uintptr_t>(out->gpuAddress));
+
+                    return out;
+                }
+
+                CD3DX12_HEAP_PROPERTIES heapProperties(D3D12_HEAP_TYPE_UPLOAD);
+                CD3DX12_RESOURCE_DESC bufferDescription = CD3DX12_RESOURCE_DESC::Buffer(pageSize);
+
+                HRESULT result = Renderer::GetInstance()->GetDevice()->CreateCommittedResource(&heapProperties, D3D12_HEAP_FLAG_NONE, &bufferDescription, D3D12_RESOURCE_STATE_GENERIC_READ, nullptr, IID_PPV_ARGS(&out->resource));
+
+                if (FAILED(result))
+                    Logger_ThrowError("FAILED", "Failed to create constant buffer page", true);
+
+                CD3DX12_RANGE readRange(0, 0);
+                out->resource->Map(0, &readRange, reinterpret_cast<void**>(&out->data));
+
+                out->gpuAddress = out->resource->GetGPUVirtualAddress();
+
+                return out;
+            }
+
+            Array<FrameSlot, MaxFrameCount> frameSlots;
+
+            Size pageSize = MinimumPageSize;
+            Size currentFrame = 0;
+
+            std::atomic<ullong> epoch = 1;
+
+            ConstantBufferStatistics statistics;
+
+            Mutex mutex;
+        };
+	}
+}
\ No newline at end of file
@@ -0,0 +1,213 @@
+#pragma once
+
+#include <d3d12.h>
+#include <d3dx12.h>
+#include "RenderStar/Core/FreeListAllocator.hpp"
+#include "RenderStar/Core/Logger.hpp"
+#include "RenderStar/Util/Typedefs.hpp"
+
+using namespace RenderStar::Core;
+using namespace RenderStar::Util;
+
+namespace RenderStar
+{
+	namespace Render
+	{
+        struct DescriptorAllocation
+        {
+            Size index = 0;
+            Size count = 0;
+        };
+
+        struct DescriptorHeapStatistics
+        {
+            FreeListStatistics persistent;
+
+            Size transientCapacity = 0;
+            Size peakTransientCount = 0;
+            Size transientAllocationCount = 0;
+        };
+
+        class DescriptorHeap
+        {
+
+        public:
+
+            void Initialize(ID3D12Device2* device, D3D12_DESCRIPTOR_HEAP_TYPE type, Size persistentCapacity, Size transientCapacity, UINT frameCount)
+            {
+                this->type = type;
+                this->frameCount = std::clamp<UINT>(frameCount, 1, MaxFrameCount);
+                this->persistentCapacity = persistentCapacity;
+                this->transientCapacity = transientCapacity / this->frameCount;
+
+                persistentAllocator = FreeListAllocator(persistentCapacity);
+
+                if (!device)
+                    return;
+
+                D3D12_DESCRIPTOR_HEAP_DESC heapDescription = {};
+
+                heapDescription.NumDescriptors = static_cast<UINT>(GetCapacity());
+                heapDescription.Type = type;
+                heapDescription.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE;
+
+                HRESULT result = device->CreateDescriptorHeap(&heapDescription, IID_PPV_ARGS(&heap));
+
+                if (FAILED(result))
+                    Logger_ThrowError("FAILED", "Failed to create shader visible descriptor heap", true);
+
+                descriptorSize = device->GetDescriptorHandleIncrementSize(type);
+                cpuStart = heap->GetCPUDescriptorHandleForHeapStart();
+                gpuStart = heap->GetGPUDescriptorHandleForHeapStart();
+            }
+
+            void BeginFrame(UINT frameIndex, ullong frameNumber)
+            {
+                currentFrame = frameIndex % frameCount;
+
+                const Size used = transientCursors[currentFrame].exchange(0, std::memory_order_relaxed);
+
+                peakTransientCount = std::max(peakTransientCount, used);
+
+                LockGuard<Mutex> lock(mutex);
+
+                Size retired = 0;
+
+                for (; retired < pendingFrees.size() && pendingFrees[retired].frameNumber + frameCount <= frameNumber; ++retired)
+                    persistentAllocator.Free(pendingFrees[retired].allocation.index, pendingFrees[retired].allocation.count);
+
+                pendingFrees.erase(pendingFrees.begin(), pendingFrees.begin() + retired);
+
+                this->frameNumber = frameNumber;
+            }
+
+            DescriptorAllocation AllocatePersistent(Size count = 1)
+            {
+                LockGuard<Mutex> lock(mutex);
+
+                Optional<Size> index = persistentAllocator.Allocate(count);
+
+                if (!index)
+                {
+                    Logger_ThrowError("FAILED", "Descriptor heap is out of persistent descriptors", true);
+                    return {};
+                }
+
+                return { *index, count };
+            }
+
+            void FreePersistent(const DescriptorAllocation& allocation)
+            {
+                if (allocation.count == 0)
+                    return;
+
+                LockGuard<Mutex> lock(mutex);
+
+                pendingFrees.push_back({ frameNumber, allocation });
+            }
+
+            DescriptorAllocation AllocateTransient(Size count)
+            {
+                const Size offset = transientCursors[currentFrame].fetch_add(count, std::memory_order_relaxed);
+
+                if (offset + count > transientCapacity)
+                {
+                    Logger_ThrowError("FAILED", "Descriptor heap is out of transient descriptors for this frame", true);
+                    return {};
+                }
+
+                transientAllocationCount.fetch_add(1, std::memory_order_relaxed);
+
+                return { persistentCapacity + currentFrame * transientCapacity + offset, count };
+            }
+
+            D3D12_CPU_DESCRIPTOR_HANDLE GetCpuHandle(Size index) const
+            {
+                return { cpuStart.ptr + index * descriptorSize };
+            }
+
+            D3D12_GPU_DESCRIPTOR_HANDLE GetGpuHandle(Size index) const
+            {
+                return { gpuStart.ptr + index * descriptorSize };
+            }
+
+            D3D12_GPU_DESCRIPTOR_HANDLE GetGpuStart() const
+            {
+                return gpuStart;
+            }
+
+            ID3D12DescriptorHeap* Get() const
+            {
+                return heap.Get();
+            }
+
+            Size GetCapacity() const
+            {
+                return persistentCapacity + transientCapacity * frameCount;
+            }
+
+            DescriptorHeapStatistics GetStatistics()
+            {
+                LockGuard<Mutex> lock(mutex);
+
+                DescriptorHeapStatistics out;
+
+                out.persistent = persistentAllocator.GetStatistics();
+                out.transientCapacity = transientCapacity;
+                out.peakTransientCount = std::max(peakTransientCount, transientCursors[currentFrame].load(std::memory_order_relaxed));
+                out.transientAllocationCount = transientAllocationCount.load(std::memory_order_relaxed);
+
+                return out;
+            }
+
+            void LogStatistics(const String& name)
+            {
+                const DescriptorHeapStatistics out = GetStatistics();
+
+                Logger_WriteConsole("Descriptor heap " + name + ": " + std::to_string(out.persistent.usedSize) + " / " + std::to_string(out.persistent.capacity) + " persistent descriptors, " + std::to_string(out.persistent.peakUsedSize) + " peak, " + std::to_string(out.persistent.freeBlockCount) + " free blocks, " + std::to_string(out.peakTransientCount) + " / " + std::to_string(out.transientCapacity) + " peak transient descriptors per frame", LogLevel::INFORMATION);
+            }
+
+            void CleanUp()
+            {
+                heap.Reset();
+            }
+
+        private:
+
+            static constexpr UINT MaxFrameCount = 4;
+
+            struct PendingFree
+            {
+                ullong frameNumber;
+
+                DescriptorAllocation allocation;
+            };
+
+            D3D12_DESCRIPTOR_HEAP_TYPE type = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
+
+            ComPtr<ID3D12DescriptorHeap> heap;
+
+            D3D12_CPU_DESCRIPTOR_HANDLE cpuStart = {};
+            D3D12_GPU_DESCRIPTOR_HANDLE gpuStart = {};
+
+            UINT descriptorSize = 0;
+            UINT frameCount = 1;
+            UINT currentFrame = 0;
+
+            ullong frameNumber = 0;
+
+            Size persistentCapacity = 0;
+            Size transientCapacity = 0;
+            Size peakTransientCount = 0;
+
+            FreeListAllocator persistentAllocator;
+
+            Vector<PendingFree> pendingFrees;
+
+            Array<std::atomic<Size>, MaxFrameCount> transientCursors = {};
+            std::atomic<Size> transientAllocationCount = 0;
+
+            Mutex mutex;
+        };
+	}
+}
\ No newline at end of file
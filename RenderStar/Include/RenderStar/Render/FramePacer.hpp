@@ -0,0 +1,102 @@
+#pragma once
+
+#include <d3d12.h>
+#include "RenderStar/Util/Typedefs.hpp"
+
+using namespace RenderStar::Util;
+
+namespace RenderStar
+{
+	namespace Render
+	{
+        class FramePacer
+        {
+
+        public:
+
+            static constexpr UINT MaxFrameCount = 4;
+
+            void Initialize(UINT frameCount, UINT frameIndex = 0)
+            {
+                this->frameCount = std::clamp<UINT>(frameCount, 1, MaxFrameCount);
+                this->frameIndex = frameIndex % this->frameCount;
+
+                std::fill(std::begin(fenceValues), std::end(fenceValues), UINT64(0));
+
+                fenceValues[this->frameIndex] = 1;
+                waitCount = 0;
+            }
+
+            template<typename C, typename W>
+            float Advance(UINT nextFrameIndex, C&& getCompletedValue, W&& waitForValue)
+            {
+                const UINT64 submittedValue = fenceValues[frameIndex];
+
+                frameIndex = nextFrameIndex % frameCount;
+
+                const TimePoint waitStart = Clock::now();
+
+                if (getCompletedValue() < fenceValues[frameIndex])
+                {
+                    waitForValue(fenceValues[frameIndex]);
+                    waitCount++;
+                }
+
+                const float waitTime = Duration(Clock::now() - waitStart).count();
+
+                fenceValues[frameIndex] = submittedValue + 1;
+
+                return waitTime;
+            }
+
+            void IncrementFenceValue()
+            {
+                fenceValues[frameIndex]++;
+            }
+
+            void Reset(UINT frameIndex)
+            {
+                const UINT64 nextValue = fenceValues[this->frameIndex];
+
+                this->frameIndex = frameIndex % frameCount;
+
+                std::fill(std::begin(fenceValues), std::end(fenceValues), nextValue - 1);
+
+                fenceValues[this->frameIndex] = nextValue;
+            }
+
+            UINT GetFrameIndex() const
+            {
+                return frameIndex;
+            }
+
+            UINT GetNextFrameIndex() const
+            {
+                return (frameIndex + 1) % frameCount;
+            }
+
+            UINT GetFrameCount() const
+            {
+                return frameCount;
+            }
+
+            UINT64 GetFenceValue() const
+            {
+                return fenceValues[frameIndex];
+            }
+
+            UINT64 GetWaitCount() const
+            {
+                return waitCount;
+            }
+
+        private:
+
+            UINT frameCount = 1;
+            UINT frameIndex = 0;
+
+            UINT64 fenceValues[MaxFrameCount] = {};
+            UINT64 waitCount = 0;
+        };
+	}
+}
\ No newline at end of file
@@ -0,0 +1,239 @@
+#pragma once
+
+#include "RenderStar/Core/FreeListAllocator.hpp"
+#include "RenderStar/Core/Settings.hpp"
+#include "RenderStar/Render/Renderer.hpp"
+#include "RenderStar/Render/UploadQueue.hpp"
+#include "RenderStar/Render/Vertex.hpp"
+#include "RenderStar/Util/Typedefs.hpp"
+
+using namespace RenderStar::Core;
+using namespace RenderStar::Util;
+
+namespace RenderStar
+{
+	namespace Render
+	{
+        struct GeometryAllocation
+        {
+            Size vertexOffset = 0;
+            Size vertexCount = 0;
+            Size indexOffset = 0;
+            Size indexCount = 0;
+        };
+
+        class GeometryBuffer
+        {
+
+        public:
+
+            void Initialize()
+            {
+                vertexRegion.name = "vertices";
+                vertexRegion.stride = sizeof(Vertex);
+
+                indexRegion.name = "indices";
+                indexRegion.stride = sizeof(uint);
+
+                Grow(vertexRegion, Settings::GetInstance()->Get<uint>("geometryBufferVertexCapacity"));
+                Grow(indexRegion, Settings::GetInstance()->Get<uint>("geometryBufferIndexCapacity"));
+            }
+
+            GeometryAllocation Allocate(Span<const Vertex> vertices, Span<const uint> indices)
+            {
+                LockGuard<Mutex> lock(mutex);
+
+                GeometryAllocation out;
+
+                out.vertexCount = vertices.size();
+                out.vertexOffset = Allocate(vertexRegion, vertices.size());
+                out.indexCount = indices.size();
+                out.indexOffset = Allocate(indexRegion, indices.size());
+
+                Upload(vertexRegion, out.vertexOffset, vertices.data(), vertices.size());
+                Upload(indexRegion, out.indexOffset, indices.data(), indices.size());
+
+                return out;
+            }
+
+            void Free(const GeometryAllocation& allocation)
+            {
+                LockGuard<Mutex> lock(mutex);
+
+                pendingFrees.push_back({ Renderer::GetInstance()->GetFrameStatistics().frameNumber, allocation });
+            }
+
+            void Flush()
+            {
+                LockGuard<Mutex> lock(mutex);
+
+                RetireFrees();
+            }
+
+            D3D12_VERTEX_BUFFER_VIEW GetVertexBufferView() const
+            {
+                return { vertexRegion.resource ? vertexRegion.resource->GetGPUVirtualAddress() : 0, static_cast<UINT>(vertexRegion.allocator.GetCapacity() * vertexRegion.stride), static_cast<UINT>(vertexRegion.stride) };
+            }
+
+            D3D12_INDEX_BUFFER_VIEW GetIndexBufferView() const
+            {
+                return { indexRegion.resource ? indexRegion.resource->GetGPUVirtualAddress() : 0, static_cast<UINT>(indexRegion.allocator.GetCapacity() * indexRegion.stride), DXGI_FORMAT_R32_UINT };
+            }
+
+            FreeListStatistics GetVertexStatistics()
+            {
+                LockGuard<Mutex> lock(mutex);
+
+                return vertexRegion.allocator.GetStatistics();
+            }
+
+            FreeListStatistics GetIndexStatistics()
+            {
+                LockGuard<Mutex> lock(mutex);
+
+                return indexRegion.allocator.GetStatistics();
+            }
+
+            void LogStatistics()
+            {
+                LockGuard<Mutex> lock(mutex);
+
+                for (const Region* region : { &vertexRegion, &indexRegion })
+                {
+                    const FreeListStatistics statistics = region->allocator.GetStatistics();
+
+                    Logger_WriteConsole("Geometry buffer " + region->name + ": " + std::to_string(statistics.usedSize * region->stride / 1024) + " / " + std::to_string(statistics.capacity * region->stride / 1024) + " KiB used, " + std::to_string(statistics.peakUsedSize * region->stride / 1024) + " KiB peak, " + std::to_string(statistics.liveAllocationCount) + " live allocations, " + std::to_string(statistics.freeBlockCount) + " free blocks, largest " + std::to_string(statistics.largestFreeBlock * region->stride / 1024) + " KiB, " + std::to_string(statistics.GetFragmentation() * 100.0f) + "% fragmented", LogLevel::INFORMATION);
+                }
+
+                Logger_WriteConsole("Geometry buffer uploads: " + std::to_string(uploadedBytes / 1024) + " KiB uploaded", LogLevel::INFORMATION);
+            }
+
+            void CleanUp()
+            {
+                LockGuard<Mutex> lock(mutex);
+
+                for (Region* region : { &vertexRegion, &indexRegion })
+                    Release(region->resource);
+            }
+
+            static Shared<GeometryBuffer> GetInstance()
+            {
+                static Shared<GeometryBuffer> instance = std::make_shared<GeometryBuffer>();
+
+                return instance;
+            }
+
+        private:
+
+            struct Region
+            {
+                String name;
+
+                FreeListAllocator allocator;
+
+                ComPtr<ID3D12Resource> resource;
+
+                Size stride = 1;
+            };
+
+            struct PendingFree
+            {
+                ullong frameNumber;
+
+                GeometryAllocation allocation;
+            };
+
+            Size Allocate(Region& region, Size count)
+            {
+                Optional<Size> offset = region.allocator.Allocate(count);
+
+                if (!offset)
+                {
+                    Grow(region, std::max(region.allocator.GetCapacity() * 2, region.allocator.GetCapacity() + count));
+
+                    offset = region.allocator.Allocate(count);
+                }
+
+                return *offset;
+            }
+
+            void Grow(Region& region, Size capacity)
+            {
+                const Size previousCapacity = region.allocator.GetCapacity();
+
+                region.allocator.Grow(capacity);
+
+                if (Renderer::GetInstance()->IsHeadless())
+                    return;
+
+                ComPtr<ID3D12Resource> previousResource = std::move(region.resource);
+
+                CD3DX12_HEAP_PROPERTIES heapProperties(D3D12_HEAP_TYPE_DEFAULT);
+                CD3DX12_RESOURCE_DESC bufferDescription = CD3DX12_RESOURCE_DESC::Buffer(region.allocator.GetCapacity() * region.stride);
+
+                HRESULT result = Renderer::GetInstance()->GetDevice()->CreateCommittedResource(&heapProperties, D3D12_HEAP_FLAG_NONE, &bufferDescription, D3D12_RESOURCE_STATE_COMMON, nullptr, IID_PPV_ARGS(&region.resource));
+
+                if (FAILED(result))
+                    Logger_ThrowError("FAILED", "Failed to create geometry buffer", true);
+
+                Renderer::GetInstance()->GetResourceStates().Register(region.resource.Get(), D3D12_RESOURCE_STATE_COMMON, true);
+
+                if (!previousResource)
+                    return;
+
+                UploadQueue::GetInstance()->CopyBuffer(region.resource.Get(), 0, previousResource.Get(), 0, previousCapacity * region.stride);
+
+                Release(previousResource);
+            }
+
+            void Release(ComPtr<ID3D12Resource>& resource)
+            {
+                if (!resource)
+                    return;
+
+                Renderer::GetInstance()->GetResourceStates().Unregister(resource.Get());
+                Renderer::GetInstance()->ReleaseDeferred(std::move(resource));
+            }
+
+            void Upload(Region& region, Size offset, const void* data, Size count)
+            {
+                if (count == 0)
+                    return;
+
+                const Size size = count * region.stride;
+
+                uploadedBytes += size;
+
+                if (!Renderer::GetInstance()->IsHeadless())
+                    UploadQueue::GetInstance()->UploadBuffer(region.resource.Get(), offset * region.stride, data, size);
+            }
+
+            void RetireFrees()
+            {
+                const ullong frameNumber = Renderer::GetInstance()->GetFrameStatistics().frameNumber;
+                const ullong frameCount = Renderer::GetInstance()->GetFrameCount();
+
+                Size retired = 0;
+
+                for (; retired < pendingFrees.size() && pendingFrees[retired].frameNumber + frameCount <= frameNumber; ++retired)
+                {
+                    const GeometryAllocation& allocation = pendingFrees[retired].allocation;
+
+                    vertexRegion.allocator.Free(allocation.vertexOffset, allocation.vertexCount);
+                    indexRegion.allocator.Free(allocation.indexOffset, allocation.indexCount);
+                }
+
+                pendingFrees.erase(pendingFrees.begin(), pendingFrees.begin() + retired);
+            }
+
+            Region vertexRegion;
+            Region indexRegion;
+
+            Vector<PendingFree> pendingFrees;
+
+            Size uploadedBytes = 0;
+
+            Mutex mutex;
+        };
+	}
+}
\ No newline at end of file
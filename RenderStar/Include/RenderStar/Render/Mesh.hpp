@@ -1,6 +1,9 @@
 #pragma once
 
+#include "RenderStar/Core/PoolAllocator.hpp"
 #include "RenderStar/ECS/GameObjectManager.hpp"
+#include "RenderStar/Render/GeometryBuffer.hpp"
+#include "RenderStar/Render/RenderQueue.hpp"
 #include "RenderStar/Render/ShaderManager.hpp"
 #include "RenderStar/Render/TextureManager.hpp"
 #include "RenderStar/Render/Vertex.hpp"
@@ -13,6 +16,60 @@ namespace RenderStar
 {
 	namespace Render
 	{
+        struct MeshGeometry
+        {
+            Vector<Vertex> vertices;
+            Vector<uint> indices;
+
+            Span<const Vertex> vertexView;
+            Span<const uint> indexView;
+
+            Shared<const void> source;
+
+            Optional<GeometryAllocation> allocation;
+
+            uint sortId = 0;
+            uint meshCount = 0;
+
+            Span<const Vertex> GetVertices() const
+            {
+                return source ? vertexView : Span<const Vertex>(vertices);
+            }
+
+            Span<const uint> GetIndices() const
+            {
+                return source ? indexView : Span<const uint>(indices);
+            }
+
+            bool IsView() const
+            {
+                return source != nullptr;
+            }
+
+            static Shared<MeshGeometry> Create(const Vector<Vertex>& vertices, const Vector<uint>& indices)
+            {
+                Shared<MeshGeometry> out = MakePooled<MeshGeometry>();
+
+                out->vertices = vertices;
+                out->indices = indices;
+                out->sortId = SortKey::AllocateId();
+
+                return out;
+            }
+
+            static Shared<MeshGeometry> CreateView(Shared<const void> source, Span<const Vertex> vertices, Span<const uint> indices)
+            {
+                Shared<MeshGeometry> out = MakePooled<MeshGeometry>();
+
+                out->vertexView = vertices;
+                out->indexView = indices;
+                out->source = std::move(source);
+                out->sortId = SortKey::AllocateId();
+
+                return out;
+            }
+        };
+
         class Mesh : public Component
         {
 
@@ -20,49 +77,129 @@ namespace RenderStar
 
             void Initialize() override
             {
-                shader = gameObject->GetComponent<Shader>();
-                texture = gameObject->GetComponent<Texture>();
+                Shared<Shader>* shaderComponent = World::GetInstance()->GetComponent<Shader>(entity);
+                Shared<Texture>* textureComponent = World::GetInstance()->GetComponent<Texture>(entity);
 
-                if (!shader || !texture)
+                if (!shaderComponent || !textureComponent)
                 {
                     Logger_ThrowError("Initialization Error", "Shader or Texture component missing from GameObject", true);
                     return;
                 }
 
-                if (!texture->GetRaw())
+                texture = *textureComponent;
+
+                ResolveShader(*shaderComponent);
+
+                Transform* transformComponent = World::GetInstance()->GetComponent<Transform>(entity);
+
+                if (transformComponent)
                 {
-                    Logger_ThrowError("Initialization Error", "Texture resource is invalid", true);
-                    return;
+                    transformSystem = TransformSystem::GetInstance().get();
+                    transform = transformComponent->GetHandle();
                 }
 
-                shader->CreateTexture(texture->GetRaw(), 0);
-                shader->CreateSampler(0);
+                if (Renderer::GetInstance()->IsHeadless())
+                    return;
+
+                if (!texture->GetRaw())
+                    Logger_ThrowError("Initialization Error", "Texture resource is invalid", true);
             }
 
             void Generate()
             {
-                CreateVertexBuffer();
-                CreateIndexBuffer();
+                geometryDirty = false;
+
+                if (!geometry->allocation)
+                    geometry->allocation = GeometryBuffer::GetInstance()->Allocate(geometry->GetVertices(), geometry->GetIndices());
             }
 
             void Render() override
             {
-                if (!shader)
+                if (geometryDirty)
+                    Generate();
+
+                if (!pipeline || !geometry || !geometry->allocation)
                     return;
 
-                texture->Bind();
-                shader->Bind();
+                Shared<RenderQueue> queue = RenderQueue::GetInstance();
+
+                queue->Submit(CreateRenderItem(queue->GetViewMatrix()));
+            }
+
+            static void RenderAll(Span<Shared<Mesh>> meshes)
+            {
+                Shared<RenderQueue> queue = RenderQueue::GetInstance();
+                const Matrix4f viewMatrix = queue->GetViewMatrix();
+
+                Vector<RenderItem> items;
+
+                items.reserve(meshes.size());
+
+                for (const Shared<Mesh>& mesh : meshes)
+                {
+                    if (mesh->geometryDirty)
+                        mesh->Generate();
+
+                    if (mesh->pipeline && mesh->geometry && mesh->geometry->allocation)
+                        items.push_back(mesh->CreateRenderItem(viewMatrix));
+                }
+
+                queue->Submit(items);
+            }
+
+            bool IsThreadSafe() const override
+            {
+                return false;
+            }
+
+            void SetPass(uint pass)
+            {
+                this->pass = pass;
+            }
+
+            uint GetPass() const
+            {
+                return pass;
+            }
+
+            void SetPipelineVariant(const PipelineStateVariant& variant)
+            {
+                pipelineVariant = variant;
+
+                if (shader)
+                    pipeline = shader->GetPipelineState(variant);
+            }
+
+            const PipelineStateVariant& GetPipelineVariant() const
+            {
+                return pipelineVariant;
+            }
+
+            void SetShaderKeywords(const Vector<String>& keywords)
+            {
+                shaderKeywords = keywords;
+
+                Shared<Shader>* shaderComponent = World::GetInstance()->GetComponent<Shader>(entity);
 
-                UINT stride = sizeof(Vertex);
-                UINT offset = 0;
+                if (shader && shaderComponent)
+                    ResolveShader(*shaderComponent);
+            }
 
-                ComPtr<ID3D12GraphicsCommandList> commandList = Renderer::GetInstance()->GetCommandList();
+            const Vector<String>& GetShaderKeywords() const
+            {
+                return shaderKeywords;
+            }
 
-                commandList->IASetVertexBuffers(0, 1, &vertexBufferView);
-                commandList->IASetIndexBuffer(&indexBufferView);
-                commandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+            void SetConstants(const void* data, Size dataSize, UINT rootParameterIndex)
+            {
+                constants.assign(static_cast<const uchar*>(data), static_cast<const uchar*>(data) + dataSize);
+                constantBufferSlot = rootParameterIndex;
+            }
 
-                commandList->DrawIndexedInstanced(static_cast<UINT>(indices.size()), 1, 0, 0, 0);
+            template<typename T>
+            void SetConstants(const T& data, UINT rootParameterIndex)
+            {
+                SetConstants(&data, sizeof(T), rootParameterIndex);
             }
 
             String GetName() const
@@ -72,29 +209,68 @@ namespace RenderStar
 
             Pair<Vector<Vertex>, Vector<uint>> GetMeshData() const
             {
-                return { vertices, indices };
+                const Span<const Vertex> vertices = geometry->GetVertices();
+                const Span<const uint> indices = geometry->GetIndices();
+
+                return { Vector<Vertex>(vertices.begin(), vertices.end()), Vector<uint>(indices.begin(), indices.end()) };
+            }
+
+            void SetMeshData(const Vector<Vertex>& vertices, const Vector<uint>& indices)
+            {
+                SetGeometry(MeshGeometry::Create(vertices, indices));
+
+                geometryDirty = true;
+            }
+
+            Shared<const MeshGeometry> GetGeometry() const
+            {
+                return geometry;
+            }
+
+            MeshGeometry& GetMutableGeometry()
+            {
+                if (IsGeometryShared() || geometry->IsView())
+                {
+                    const Pair<Vector<Vertex>, Vector<uint>> data = GetMeshData();
+
+                    SetGeometry(MeshGeometry::Create(data.first, data.second));
+                }
+                else
+                    ReleaseBuffers();
+
+                geometryDirty = true;
+
+                return *geometry;
+            }
+
+            bool IsGeometryShared() const
+            {
+                return geometry && geometry->meshCount > 1;
             }
 
             void CleanUp() override
             {
-                vertices.clear();
-                indices.clear();
+                SetGeometry(nullptr);
             }
 
             static Shared<Mesh> Create(const String& name, const Vector<Vertex>& vertices, const Vector<uint>& indices)
             {
-                Shared<Mesh> out = std::make_shared<Mesh>();
+                return Create(name, MeshGeometry::Create(vertices, indices));
+            }
+
+            static Shared<Mesh> Create(const String& name, Shared<MeshGeometry> geometry)
+            {
+                Shared<Mesh> out = MakePooled<Mesh>();
 
                 out->name = name;
-                out->vertices = vertices;
-                out->indices = indices;
+                out->SetGeometry(geometry);
 
                 return out;
             }
 
-            static Shared<GameObject> CreateGameObject(const String& name, const String& shader, const String& texture, const Vector<Vertex>& vertices, const Vector<uint>& indices)
+            static GameObject* CreateGameObject(const String& name, const String& shader, const String& texture, const Vector<Vertex>& vertices, const Vector<uint>& indices)
             {
-                Shared<GameObject> out = GameObjectManager::GetInstance()->Create(name);
+                GameObject* out = GameObjectManager::GetInstance()->Create(name);
 
                 out->AddComponent(ShaderManager::GetInstance()->Get(shader));
                 out->AddComponent(TextureManager::GetInstance()->Get(texture));
@@ -105,70 +281,85 @@ namespace RenderStar
 
         private:
 
-            void CreateVertexBuffer()
+            void ResolveShader(const Shared<Shader>& material)
             {
-                auto device = Renderer::GetInstance()->GetDevice();
-
-                const UINT vertexBufferSize = static_cast<UINT>(vertices.size() * sizeof(Vertex));
+                shader = shaderKeywords.empty() ? material : material->GetPermutation(shaderKeywords);
+                pipeline = shader->GetPipelineState(pipelineVariant);
+            }
 
-                CD3DX12_HEAP_PROPERTIES heapProperties(D3D12_HEAP_TYPE_UPLOAD);
-                CD3DX12_RESOURCE_DESC resourceDescription = CD3DX12_RESOURCE_DESC::Buffer(vertexBufferSize);
+            RenderItem CreateRenderItem(const Matrix4f& viewMatrix) const
+            {
+                RenderItem out;
 
-                HRESULT result = device->CreateCommittedResource(&heapProperties, D3D12_HEAP_FLAG_NONE, &resourceDescription, D3D12_RESOURCE_STATE_GENERIC_READ, nullptr, IID_PPV_ARGS(&vertexBuffer));
+                const Matrix4f world = transformSystem && transformSystem->IsValid(transform) ? transformSystem->GetWorldMatrix(transform) : DirectX::XMMatrixIdentity();
+                const float depth = DirectX::XMVectorGetZ(DirectX::XMVector3TransformCoord(world.r[3], viewMatrix));
 
-                if (FAILED(result))
-                    Logger_ThrowError("FAILED", "Failed to create vertex buffer", true);
+                DirectX::XMStoreFloat4x4(&out.world, world);
 
-                void* vertexData = nullptr;
+                out.sortKey = SortKey::Create(pass, shader->GetRootSignatureSortId(), pipeline->sortId, shader->IsBindless() ? 0 : texture->GetSortId(), geometry->sortId, depth, pipelineVariant.alphaBlend);
+                out.shader = shader.get();
+                out.pipelineState = pipeline->pipelineState.Get();
+                out.pipelineSortId = pipeline->sortId;
+                out.texture = texture.get();
+                out.textureDescriptor = texture->GetDescriptorIndex();
+                out.geometryId = geometry->sortId;
+                out.indexCount = static_cast<UINT>(geometry->allocation->indexCount);
+                out.startIndex = static_cast<UINT>(geometry->allocation->indexOffset);
+                out.baseVertex = static_cast<INT>(geometry->allocation->vertexOffset);
 
-                CD3DX12_RANGE readRange(0, 0);
-                vertexBuffer->Map(0, &readRange, &vertexData);
-                memcpy(vertexData, vertices.data(), vertexBufferSize);
-                vertexBuffer->Unmap(0, nullptr);
+                if (!constants.empty())
+                {
+                    out.constantBuffer = ConstantBufferAllocator::GetInstance()->Push(constants.data(), constants.size());
+                    out.constantBufferSlot = constantBufferSlot;
+                }
 
-                vertexBufferView.BufferLocation = vertexBuffer->GetGPUVirtualAddress();
-                vertexBufferView.StrideInBytes = sizeof(Vertex);
-                vertexBufferView.SizeInBytes = vertexBufferSize;
+                return out;
             }
 
-            void CreateIndexBuffer()
+            void SetGeometry(Shared<MeshGeometry> newGeometry)
             {
-                auto device = Renderer::GetInstance()->GetDevice();
+                if (geometry)
+                {
+                    ReleaseBuffers();
 
-                const UINT indexBufferSize = static_cast<UINT>(indices.size() * sizeof(uint));
+                    geometry->meshCount--;
+                }
 
-                CD3DX12_HEAP_PROPERTIES heapProperties(D3D12_HEAP_TYPE_UPLOAD);
-                CD3DX12_RESOURCE_DESC resourceDescription = CD3DX12_RESOURCE_DESC::Buffer(indexBufferSize);
+                geometry = std::move(newGeometry);
 
-                HRESULT result = device->CreateCommittedResource(&heapProperties, D3D12_HEAP_FLAG_NONE, &resourceDescription, D3D12_RESOURCE_STATE_GENERIC_READ, nullptr, IID_PPV_ARGS(&indexBuffer));
+                if (geometry)
+                    geometry->meshCount++;
+            }
 
-                if (FAILED(result))
-                    Logger_ThrowError("FAILED", "Failed to create index buffer", true);
+            void ReleaseBuffers()
+            {
+                if (!geometry || IsGeometryShared() || !geometry->allocation)
+                    return;
 
-                void* indexData = nullptr;
-                CD3DX12_RANGE readRange(0, 0);
-                indexBuffer->Map(0, &readRange, &indexData);
-                memcpy(indexData, indices.data(), indexBufferSize);
-                indexBuffer->Unmap(0, nullptr);
+                GeometryBuffer::GetInstance()->Free(*geometry->allocation);
 
-                indexBufferView.BufferLocation = indexBuffer->GetGPUVirtualAddress();
-                indexBufferView.Format = DXGI_FORMAT_R32_UINT;
-                indexBufferView.SizeInBytes = indexBufferSize;
+                geometry->allocation.reset();
             }
 
             String name;
 
             Shared<Shader> shader;
             Shared<Texture> texture;
+            TransformSystem* transformSystem = nullptr;
+            TransformHandle transform = InvalidTransformHandle;
 
-            Vector<Vertex> vertices;
-            Vector<uint> indices;
+            Vector<String> shaderKeywords;
+
+            PipelineStateVariant pipelineVariant;
+            const CachedPipelineState* pipeline = nullptr;
+
+            Shared<MeshGeometry> geometry;
+            bool geometryDirty = false;
 
-            ComPtr<ID3D12Resource> vertexBuffer;
-            D3D12_VERTEX_BUFFER_VIEW vertexBufferView = {};
+            Vector<uchar> constants;
+            UINT constantBufferSlot = 0;
 
-            ComPtr<ID3D12Resource> indexBuffer;
-            D3D12_INDEX_BUFFER_VIEW indexBufferView = {};
+            uint pass = 0;
         };
 	}
 }
\ No newline at end of file
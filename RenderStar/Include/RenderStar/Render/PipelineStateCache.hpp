@@ -0,0 +1,413 @@
+#pragma once
+
+#include <d3d12.h>
+#include <d3dx12.h>
+#include "RenderStar/Core/Logger.hpp"
+#include "RenderStar/Core/Settings.hpp"
+#include "RenderStar/Render/Renderer.hpp"
+#include "RenderStar/Render/SortKey.hpp"
+#include "RenderStar/Util/Hash.hpp"
+#include "RenderStar/Util/MappedFile.hpp"
+#include "RenderStar/Util/Typedefs.hpp"
+
+using namespace RenderStar::Core;
+using namespace RenderStar::Util;
+
+namespace RenderStar
+{
+	namespace Render
+	{
+        struct PipelineStateVariant
+        {
+            D3D12_FILL_MODE fillMode = D3D12_FILL_MODE_SOLID;
+            D3D12_CULL_MODE cullMode = D3D12_CULL_MODE_BACK;
+
+            bool alphaBlend = false;
+            bool depthTest = true;
+            bool depthWrite = true;
+
+            DXGI_FORMAT renderTargetFormat = DXGI_FORMAT_R8G8B8A8_UNORM;
+            DXGI_FORMAT depthStencilFormat = DXGI_FORMAT_D32_FLOAT;
+
+            uint GetKey() const
+            {
+                return static_cast<uint>(fillMode & 0x3) | static_cast<uint>(cullMode & 0x3) << 2 | static_cast<uint>(alphaBlend) << 4 | static_cast<uint>(depthTest) << 5 | static_cast<uint>(depthWrite) << 6 | static_cast<uint>(renderTargetFormat & 0xFF) << 8 | static_cast<uint>(depthStencilFormat & 0xFF) << 16;
+            }
+
+            void Apply(D3D12_GRAPHICS_PIPELINE_STATE_DESC& description) const
+            {
+                description.RasterizerState = CD3DX12_RASTERIZER_DESC(D3D12_DEFAULT);
+                description.RasterizerState.FillMode = fillMode;
+                description.RasterizerState.CullMode = cullMode;
+
+                description.BlendState = CD3DX12_BLEND_DESC(D3D12_DEFAULT);
+
+                if (alphaBlend)
+                {
+                    D3D12_RENDER_TARGET_BLEND_DESC& blend = description.BlendState.RenderTarget[0];
+
+                    blend.BlendEnable = TRUE;
+                    blend.SrcBlend = D3D12_BLEND_SRC_ALPHA;
+                    blend.DestBlend = D3D12_BLEND_INV_SRC_ALPHA;
+                    blend.BlendOp = D3D12_BLEND_OP_ADD;
+                    blend.SrcBlendAlpha = D3D12_BLEND_ONE;
+                    blend.DestBlendAlpha = D3D12_BLEND_INV_SRC_ALPHA;
+                    blend.BlendOpAlpha = D3D12_BLEND_OP_ADD;
+                }
+
+                description.DepthStencilState = CD3DX12_DEPTH_STENCIL_DESC(D3D12_DEFAULT);
+                description.DepthStencilState.DepthEnable = depthTest;
+                description.DepthStencilState.DepthWriteMask = depthWrite ? D3D12_DEPTH_WRITE_MASK_ALL : D3D12_DEPTH_WRITE_MASK_ZERO;
+
+                description.NumRenderTargets = renderTargetFormat == DXGI_FORMAT_UNKNOWN ? 0 : 1;
+                description.RTVFormats[0] = renderTargetFormat;
+                description.DSVFormat = depthStencilFormat;
+            }
+
+            static PipelineStateVariant Wireframe()
+            {
+                PipelineStateVariant out;
+
+                out.fillMode = D3D12_FILL_MODE_WIREFRAME;
+                out.cullMode = D3D12_CULL_MODE_NONE;
+
+                return out;
+            }
+
+            static PipelineStateVariant AlphaBlend()
+            {
+                PipelineStateVariant out;
+
+                out.alphaBlend = true;
+                out.depthWrite = false;
+
+                return out;
+            }
+
+            static PipelineStateVariant NoDepth()
+            {
+                PipelineStateVariant out;
+
+                out.depthTest = false;
+                out.depthWrite = false;
+
+                return out;
+            }
+        };
+
+        struct CachedPipelineState
+        {
+            ComPtr<ID3D12PipelineState> pipelineState;
+
+            ullong hash = 0;
+
+            uint sortId = 0;
+        };
+
+        struct PipelineStateCacheStatistics
+        {
+            Size memoryHits = 0;
+            Size libraryHits = 0;
+            Size misses = 0;
+            Size libraryBytes = 0;
+
+            float creationTime = 0.0f;
+            float libraryLoadTime = 0.0f;
+        };
+
+        class PipelineStateCache
+        {
+
+        public:
+
+            void Initialize()
+            {
+                path = Settings::GetInstance()->Get<String>("pipelineLibraryPath");
+
+                if (Renderer::GetInstance()->IsHeadless() || path.empty())
+                    return;
+
+                ComPtr<ID3D12Device1> device;
+
+                if (FAILED(Renderer::GetInstance()->GetDevice().As(&device)))
+                    return;
+
+                libraryFile = MappedFile::Create(path);
+
+                HRESULT result = E_FAIL;
+
+                if (libraryFile->IsValid())
+                {
+                    result = device->CreatePipelineLibrary(libraryFile->GetData(), libraryFile->GetSize(), IID_PPV_ARGS(&library));
+
+                    if (FAILED(result))
+                        Logger_WriteConsole("Pipeline library '" + path + "' is stale or was written by another driver; rebuilding it", LogLevel::WARNING);
+                    else
+                        statistics.libraryBytes = libraryFile->GetSize();
+                }
+
+                if (FAILED(result))
+                {
+                    libraryFile.reset();
+
+                    result = device->CreatePipelineLibrary(nullptr, 0, IID_PPV_ARGS(&library));
+                }
+
+                if (FAILED(result))
+                {
+                    Logger_WriteConsole("Pipeline libraries are not supported on this device; pipeline states will not persist across runs", LogLevel::WARNING);
+
+                    library.Reset();
+                }
+            }
+
+            const CachedPipelineState* GetOrCreate(ullong rootSignatureHash, const PipelineStateVariant& variant, D3D12_GRAPHICS_PIPELINE_STATE_DESC description)
+            {
+                variant.Apply(description);
+
+                const ullong hash = HashDescription(rootSignatureHash, description);
+
+                {
+                    LockGuard<Mutex> lock(mutex);
+
+                    auto found = entries.find(hash);
+
+                    if (found != entries.end())
+                    {
+                        statistics.memoryHits++;
+
+                        return &found->second;
+                    }
+                }
+
+                CachedPipelineState created;
+
+                created.hash = hash;
+                created.sortId = SortKey::AllocateId();
+
+                const bool fromLibrary = CreatePipelineState(hash, description, created.pipelineState);
+
+                LockGuard<Mutex> lock(mutex);
+
+                auto [entry, inserted] = entries.emplace(hash, std::move(created));
+
+                if (!inserted)
+                    statistics.memoryHits++;
+                else if (fromLibrary)
+                    statistics.libraryHits++;
+                else
+                    statistics.misses++;
+
+                return &entry->second;
+            }
+
+            PipelineStateCacheStatistics GetStatistics()
+            {
+                LockGuard<Mutex> lock(mutex);
+
+                return statistics;
+            }
+
+            void LogStatistics()
+            {
+                const PipelineStateCacheStatistics out = GetStatistics();
+
+                Logger_WriteConsole("Pipeline state cache: " + std::to_string(out.memoryHits) + " memory hits, " + std::to_string(out.libraryHits) + " library hits in " + std::to_string(out.libraryLoadTime * 1000.0f) + " ms, " + std::to_string(out.misses) + " misses compiled in " + std::to_string(out.creationTime * 1000.0f) + " ms, " + std::to_string(out.libraryBytes / 1024) + " KiB library", LogLevel::INFORMATION);
+            }
+
+            void Save()
+            {
+                if (!library || !libraryDirty)
+                    return;
+
+                Vector<uchar> data(library->GetSerializedSize());
+
+                HRESULT result = library->Serialize(data.data(), data.size());
+
+                if (FAILED(result))
+                {
+                    Logger_ThrowError("FAILED", "Failed to serialize pipeline library", false);
+                    return;
+                }
+
+                library.Reset();
+                libraryFile.reset();
+
+                const Path parent = Path(path).parent_path();
+
+                if (!parent.empty())
+                    std::filesystem::create_directories(parent);
+
+                OutputFileStream stream(path, std::ios::binary | std::ios::trunc);
+
+                if (!stream.is_open())
+                {
+                    Logger_ThrowError("FAILED", "Failed to open pipeline library '" + path + "' for writing", false);
+                    return;
+                }
+
+                stream.write(reinterpret_cast<const char*>(data.data()), static_cast<StreamSize>(data.size()));
+
+                libraryDirty = false;
+            }
+
+            void CleanUp()
+            {
+                Save();
+
+                LockGuard<Mutex> lock(mutex);
+
+                entries.clear();
+
+                library.Reset();
+                libraryFile.reset();
+            }
+
+            static Shared<PipelineStateCache> GetInstance()
+            {
+                static Shared<PipelineStateCache> instance = std::make_shared<PipelineStateCache>();
+
+                return instance;
+            }
+
+        private:
+
+            static ullong HashDescription(ullong rootSignatureHash, const D3D12_GRAPHICS_PIPELINE_STATE_DESC& description)
+            {
+                ullong hash = Hash::Combine(Hash::Seed, rootSignatureHash);
+
+                for (const D3D12_SHADER_BYTECODE& bytecode : { description.VS, description.PS, description.GS, description.HS, description.DS })
+                {
+                    hash = Hash::Combine(hash, static_cast<ullong>(bytecode.BytecodeLength));
+                    hash = Hash::Combine(hash, bytecode.pShaderBytecode, bytecode.BytecodeLength);
+                }
+
+                for (UINT e = 0; e < description.InputLayout.NumElements; ++e)
+                {
+                    const D3D12_INPUT_ELEMENT_DESC& element = description.InputLayout.pInputElementDescs[e];
+
+                    hash = Hash::Combine(hash, String(element.SemanticName));
+                    hash = Hash::Combine(hash, element.SemanticIndex);
+                    hash = Hash::Combine(hash, element.Format);
+                    hash = Hash::Combine(hash, element.InputSlot);
+                    hash = Hash::Combine(hash, element.AlignedByteOffset);
+                    hash = Hash::Combine(hash, element.InputSlotClass);
+                    hash = Hash::Combine(hash, element.InstanceDataStepRate);
+                }
+
+                return HashFixedFunctionState(hash, description);
+            }
+
+            static ullong HashFixedFunctionState(ullong hash, const D3D12_GRAPHICS_PIPELINE_STATE_DESC& description)
+            {
+                const D3D12_BLEND_DESC& blend = description.BlendState;
+
+                hash = Hash::Combine(hash, blend.AlphaToCoverageEnable);
+                hash = Hash::Combine(hash, blend.IndependentBlendEnable);
+
+                for (UINT r = 0; r < (blend.IndependentBlendEnable ? 8u : 1u); ++r)
+                {
+                    const D3D12_RENDER_TARGET_BLEND_DESC& target = blend.RenderTarget[r];
+
+                    hash = Hash::Combine(hash, target.BlendEnable);
+                    hash = Hash::Combine(hash, target.LogicOpEnable);
+                    hash = Hash::Combine(hash, target.SrcBlend);
+                    hash = Hash::Combine(hash, target.DestBlend);
+                    hash = Hash::Combine(hash, target.BlendOp);
+                    hash = Hash::Combine(hash, target.SrcBlendAlpha);
+                    hash = Hash::Combine(hash, target.DestBlendAlpha);
+                    hash = Hash::Combine(hash, target.BlendOpAlpha);
+                    hash = Hash::Combine(hash, target.LogicOp);
+                    hash = Hash::Combine(hash, target.RenderTargetWriteMask);
+                }
+
+                const D3D12_DEPTH_STENCIL_DESC& depthStencil = description.DepthStencilState;
+
+                hash = Hash::Combine(hash, depthStencil.DepthEnable);
+                hash = Hash::Combine(hash, depthStencil.DepthWriteMask);
+                hash = Hash::Combine(hash, depthStencil.DepthFunc);
+                hash = Hash::Combine(hash, depthStencil.StencilEnable);
+                hash = Hash::Combine(hash, depthStencil.StencilReadMask);
+                hash = Hash::Combine(hash, depthStencil.StencilWriteMask);
+                hash = Hash::Combine(hash, depthStencil.FrontFace);
+                hash = Hash::Combine(hash, depthStencil.BackFace);
+
+                hash = Hash::Combine(hash, description.RasterizerState);
+                hash = Hash::Combine(hash, description.SampleMask);
+                hash = Hash::Combine(hash, description.IBStripCutValue);
+                hash = Hash::Combine(hash, description.PrimitiveTopologyType);
+                hash = Hash::Combine(hash, description.NumRenderTargets);
+
+                for (UINT r = 0; r < description.NumRenderTargets; ++r)
+                    hash = Hash::Combine(hash, description.RTVFormats[r]);
+
+                hash = Hash::Combine(hash, description.DSVFormat);
+                hash = Hash::Combine(hash, description.SampleDesc);
+
+                return hash;
+            }
+
+            bool CreatePipelineState(ullong hash, const D3D12_GRAPHICS_PIPELINE_STATE_DESC& description, ComPtr<ID3D12PipelineState>& out)
+            {
+                if (Renderer::GetInstance()->IsHeadless() || !description.VS.pShaderBytecode)
+                    return false;
+
+                const String name = Hash::ToString(hash);
+                const WString wideName(name.begin(), name.end());
+
+                const TimePoint start = Clock::now();
+
+                if (library)
+                {
+                    LockGuard<Mutex> lock(libraryMutex);
+
+                    if (SUCCEEDED(library->LoadGraphicsPipeline(wideName.c_str(), &description, IID_PPV_ARGS(&out))))
+                    {
+                        AddTime(statistics.libraryLoadTime, start);
+                        return true;
+                    }
+                }
+
+                HRESULT result = Renderer::GetInstance()->GetDevice()->CreateGraphicsPipelineState(&description, IID_PPV_ARGS(&out));
+
+                if (FAILED(result))
+                    Logger_ThrowError("FAILED", "Failed to create graphics pipeline state", true);
+
+                AddTime(statistics.creationTime, start);
+
+                if (library)
+                {
+                    LockGuard<Mutex> lock(libraryMutex);
+
+                    if (SUCCEEDED(library->StorePipeline(wideName.c_str(), out.Get())))
+                        libraryDirty = true;
+                }
+
+                return false;
+            }
+
+            void AddTime(float& total, const TimePoint& start)
+            {
+                const float elapsed = Duration(Clock::now() - start).count();
+
+                LockGuard<Mutex> lock(mutex);
+
+                total += elapsed;
+            }
+
+            String path;
+
+            ComPtr<ID3D12PipelineLibrary> library;
+            Shared<MappedFile> libraryFile;
+
+            bool libraryDirty = false;
+
+            UnorderedMap<ullong, CachedPipelineState> entries;
+
+            PipelineStateCacheStatistics statistics;
+
+            Mutex mutex;
+            Mutex libraryMutex;
+        };
+	}
+}
\ No newline at end of file
@@ -0,0 +1,884 @@
+#pragma once
+
+#include <d3d12.h>
+#include <d3dx12.h>
+#include "RenderStar/Core/Logger.hpp"
+#include "RenderStar/Render/CommandContext.hpp"
+#include "RenderStar/Render/DescriptorHeap.hpp"
+#include "RenderStar/Render/ResourceStateTracker.hpp"
+#include "RenderStar/Util/Typedefs.hpp"
+
+using namespace RenderStar::Core;
+using namespace RenderStar::Util;
+
+namespace RenderStar
+{
+	namespace Render
+	{
+        struct RenderGraphHandle
+        {
+            uint index = UINT_MAX;
+
+            bool IsValid() const
+            {
+                return index != UINT_MAX;
+            }
+        };
+
+        struct RenderGraphTextureDescription
+        {
+            uint width = 0;
+            uint height = 0;
+
+            DXGI_FORMAT format = DXGI_FORMAT_R8G8B8A8_UNORM;
+
+            Array<float, 4> clearColor = { 0.0f, 0.0f, 0.0f, 1.0f };
+        };
+
+        struct RenderGraphAccess
+        {
+            RenderGraphHandle texture;
+
+            D3D12_RESOURCE_STATES state = D3D12_RESOURCE_STATE_COMMON;
+
+            bool isWrite = false;
+        };
+
+        struct RenderGraphBarrier
+        {
+            RenderGraphHandle texture;
+            RenderGraphHandle aliasedTexture;
+
+            D3D12_RESOURCE_STATES before = D3D12_RESOURCE_STATE_COMMON;
+            D3D12_RESOURCE_STATES after = D3D12_RESOURCE_STATE_COMMON;
+
+            bool isAliasing = false;
+        };
+
+        struct RenderGraphStatistics
+        {
+            Size passCount = 0;
+            Size culledPassCount = 0;
+            Size transientTextureCount = 0;
+            Size transitionCount = 0;
+            Size aliasingBarrierCount = 0;
+            Size discardCount = 0;
+            Size unaliasedMemory = 0;
+            Size aliasedMemory = 0;
+
+            Size GetSavedMemory() const
+            {
+                return unaliasedMemory - aliasedMemory;
+            }
+        };
+
+        class RenderGraphBuilder
+        {
+
+        public:
+
+            RenderGraphBuilder(Vector<RenderGraphAccess>& accesses, bool& hasSideEffect, Size textureCount) : accesses(accesses), hasSideEffect(hasSideEffect), textureCount(textureCount) { }
+
+            void Read(RenderGraphHandle texture, D3D12_RESOURCE_STATES state = D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE | D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE)
+            {
+                Access(texture, state, false);
+            }
+
+            void Write(RenderGraphHandle texture, D3D12_RESOURCE_STATES state = D3D12_RESOURCE_STATE_RENDER_TARGET)
+            {
+                Access(texture, state, true);
+            }
+
+            void SetSideEffect()
+            {
+                hasSideEffect = true;
+            }
+
+        private:
+
+            void Access(RenderGraphHandle texture, D3D12_RESOURCE_STATES state, bool isWrite)
+            {
+                if (!texture.IsValid() || texture.index >= textureCount)
+                {
+                    Logger_ThrowError("FAILED", "Render graph pass accesses an unknown texture", false);
+                    return;
+                }
+
+                for (RenderGraphAccess& access : accesses)
+                {
+                    if (access.texture.index != texture.index)
+                        continue;
+
+                    if (isWrite)
+                    {
+                        access.state = state;
+                        access.isWrite = true;
+                    }
+                    else if (!access.isWrite)
+                        access.state |= state;
+
+                    return;
+                }
+
+                accesses.push_back({ texture, state, isWrite });
+            }
+
+            Vector<RenderGraphAccess>& accesses;
+
+            bool& hasSideEffect;
+
+            Size textureCount;
+        };
+
+        class RenderGraph
+        {
+
+        public:
+
+            void Initialize(ID3D12Device2* device, DescriptorHeap* descriptorHeap, ResourceStateRegistry* resourceStates)
+            {
+                this->device = device;
+                this->descriptorHeap = descriptorHeap;
+                this->resourceStates = resourceStates;
+
+                dirty = true;
+            }
+
+            RenderGraphHandle ImportTexture(const String& name, D3D12_RESOURCE_STATES state)
+            {
+                TextureEntry texture;
+
+                texture.name = name;
+                texture.isImported = true;
+                texture.initialState = state;
+
+                return AddTexture(std::move(texture));
+            }
+
+            RenderGraphHandle CreateTexture(const String& name, const RenderGraphTextureDescription& description)
+            {
+                TextureEntry texture;
+
+                texture.name = name;
+                texture.description = description;
+
+                return AddTexture(std::move(texture));
+            }
+
+            void BindTexture(RenderGraphHandle handle, ID3D12Resource* resource, D3D12_CPU_DESCRIPTOR_HANDLE renderTargetView = {}, D3D12_CPU_DESCRIPTOR_HANDLE depthStencilView = {})
+            {
+                TextureEntry& texture = textures[handle.index];
+
+                texture.external = resource;
+                texture.renderTargetView = renderTargetView;
+                texture.depthStencilView = depthStencilView;
+            }
+
+            RenderGraphHandle FindTexture(const String& name) const
+            {
+                for (Size t = 0; t < textures.size(); ++t)
+                {
+                    if (textures[t].name == name)
+                        return { static_cast<uint>(t) };
+                }
+
+                return {};
+            }
+
+            void AddPass(const String& name, const Function<void(RenderGraphBuilder&)>& setup, const Function<void(const RenderGraph&)>& execute)
+            {
+                Pass pass;
+
+                pass.name = name;
+                pass.execute = execute;
+
+                RenderGraphBuilder builder(pass.accesses, pass.hasSideEffect, textures.size());
+
+                setup(builder);
+
+                passes.push_back(std::move(pass));
+
+                dirty = true;
+            }
+
+            void SetOutputDimensions(const Vector2i& dimensions)
+            {
+                if (dimensions.x == outputDimensions.x && dimensions.y == outputDimensions.y)
+                    return;
+
+                outputDimensions = dimensions;
+
+                dirty = true;
+            }
+
+            bool IsDirty() const
+            {
+                return dirty;
+            }
+
+            void Compile()
+            {
+                ReleaseTransients();
+
+                statistics = {};
+                statistics.passCount = passes.size();
+
+                SortPasses();
+                CullPasses();
+                ComputeLifetimes();
+                PlaceTransients();
+                PlanBarriers();
+                CreateTransients();
+
+                dirty = false;
+            }
+
+            void Execute(Size scheduleIndex, CommandContext* context) const
+            {
+                const ScheduledPass& scheduled = schedule[scheduleIndex];
+                const Pass& pass = passes[scheduled.pass];
+
+                for (const RenderGraphBarrier& barrier : scheduled.barriers)
+                {
+                    if (barrier.isAliasing)
+                        context->AliasResource(GetTexture(barrier.aliasedTexture), GetTexture(barrier.texture));
+                }
+
+                for (const RenderGraphAccess& access : pass.accesses)
+                    context->TransitionResource(GetTexture(access.texture), access.state);
+
+                for (RenderGraphHandle discard : scheduled.discards)
+                    context->DiscardResource(GetTexture(discard));
+
+                pass.execute(*this);
+            }
+
+            Size GetScheduledPassCount() const
+            {
+                return schedule.size();
+            }
+
+            const String& GetScheduledPassName(Size scheduleIndex) const
+            {
+                return passes[schedule[scheduleIndex].pass].name;
+            }
+
+            Span<const RenderGraphBarrier> GetBarriers(Size scheduleIndex) const
+            {
+                return schedule[scheduleIndex].barriers;
+            }
+
+            ID3D12Resource* GetTexture(RenderGraphHandle handle) const
+            {
+                if (!handle.IsValid())
+                    return nullptr;
+
+                const TextureEntry& texture = textures[handle.index];
+
+                return texture.isImported ? texture.external : texture.resource.Get();
+            }
+
+            D3D12_CPU_DESCRIPTOR_HANDLE GetRenderTargetView(RenderGraphHandle handle) const
+            {
+                return textures[handle.index].renderTargetView;
+            }
+
+            D3D12_CPU_DESCRIPTOR_HANDLE GetDepthStencilView(RenderGraphHandle handle) const
+            {
+                return textures[handle.index].depthStencilView;
+            }
+
+            uint GetShaderResourceIndex(RenderGraphHandle handle) const
+            {
+                const TextureEntry& texture = textures[handle.index];
+
+                return texture.shaderResourceView ? static_cast<uint>(texture.shaderResourceView->index) : 0;
+            }
+
+            Vector2i GetDimensions(RenderGraphHandle handle) const
+            {
+                const RenderGraphTextureDescription& description = textures[handle.index].description;
+
+                return { static_cast<int>(description.width == 0 ? outputDimensions.x : description.width), static_cast<int>(description.height == 0 ? outputDimensions.y : description.height) };
+            }
+
+            Optional<Size> GetHeapOffset(RenderGraphHandle handle) const
+            {
+                const TextureEntry& texture = textures[handle.index];
+
+                if (texture.isImported || !texture.isLive)
+                    return std::nullopt;
+
+                return texture.offset;
+            }
+
+            const RenderGraphStatistics& GetStatistics() const
+            {
+                return statistics;
+            }
+
+            void LogStatistics() const
+            {
+                Logger_WriteConsole("Render graph: " + std::to_string(statistics.passCount - statistics.culledPassCount) + " / " + std::to_string(statistics.passCount) + " passes scheduled, " + std::to_string(statistics.culledPassCount) + " culled, " + std::to_string(statistics.transientTextureCount) + " transient textures in " + std::to_string(statistics.aliasedMemory / 1024) + " KiB (" + std::to_string(statistics.unaliasedMemory / 1024) + " KiB without aliasing, " + std::to_string(statistics.GetSavedMemory() / 1024) + " KiB saved), " + std::to_string(statistics.transitionCount) + " transitions, " + std::to_string(statistics.aliasingBarrierCount) + " aliasing barriers, " + std::to_string(statistics.discardCount) + " discards", LogLevel::INFORMATION);
+            }
+
+            void CleanUp()
+            {
+                ReleaseTransients();
+
+                schedule.clear();
+
+                dirty = true;
+            }
+
+        private:
+
+            static constexpr Size PlacementAlignment = D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT;
+            static constexpr Size HeapCategoryCount = 2;
+
+            struct TextureEntry
+            {
+                String name;
+
+                RenderGraphTextureDescription description;
+
+                bool isImported = false;
+                bool isLive = false;
+
+                D3D12_RESOURCE_STATES initialState = D3D12_RESOURCE_STATE_COMMON;
+                D3D12_RESOURCE_FLAGS flags = D3D12_RESOURCE_FLAG_NONE;
+
+                ID3D12Resource* external = nullptr;
+                ComPtr<ID3D12Resource> resource;
+
+                D3D12_CPU_DESCRIPTOR_HANDLE renderTargetView = {};
+                D3D12_CPU_DESCRIPTOR_HANDLE depthStencilView = {};
+
+                Optional<DescriptorAllocation> shaderResourceView;
+                Optional<Size> aliasedTexture;
+
+                Size first = 0;
+                Size last = 0;
+                Size size = 0;
+                Size alignment = PlacementAlignment;
+                Size offset = 0;
+                Size category = 0;
+            };
+
+            struct Pass
+            {
+                String name;
+
+                Vector<RenderGraphAccess> accesses;
+
+                Function<void(const RenderGraph&)> execute;
+
+                bool hasSideEffect = false;
+            };
+
+            struct ScheduledPass
+            {
+                Size pass = 0;
+
+                Vector<RenderGraphBarrier> barriers;
+                Vector<RenderGraphHandle> discards;
+            };
+
+            RenderGraphHandle AddTexture(TextureEntry texture)
+            {
+                if (FindTexture(texture.name).IsValid())
+                    Logger_ThrowError("FAILED", "Render graph texture '" + texture.name + "' is already declared", false);
+
+                textures.push_back(std::move(texture));
+
+                dirty = true;
+
+                return { static_cast<uint>(textures.size() - 1) };
+            }
+
+            void SortPasses()
+            {
+                Vector<Vector<Size>> edges(passes.size());
+                Vector<Size> incoming(passes.size(), 0);
+
+                Vector<Optional<Size>> lastWriters(textures.size());
+                Vector<Vector<Size>> lastReaders(textures.size());
+
+                const auto addEdge = [&edges, &incoming](Size from, Size to)
+                {
+                    if (from == to)
+                        return;
+
+                    edges[from].push_back(to);
+                    incoming[to]++;
+                };
+
+                for (Size p = 0; p < passes.size(); ++p)
+                {
+                    for (const RenderGraphAccess& access : passes[p].accesses)
+                    {
+                        const uint t = access.texture.index;
+
+                        if (lastWriters[t])
+                            addEdge(*lastWriters[t], p);
+
+                        if (!access.isWrite)
+                        {
+                            lastReaders[t].push_back(p);
+                            continue;
+                        }
+
+                        for (Size reader : lastReaders[t])
+                            addEdge(reader, p);
+
+                        lastWriters[t] = p;
+                        lastReaders[t].clear();
+                    }
+                }
+
+                Set<Size> ready;
+
+                for (Size p = 0; p < passes.size(); ++p)
+                {
+                    if (incoming[p] == 0)
+                        ready.insert(p);
+                }
+
+                order.clear();
+
+                while (!ready.empty())
+                {
+                    const Size p = *ready.begin();
+
+                    ready.erase(ready.begin());
+                    order.push_back(p);
+
+                    for (Size next : edges[p])
+                    {
+                        if (--incoming[next] == 0)
+                            ready.insert(next);
+                    }
+                }
+
+                if (order.size() != passes.size())
+                    Logger_ThrowError("FAILED", "Render graph contains a dependency cycle", true);
+            }
+
+            void CullPasses()
+            {
+                Vector<bool> needed(textures.size(), false);
+
+                schedule.clear();
+
+                for (auto p = order.rbegin(); p != order.rend(); ++p)
+                {
+                    const Pass& pass = passes[*p];
+
+                    bool live = pass.hasSideEffect;
+
+                    for (const RenderGraphAccess& access : pass.accesses)
+                        live = live || (access.isWrite && needed[access.texture.index]);
+
+                    if (!live)
+                    {
+                        statistics.culledPassCount++;
+                        continue;
+                    }
+
+                    for (const RenderGraphAccess& access : pass.accesses)
+                    {
+                        if (!access.isWrite)
+                            needed[access.texture.index] = true;
+                    }
+
+                    schedule.push_back({ *p, {} });
+                }
+
+                std::reverse(schedule.begin(), schedule.end());
+            }
+
+            void ComputeLifetimes()
+            {
+                for (TextureEntry& texture : textures)
+                {
+                    texture.isLive = false;
+                    texture.flags = D3D12_RESOURCE_FLAG_NONE;
+                    texture.aliasedTexture.reset();
+                }
+
+                for (Size s = 0; s < schedule.size(); ++s)
+                {
+                    for (const RenderGraphAccess& access : passes[schedule[s].pass].accesses)
+                    {
+                        TextureEntry& texture = textures[access.texture.index];
+
+                        if (texture.isImported)
+                            continue;
+
+                        if (!texture.isLive)
+                            texture.first = s;
+
+                        texture.isLive = true;
+                        texture.last = s;
+
+                        if (access.state & D3D12_RESOURCE_STATE_RENDER_TARGET)
+                            texture.flags |= D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET;
+
+                        if (access.state & (D3D12_RESOURCE_STATE_DEPTH_WRITE | D3D12_RESOURCE_STATE_DEPTH_READ))
+                            texture.flags |= D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL;
+
+                        if (access.state & D3D12_RESOURCE_STATE_UNORDERED_ACCESS)
+                            texture.flags |= D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS;
+
+                        texture.initialState = access.state;
+                    }
+                }
+
+                for (TextureEntry& texture : textures)
+                {
+                    if (!texture.isLive)
+                        continue;
+
+                    texture.category = (texture.flags & (D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET | D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL)) ? 0 : 1;
+
+                    if (device)
+                    {
+                        const D3D12_RESOURCE_DESC description = GetResourceDescription(texture);
+                        const D3D12_RESOURCE_ALLOCATION_INFO information = device->GetResourceAllocationInfo(0, 1, &description);
+
+                        texture.size = static_cast<Size>(information.SizeInBytes);
+                        texture.alignment = static_cast<Size>(information.Alignment);
+                    }
+                    else
+                    {
+                        const Vector2i dimensions = GetDimensions({ static_cast<uint>(&texture - textures.data()) });
+
+                        texture.size = AlignUp(static_cast<Size>(dimensions.x) * static_cast<Size>(dimensions.y) * GetBytesPerPixel(texture.description.format), PlacementAlignment);
+                        texture.alignment = PlacementAlignment;
+                    }
+
+                    statistics.transientTextureCount++;
+                    statistics.unaliasedMemory += texture.size;
+                }
+            }
+
+            void PlaceTransients()
+            {
+                Vector<Size> candidates;
+
+                for (Size t = 0; t < textures.size(); ++t)
+                {
+                    if (textures[t].isLive)
+                        candidates.push_back(t);
+                }
+
+                std::stable_sort(candidates.begin(), candidates.end(), [this](Size a, Size b) { return textures[a].size > textures[b].size; });
+
+                Vector<Size> placed;
+                Vector<Pair<Size, Size>> occupied;
+
+                heapSizes = {};
+
+                for (Size t : candidates)
+                {
+                    TextureEntry& texture = textures[t];
+
+                    occupied.clear();
+
+                    for (Size u : placed)
+                    {
+                        const TextureEntry& other = textures[u];
+
+                        if (other.category == texture.category && other.first <= texture.last && texture.first <= other.last)
+                            occupied.push_back({ other.offset, other.offset + other.size });
+                    }
+
+                    std::sort(occupied.begin(), occupied.end());
+
+                    Size offset = 0;
+
+                    for (const Pair<Size, Size>& range : occupied)
+                    {
+                        if (offset + texture.size <= range.first)
+                            break;
+
+                        offset = std::max(offset, AlignUp(range.second, texture.alignment));
+                    }
+
+                    texture.offset = offset;
+
+                    heapSizes[texture.category] = std::max(heapSizes[texture.category], offset + texture.size);
+
+                    placed.push_back(t);
+                }
+
+                for (Size t : placed)
+                {
+                    TextureEntry& texture = textures[t];
+
+                    Optional<Size> previous;
+                    Optional<Size> wrapped;
+
+                    for (Size u : placed)
+                    {
+                        const TextureEntry& other = textures[u];
+
+                        if (u == t || other.category != texture.category || other.offset >= texture.offset + texture.size || texture.offset >= other.offset + other.size)
+                            continue;
+
+                        if (other.last < texture.first)
+                        {
+                            if (!previous || textures[*previous].last < other.last)
+                                previous = u;
+                        }
+                        else if (!wrapped || textures[*wrapped].last < other.last)
+                            wrapped = u;
+                    }
+
+                    texture.aliasedTexture = previous ? previous : wrapped;
+                }
+
+                for (Size size : heapSizes)
+                    statistics.aliasedMemory += size;
+            }
+
+            void PlanBarriers()
+            {
+                Vector<D3D12_RESOURCE_STATES> states(textures.size());
+
+                for (Size t = 0; t < textures.size(); ++t)
+                    states[t] = textures[t].initialState;
+
+                for (Size s = 0; s < schedule.size(); ++s)
+                {
+                    ScheduledPass& scheduled = schedule[s];
+
+                    for (const RenderGraphAccess& access : passes[scheduled.pass].accesses)
+                    {
+                        const TextureEntry& texture = textures[access.texture.index];
+
+                        if (!texture.isImported && texture.first == s && texture.aliasedTexture)
+                        {
+                            scheduled.barriers.push_back({ access.texture, { static_cast<uint>(*texture.aliasedTexture) }, D3D12_RESOURCE_STATE_COMMON, D3D12_RESOURCE_STATE_COMMON, true });
+                            statistics.aliasingBarrierCount++;
+                        }
+
+                        if (!texture.isImported && texture.first == s && access.isWrite && IsDiscardable(access.state))
+                        {
+                            scheduled.discards.push_back(access.texture);
+                            statistics.discardCount++;
+                        }
+
+                        D3D12_RESOURCE_STATES& state = states[access.texture.index];
+
+                        if (state == access.state)
+                            continue;
+
+                        scheduled.barriers.push_back({ access.texture, {}, state, access.state, false });
+                        statistics.transitionCount++;
+
+                        state = access.state;
+                    }
+                }
+            }
+
+            static bool IsDiscardable(D3D12_RESOURCE_STATES state)
+            {
+                return state == D3D12_RESOURCE_STATE_RENDER_TARGET || state == D3D12_RESOURCE_STATE_DEPTH_WRITE || state == D3D12_RESOURCE_STATE_UNORDERED_ACCESS;
+            }
+
+            void CreateTransients()
+            {
+                if (!device || statistics.transientTextureCount == 0)
+                    return;
+
+                for (Size c = 0; c < HeapCategoryCount; ++c)
+                {
+                    if (heapSizes[c] == 0)
+                        continue;
+
+                    D3D12_HEAP_DESC heapDescription = {};
+
+                    heapDescription.SizeInBytes = heapSizes[c];
+                    heapDescription.Properties.Type = D3D12_HEAP_TYPE_DEFAULT;
+                    heapDescription.Alignment = PlacementAlignment;
+                    heapDescription.Flags = c == 0 ? D3D12_HEAP_FLAG_ALLOW_ONLY_RT_DS_TEXTURES : D3D12_HEAP_FLAG_ALLOW_ONLY_NON_RT_DS_TEXTURES;
+
+                    HRESULT result = device->CreateHeap(&heapDescription, IID_PPV_ARGS(&heaps[c]));
+
+                    if (FAILED(result))
+                        Logger_ThrowError("FAILED", "Failed to create render graph heap", true);
+                }
+
+                CreateViewHeap(D3D12_DESCRIPTOR_HEAP_TYPE_RTV, D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET, renderTargetViewHeap);
+                CreateViewHeap(D3D12_DESCRIPTOR_HEAP_TYPE_DSV, D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL, depthStencilViewHeap);
+
+                const UINT renderTargetViewSize = device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_RTV);
+                const UINT depthStencilViewSize = device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_DSV);
+
+                Size renderTargetCount = 0;
+                Size depthStencilCount = 0;
+
+                for (TextureEntry& texture : textures)
+                {
+                    if (!texture.isLive)
+                        continue;
+
+                    const D3D12_RESOURCE_DESC description = GetResourceDescription(texture);
+
+                    D3D12_CLEAR_VALUE clearValue = {};
+
+                    clearValue.Format = texture.description.format;
+
+                    const bool isDepthStencil = texture.flags & D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL;
+                    const bool isRenderTarget = texture.flags & D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET;
+
+                    if (isDepthStencil)
+                        clearValue.DepthStencil.Depth = 1.0f;
+                    else
+                        std::copy(texture.description.clearColor.begin(), texture.description.clearColor.end(), clearValue.Color);
+
+                    HRESULT result = device->CreatePlacedResource(heaps[texture.category].Get(), texture.offset, &description, texture.initialState, isDepthStencil || isRenderTarget ? &clearValue : nullptr, IID_PPV_ARGS(&texture.resource));
+
+                    if (FAILED(result))
+                        Logger_ThrowError("FAILED", "Failed to create render graph texture '" + texture.name + "'", true);
+
+                    if (resourceStates)
+                        resourceStates->Register(texture.resource.Get(), texture.initialState);
+
+                    if (isRenderTarget)
+                    {
+                        texture.renderTargetView = { renderTargetViewHeap->GetCPUDescriptorHandleForHeapStart().ptr + renderTargetCount++ * renderTargetViewSize };
+                        device->CreateRenderTargetView(texture.resource.Get(), nullptr, texture.renderTargetView);
+                    }
+
+                    if (isDepthStencil)
+                    {
+                        texture.depthStencilView = { depthStencilViewHeap->GetCPUDescriptorHandleForHeapStart().ptr + depthStencilCount++ * depthStencilViewSize };
+                        device->CreateDepthStencilView(texture.resource.Get(), nullptr, texture.depthStencilView);
+                    }
+                    else if (descriptorHeap)
+                    {
+                        texture.shaderResourceView = descriptorHeap->AllocatePersistent();
+
+                        D3D12_SHADER_RESOURCE_VIEW_DESC shaderResourceViewDescription = {};
+
+                        shaderResourceViewDescription.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+                        shaderResourceViewDescription.Format = texture.description.format;
+                        shaderResourceViewDescription.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
+                        shaderResourceViewDescription.Texture2D.MipLevels = 1;
+
+                        device->CreateShaderResourceView(texture.resource.Get(), &shaderResourceViewDescription, descriptorHeap->GetCpuHandle(texture.shaderResourceView->index));
+                    }
+                }
+            }
+
+            void CreateViewHeap(D3D12_DESCRIPTOR_HEAP_TYPE type, D3D12_RESOURCE_FLAGS flag, ComPtr<ID3D12DescriptorHeap>& heap)
+            {
+                UINT count = 0;
+
+                for (const TextureEntry& texture : textures)
+                {
+                    if (texture.isLive && (texture.flags & flag))
+                        count++;
+                }
+
+                if (count == 0)
+                    return;
+
+                D3D12_DESCRIPTOR_HEAP_DESC heapDescription = {};
+
+                heapDescription.NumDescriptors = count;
+                heapDescription.Type = type;
+                heapDescription.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_NONE;
+
+                HRESULT result = device->CreateDescriptorHeap(&heapDescription, IID_PPV_ARGS(&heap));
+
+                if (FAILED(result))
+                    Logger_ThrowError("FAILED", "Failed to create render graph descriptor heap", true);
+            }
+
+            void ReleaseTransients()
+            {
+                for (TextureEntry& texture : textures)
+                {
+                    if (texture.isImported)
+                        continue;
+
+                    if (resourceStates && texture.resource)
+                        resourceStates->Unregister(texture.resource.Get());
+
+                    if (descriptorHeap && texture.shaderResourceView)
+                        descriptorHeap->FreePersistent(*texture.shaderResourceView);
+
+                    texture.resource.Reset();
+                    texture.shaderResourceView.reset();
+                    texture.renderTargetView = {};
+                    texture.depthStencilView = {};
+                }
+
+                for (ComPtr<ID3D12Heap>& heap : heaps)
+                    heap.Reset();
+
+                renderTargetViewHeap.Reset();
+                depthStencilViewHeap.Reset();
+            }
+
+            D3D12_RESOURCE_DESC GetResourceDescription(const TextureEntry& texture) const
+            {
+                const Vector2i dimensions = GetDimensions({ static_cast<uint>(&texture - textures.data()) });
+
+                return CD3DX12_RESOURCE_DESC::Tex2D(texture.description.format, static_cast<UINT64>(dimensions.x), static_cast<UINT>(dimensions.y), 1, 1, 1, 0, texture.flags);
+            }
+
+            static Size AlignUp(Size value, Size alignment)
+            {
+                return (value + alignment - 1) / alignment * alignment;
+            }
+
+            static Size GetBytesPerPixel(DXGI_FORMAT format)
+            {
+                switch (format)
+                {
+
+                case DXGI_FORMAT_R32G32B32A32_FLOAT:
+                    return 16;
+
+                case DXGI_FORMAT_R16G16B16A16_FLOAT:
+                case DXGI_FORMAT_R32G32_FLOAT:
+                    return 8;
+
+                case DXGI_FORMAT_R16_FLOAT:
+                    return 2;
+
+                case DXGI_FORMAT_R8_UNORM:
+                    return 1;
+
+                default:
+                    return 4;
+                }
+            }
+
+            ID3D12Device2* device = nullptr;
+            DescriptorHeap* descriptorHeap = nullptr;
+            ResourceStateRegistry* resourceStates = nullptr;
+
+            Vector<TextureEntry> textures;
+            Vector<Pass> passes;
+            Vector<Size> order;
+            Vector<ScheduledPass> schedule;
+
+            Array<ComPtr<ID3D12Heap>, HeapCategoryCount> heaps;
+            Array<Size, HeapCategoryCount> heapSizes = {};
+
+            ComPtr<ID3D12DescriptorHeap> renderTargetViewHeap;
+            ComPtr<ID3D12DescriptorHeap> depthStencilViewHeap;
+
+            Vector2i outputDimensions = { 0, 0 };
+
+            RenderGraphStatistics statistics;
+
+            bool dirty = true;
+        };
+	}
+}
\ No newline at end of file
@@ -0,0 +1,356 @@
+#pragma once
+
+#include "RenderStar/Core/Settings.hpp"
+#include "RenderStar/Render/ConstantBufferAllocator.hpp"
+#include "RenderStar/Render/GeometryBuffer.hpp"
+#include "RenderStar/Render/Renderer.hpp"
+#include "RenderStar/Render/Shader.hpp"
+#include "RenderStar/Render/SortKey.hpp"
+#include "RenderStar/Render/Texture.hpp"
+#include "RenderStar/Render/Vertex.hpp"
+#include "RenderStar/Util/Typedefs.hpp"
+
+using namespace RenderStar::Core;
+using namespace RenderStar::Util;
+
+namespace RenderStar
+{
+	namespace Render
+	{
+        struct RenderItem
+        {
+            ullong sortKey = 0;
+
+            Shader* shader = nullptr;
+            Texture* texture = nullptr;
+
+            ID3D12PipelineState* pipelineState = nullptr;
+            uint pipelineSortId = 0;
+
+            uint textureDescriptor = 0;
+            uint geometryId = 0;
+
+            UINT indexCount = 0;
+            UINT startIndex = 0;
+            INT baseVertex = 0;
+
+            D3D12_GPU_VIRTUAL_ADDRESS constantBuffer = 0;
+            UINT constantBufferSlot = 0;
+
+            Matrix4x4f world = {};
+        };
+
+        struct RenderQueueStatistics
+        {
+            Size itemCount = 0;
+            Size drawCount = 0;
+            Size largestInstanceGroup = 0;
+            Size rootSignatureChanges = 0;
+            Size pipelineChanges = 0;
+            Size materialChanges = 0;
+            Size geometryChanges = 0;
+            Size stateChangesAvoided = 0;
+
+            void Merge(const RenderQueueStatistics& other)
+            {
+                itemCount += other.itemCount;
+                drawCount += other.drawCount;
+                largestInstanceGroup = std::max(largestInstanceGroup, other.largestInstanceGroup);
+                rootSignatureChanges += other.rootSignatureChanges;
+                pipelineChanges += other.pipelineChanges;
+                materialChanges += other.materialChanges;
+                geometryChanges += other.geometryChanges;
+                stateChangesAvoided += other.stateChangesAvoided;
+            }
+        };
+
+        class RenderQueue
+        {
+
+        public:
+
+            void Submit(const RenderItem& item)
+            {
+                LockGuard<Mutex> lock(submissionMutex);
+
+                items.push_back(item);
+            }
+
+            void Submit(Span<const RenderItem> submitted)
+            {
+                LockGuard<Mutex> lock(submissionMutex);
+
+                items.insert(items.end(), submitted.begin(), submitted.end());
+            }
+
+            void Flush()
+            {
+                statistics = {};
+
+                const Size count = items.size();
+
+                if (count == 0)
+                    return;
+
+                entries.resize(count);
+
+                for (Size i = 0; i < count; ++i)
+                    entries[i] = { items[i].sortKey, static_cast<uint>(i) };
+
+                RadixSort(entries, scratchEntries);
+
+                instancing = Settings::GetInstance()->Get<bool>("automaticInstancing");
+
+                ReserveInstances(count);
+
+                if (Settings::GetInstance()->Get<bool>("parallelRender"))
+                    Renderer::GetInstance()->RecordParallel(count, std::max<Size>(1, Settings::GetInstance()->Get<uint>("parallelRenderBatchSize")), [this](Size begin, Size end) { Dispatch(begin, end); });
+                else
+                    Dispatch(0, count);
+
+                items.clear();
+
+                const uint logInterval = Settings::GetInstance()->Get<uint>("frameTimingLogInterval");
+                const ullong frameNumber = Renderer::GetInstance()->GetFrameStatistics().frameNumber;
+
+                if (logInterval > 0 && frameNumber % logInterval == 0)
+                    Logger_WriteConsole("Render queue: " + std::to_string(statistics.itemCount) + " items, " + std::to_string(statistics.drawCount) + " draws after instancing, largest group " + std::to_string(statistics.largestInstanceGroup) + ", " + std::to_string(statistics.stateChangesAvoided) + " state changes avoided", LogLevel::INFORMATION);
+            }
+
+            void CleanUp()
+            {
+                for (InstanceBuffer& buffer : instanceBuffers)
+                    Renderer::GetInstance()->ReleaseDeferred(std::move(buffer.resource));
+
+                instanceBuffers.clear();
+            }
+
+            void SetViewMatrix(const Matrix4f& viewMatrix)
+            {
+                this->viewMatrix = viewMatrix;
+            }
+
+            const Matrix4f& GetViewMatrix() const
+            {
+                return viewMatrix;
+            }
+
+            const RenderQueueStatistics& GetStatistics() const
+            {
+                return statistics;
+            }
+
+            static Shared<RenderQueue> GetInstance()
+            {
+                static Shared<RenderQueue> instance = std::make_shared<RenderQueue>();
+
+                return instance;
+            }
+
+        private:
+
+            struct SortEntry
+            {
+                ullong key;
+                uint item;
+            };
+
+            struct InstanceBuffer
+            {
+                ComPtr<ID3D12Resource> resource;
+
+                InstanceData* data = nullptr;
+
+                Size capacity = 0;
+            };
+
+            static constexpr Size StateGroupCount = 6;
+            static constexpr Size MinimumInstanceCapacity = 1024;
+
+            void ReserveInstances(Size count)
+            {
+                if (Renderer::GetInstance()->IsHeadless())
+                {
+                    if (headlessInstances.size() < count)
+                        headlessInstances.resize(std::max(count, headlessInstances.size() * 2));
+
+                    instances = headlessInstances.data();
+                    instanceBufferView = { 0, static_cast<UINT>(count * sizeof(InstanceData)), sizeof(InstanceData) };
+
+                    return;
+                }
+
+                const UINT frameIndex = Renderer::GetInstance()->GetFrameIndex();
+
+                if (instanceBuffers.size() < Renderer::GetInstance()->GetFrameCount())
+                    instanceBuffers.resize(Renderer::GetInstance()->GetFrameCount());
+
+                InstanceBuffer& buffer = instanceBuffers[frameIndex];
+
+                if (buffer.capacity < count)
+                {
+                    Renderer::GetInstance()->ReleaseDeferred(std::move(buffer.resource));
+
+                    buffer.capacity = std::max({ count, buffer.capacity * 2, MinimumInstanceCapacity });
+
+                    CD3DX12_HEAP_PROPERTIES heapProperties(D3D12_HEAP_TYPE_UPLOAD);
+                    CD3DX12_RESOURCE_DESC bufferDescription = CD3DX12_RESOURCE_DESC::Buffer(buffer.capacity * sizeof(InstanceData));
+
+                    HRESULT result = Renderer::GetInstance()->GetDevice()->CreateCommittedResource(&heapProperties, D3D12_HEAP_FLAG_NONE, &bufferDescription, D3D12_RESOURCE_STATE_GENERIC_READ, nullptr, IID_PPV_ARGS(&buffer.resource));
+
+                    if (FAILED(result))
+                        Logger_ThrowError("FAILED", "Failed to create instance buffer", true);
+
+                    CD3DX12_RANGE readRange(0, 0);
+                    buffer.resource->Map(0, &readRange, reinterpret_cast<void**>(&buffer.data));
+                }
+
+                instances = buffer.data;
+                instanceBufferView = { buffer.resource->GetGPUVirtualAddress(), static_cast<UINT>(count * sizeof(InstanceData)), sizeof(InstanceData) };
+            }
+
+            bool CanInstance(const RenderItem& first, const RenderItem& item) const
+            {
+                return instancing && item.pipelineSortId == first.pipelineSortId && (item.texture == first.texture || item.shader->IsBindless()) && item.geometryId == first.geometryId && item.indexCount == first.indexCount && item.constantBuffer == first.constantBuffer;
+            }
+
+            void Dispatch(Size begin, Size end)
+            {
+                CommandContext* context = Renderer::GetInstance()->GetCommandContext();
+
+                RenderQueueStatistics local;
+
+                const RenderItem* current = nullptr;
+
+                for (Size e = begin; e < end;)
+                {
+                    const RenderItem& item = items[entries[e].item];
+
+                    Size groupEnd = e;
+
+                    for (; groupEnd < end && (groupEnd == e || CanInstance(item, items[entries[groupEnd].item])); ++groupEnd)
+                    {
+                        const RenderItem& instance = items[entries[groupEnd].item];
+
+                        instances[groupEnd].world = instance.world;
+                        instances[groupEnd].textureIndex = instance.textureDescriptor;
+
+                        if (groupEnd == e || instance.texture != items[entries[groupEnd - 1].item].texture)
+                            instance.texture->Bind();
+                    }
+
+                    const bool rootSignatureChanged = !current || item.shader->GetRootSignatureSortId() != current->shader->GetRootSignatureSortId();
+                    const bool pipelineChanged = !current || item.pipelineSortId != current->pipelineSortId;
+                    const bool materialChanged = rootSignatureChanged || pipelineChanged || (!item.shader->IsBindless() && item.texture != current->texture);
+
+                    if (rootSignatureChanged)
+                    {
+                        item.shader->BindRootSignature(context);
+                        ++local.rootSignatureChanges;
+                    }
+
+                    if (pipelineChanged)
+                    {
+                        if (item.pipelineState)
+                            context->SetPipelineState(item.pipelineState);
+
+                        ++local.pipelineChanges;
+                    }
+
+                    if (materialChanged)
+                    {
+                        item.shader->BindDescriptors(context, item.textureDescriptor);
+                        ++local.materialChanges;
+                    }
+
+                    if (item.constantBuffer && (rootSignatureChanged || item.constantBuffer != current->constantBuffer))
+                        context->SetRootConstantBufferView(item.constantBufferSlot, item.constantBuffer);
+
+                    if (!current)
+                    {
+                        context->SetVertexBuffer(0, GeometryBuffer::GetInstance()->GetVertexBufferView());
+                        context->SetIndexBuffer(GeometryBuffer::GetInstance()->GetIndexBufferView());
+                        context->SetVertexBuffer(1, instanceBufferView);
+                        context->SetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+                    }
+
+                    const Size instanceCount = groupEnd - e;
+
+                    context->DrawIndexed(item.indexCount, static_cast<UINT>(instanceCount), item.startIndex, item.baseVertex, static_cast<UINT>(e));
+
+                    const Size emittedGroups = rootSignatureChanged + pipelineChanged + materialChanged + (current ? 0 : 3);
+
+                    local.stateChangesAvoided += StateGroupCount - emittedGroups;
+                    local.itemCount += instanceCount;
+                    local.largestInstanceGroup = std::max(local.largestInstanceGroup, instanceCount);
+                    ++local.drawCount;
+
+                    if (!current || item.geometryId != current->geometryId)
+                        ++local.geometryChanges;
+
+                    current = &item;
+                    e = groupEnd;
+                }
+
+                LockGuard<Mutex> lock(statisticsMutex);
+
+                statistics.Merge(local);
+            }
+
+            static void RadixSort(Vector<SortEntry>& sorted, Vector<SortEntry>& scratch)
+            {
+                Array<Array<Size, 256>, 8> histograms = {};
+
+                for (const SortEntry& entry : sorted)
+                {
+                    for (Size d = 0; d < 8; ++d)
+                        ++histograms[d][(entry.key >> (d * 8)) & 0xFF];
+                }
+
+                scratch.resize(sorted.size());
+
+                for (Size d = 0; d < 8; ++d)
+                {
+                    Array<Size, 256>& histogram = histograms[d];
+
+                    if (histogram[(sorted[0].key >> (d * 8)) & 0xFF] == sorted.size())
+                        continue;
+
+                    Size offset = 0;
+
+                    for (Size& bucket : histogram)
+                    {
+                        const Size bucketSize = bucket;
+
+                        bucket = offset;
+                        offset += bucketSize;
+                    }
+
+                    for (const SortEntry& entry : sorted)
+                        scratch[histogram[(entry.key >> (d * 8)) & 0xFF]++] = entry;
+
+                    sorted.swap(scratch);
+                }
+            }
+
+            Vector<RenderItem> items;
+            Vector<SortEntry> entries;
+            Vector<SortEntry> scratchEntries;
+
+            Vector<InstanceBuffer> instanceBuffers;
+            Vector<InstanceData> headlessInstances;
+
+            InstanceData* instances = nullptr;
+            D3D12_VERTEX_BUFFER_VIEW instanceBufferView = {};
+
+            Matrix4f viewMatrix = DirectX::XMMatrixIdentity();
+
+            bool instancing = true;
+
+            RenderQueueStatistics statistics;
+
+            Mutex submissionMutex;
+            Mutex statisticsMutex;
+        };
+	}
+}
\ No newline at end of file
@@ -3,8 +3,13 @@
 #include <d3d12.h>
 #include <dxgi1_6.h>
 #include <d3dx12.h>
+#include "RenderStar/Core/JobSystem.hpp"
 #include "RenderStar/Core/Settings.hpp"
 #include "RenderStar/Core/Window.hpp"
+#include "RenderStar/Render/CommandContext.hpp"
+#include "RenderStar/Render/DescriptorHeap.hpp"
+#include "RenderStar/Render/FramePacer.hpp"
+#include "RenderStar/Render/RenderGraph.hpp"
 
 using namespace RenderStar::Core;
 
@@ -12,6 +17,24 @@ namespace RenderStar
 {
 	namespace Render
 	{
+        struct FrameStatistics
+        {
+            ullong frameNumber = 0;
+
+            float frameTime = 0.0f;
+            float cpuWaitTime = 0.0f;
+            float averageFrameTime = 0.0f;
+            float averageCpuWaitTime = 0.0f;
+
+            ullong cpuWaitCount = 0;
+
+            uint commandListCount = 0;
+            uint descriptorHeapBindCount = 0;
+            uint barrierCount = 0;
+            uint barrierBatchCount = 0;
+            uint droppedBarrierCount = 0;
+        };
+
         class Renderer
         {
 
@@ -19,81 +42,135 @@ namespace RenderStar
 
             void Initialize()
             {
+                headless = Settings::GetInstance()->Get<bool>("headless");
+                frameCount = std::clamp<UINT>(Settings::GetInstance()->Get<uint>("framesInFlight"), 2, MaxFrameCount);
+
+                if (headless)
+                {
+                    framePacer.Initialize(frameCount);
+
+                    CreateDescriptorHeaps();
+                    CreateRenderGraph();
+
+                    isInitialized = true;
+
+                    Logger_WriteConsole("Renderer initialized without a device; frames are recorded into memory.", LogLevel::INFORMATION);
+                    return;
+                }
+
                 EnableDebugLayer();
                 CreateDevice();
                 CreateCommandQueue();
                 CreateSwapChain();
                 CreateRenderTargetView();
                 CreateDepthStencilView();
-                CreateCommandAllocatorsAndLists();
+                CreateDescriptorHeaps();
                 CreateFenceAndEvent();
+                CreateRenderGraph();
 
                 isInitialized = true;
             }
 
-            void OpenCommandList()
+            void Render()
             {
-                OpenCommandList(frameIndex);
-            }
+                if (renderGraph.IsDirty())
+                {
+                    WaitForGpu();
 
-            void OpenCommandList(UINT frameIndex)
-            {
-                HRESULT result = commandAllocators[frameIndex]->Reset();
-                if (FAILED(result))
-                    Logger_ThrowError("FAILED", "Failed to reset command allocator.", true);
+                    renderGraph.SetOutputDimensions(GetOutputDimensions());
+                    renderGraph.Compile();
+                }
 
-                result = commandLists[frameIndex]->Reset(commandAllocators[frameIndex].Get(), nullptr);
-                if (FAILED(result))
-                    Logger_ThrowError("FAILED", "Failed to reset command list.", true);
+                const UINT frameIndex = framePacer.GetFrameIndex();
 
-                CD3DX12_RESOURCE_BARRIER barrier = CD3DX12_RESOURCE_BARRIER::Transition(renderTargets[frameIndex].Get(), D3D12_RESOURCE_STATE_PRESENT, D3D12_RESOURCE_STATE_RENDER_TARGET);
-                commandLists[frameIndex]->ResourceBarrier(1, &barrier);
+                usedRecordingContexts = 0;
 
-                CreateViewportAndScissorRect();
-            }
+                cbvSrvUavDescriptorHeap.BeginFrame(frameIndex, frameStatistics.frameNumber);
+                samplerDescriptorHeap.BeginFrame(frameIndex, frameStatistics.frameNumber);
 
-            void CloseCommandList()
-			{
-				CloseCommandList(frameIndex);
-			}
+                serialRecording = recordingContexts[frameIndex][AcquireRecordingContexts(1)].get();
+                serialContext = BeginRecording(*serialRecording, &resourceStates);
 
-            void CloseCommandList(UINT frameIndex)
-            {
-                CD3DX12_RESOURCE_BARRIER barrier = CD3DX12_RESOURCE_BARRIER::Transition(renderTargets[frameIndex].Get(), D3D12_RESOURCE_STATE_RENDER_TARGET, D3D12_RESOURCE_STATE_PRESENT);
-                commandLists[frameIndex]->ResourceBarrier(1, &barrier);
+                renderGraph.BindTexture(backBuffer, renderTargets[frameIndex].Get(), GetRenderTargetViewHandle());
+                renderGraph.BindTexture(depthBuffer, depthStencilBuffer.Get(), {}, depthStencilViewHandle);
 
-                HRESULT result = commandLists[frameIndex]->Close();
-                if (FAILED(result))
-                    Logger_ThrowError("FAILED", "Failed to close command list.", true);
+                for (Size p = 0; p < renderGraph.GetScheduledPassCount(); ++p)
+                    renderGraph.Execute(p, GetCommandContext());
+
+                SubmitFrame();
+
+                if (!headless)
+                {
+                    HRESULT result = swapChain->Present(1, 0);
+                    if (FAILED(result))
+                        Logger_ThrowError("FAILED", "Failed to present swap chain.", true);
+                }
 
-                ID3D12CommandList* ppCommandLists[] = { commandLists[frameIndex].Get() };
-                commandQueue->ExecuteCommandLists(_countof(ppCommandLists), ppCommandLists);
+                MoveToNextFrame();
             }
 
-            void Render()
+            template<typename F>
+            void RecordParallel(Size count, Size batchSize, F&& record)
             {
-                OpenCommandList();
+                if (count == 0)
+                    return;
 
-                CD3DX12_CPU_DESCRIPTOR_HANDLE renderTargetViewHandle(renderTargetViewHeap->GetCPUDescriptorHandleForHeapStart(), frameIndex, renderTargetHeapDescriptorSize);
-                D3D12_CPU_DESCRIPTOR_HANDLE depthStencilViewHandle = depthStencilHeap->GetCPUDescriptorHandleForHeapStart();
+                batchSize = std::max<Size>(1, batchSize);
 
-                float clearColor[] = { 0.0f, 0.45f, 0.75f, 1.0f };
+                const Size maxBatchCount = std::min<Size>(MaxRecordingBatches, std::max<Size>(1, JobSystem::GetInstance()->GetWorkerCount()) * 2);
+                Size batchCount = std::min<Size>((count + batchSize - 1) / batchSize, maxBatchCount);
 
-                commandLists[frameIndex]->ClearRenderTargetView(renderTargetViewHandle, clearColor, 0, nullptr);
-                commandLists[frameIndex]->ClearDepthStencilView(depthStencilViewHandle, D3D12_CLEAR_FLAG_DEPTH, 1.0f, 0, 0, nullptr);
+                if (!serialContext || batchCount <= 1)
+                {
+                    record(Size(0), count);
+                    return;
+                }
 
-                commandLists[frameIndex]->OMSetRenderTargets(1, &renderTargetViewHandle, FALSE, &depthStencilViewHandle);
+                batchSize = (count + batchCount - 1) / batchCount;
+                batchCount = (count + batchSize - 1) / batchSize;
 
-                for (auto& renderFunction : renderFunctions)
-                    renderFunction();
+                EndRecording(*serialRecording);
+                submittedContexts.push_back(serialRecording);
 
-                CloseCommandList();
+                const Size first = AcquireRecordingContexts(batchCount + 1);
+                Vector<Unique<RecordingContext>>& contexts = recordingContexts[framePacer.GetFrameIndex()];
 
-                HRESULT result = swapChain->Present(1, 0);
-                if (FAILED(result))
-                    Logger_ThrowError("FAILED", "Failed to present swap chain.", true);
+                JobSystem::GetInstance()->ParallelFor(batchCount, 1, [&](Size begin, Size end)
+                {
+                    for (Size b = begin; b < end; ++b)
+                    {
+                        RecordingContext& context = *contexts[first + b];
+
+                        workerContext = BeginRecording(context);
+
+                        record(b * batchSize, std::min(count, (b + 1) * batchSize));
+
+                        EndRecording(context);
 
-                WaitForPreviousFrame();
+                        workerContext = nullptr;
+                    }
+                });
+
+                for (Size b = 0; b < batchCount; ++b)
+                    submittedContexts.push_back(contexts[first + b].get());
+
+                serialRecording = contexts[first + batchCount].get();
+                serialContext = BeginRecording(*serialRecording);
+            }
+
+            CommandContext* GetCommandContext() const
+            {
+                return workerContext ? workerContext : serialContext;
+            }
+
+            const RecordingCommandContext& GetFrameRecording() const
+            {
+                return frameRecording;
+            }
+
+            bool IsHeadless() const
+            {
+                return headless;
             }
 
             bool IsInitialized() const
@@ -103,10 +180,16 @@ namespace RenderStar
 
             void Resize(const Vector2i& dimensions)
             {
-                WaitForPreviousFrame();
+                if (headless)
+                    return;
+
+                WaitForGpu();
 
                 for (UINT f = 0; f < frameCount; f++)
+                {
+                    resourceStates.Unregister(renderTargets[f].Get());
                     renderTargets[f].Reset();
+                }
 
                 HRESULT result = swapChain->ResizeBuffers(frameCount, dimensions.x, dimensions.y, DXGI_FORMAT_R8G8B8A8_UNORM, 0);
 
@@ -115,7 +198,10 @@ namespace RenderStar
 
                 CreateRenderTargetView();
                 CreateDepthStencilView(); 
-                frameIndex = swapChain->GetCurrentBackBufferIndex();
+
+                renderGraph.SetOutputDimensions(dimensions);
+
+                framePacer.Reset(swapChain->GetCurrentBackBufferIndex());
             }
 
             void AddRenderFunction(const Function<void()>& function)
@@ -123,6 +209,21 @@ namespace RenderStar
 				renderFunctions.push_back(function);
 			}
 
+            RenderGraph& GetRenderGraph()
+            {
+                return renderGraph;
+            }
+
+            RenderGraphHandle GetBackBufferHandle() const
+            {
+                return backBuffer;
+            }
+
+            RenderGraphHandle GetDepthBufferHandle() const
+            {
+                return depthBuffer;
+            }
+
             ComPtr<ID3D12Device2> GetDevice() const
 			{
 				return device;
@@ -138,6 +239,21 @@ namespace RenderStar
 				return swapChain;
 			}
 
+            ResourceStateRegistry& GetResourceStates()
+            {
+                return resourceStates;
+            }
+
+            DescriptorHeap& GetDescriptorHeap()
+            {
+                return cbvSrvUavDescriptorHeap;
+            }
+
+            DescriptorHeap& GetSamplerHeap()
+            {
+                return samplerDescriptorHeap;
+            }
+
             ComPtr<ID3D12DescriptorHeap> GetRenderTargetViewHeap() const
             {
                 return renderTargetViewHeap;
@@ -145,7 +261,7 @@ namespace RenderStar
 
             ComPtr<ID3D12Resource> GetRenderTarget() const
 			{
-				return renderTargets[frameIndex];
+				return renderTargets[framePacer.GetFrameIndex()];
 			}
 
             ComPtr<ID3D12Resource> GetRenderTarget(UINT index) const
@@ -168,24 +284,11 @@ namespace RenderStar
 				return depthStencilViewHandle;
 			}
 
-            ComPtr<ID3D12CommandAllocator> GetCommandAllocator() const
-            {
-                return commandAllocators[frameIndex];
-            }
-
-            ComPtr<ID3D12CommandAllocator> GetCommandAllocator(UINT index) const
-            {
-				return commandAllocators[index];
-			}
-
             ComPtr<ID3D12GraphicsCommandList> GetCommandList() const
             {
-                return commandLists[frameIndex];
-            }
+                CommandContext* context = GetCommandContext();
 
-            ComPtr<ID3D12GraphicsCommandList> GetCommandList(UINT index) const
-            {
-                return commandLists[index];
+                return context ? context->GetCommandList() : nullptr;
             }
 
             ComPtr<ID3D12Fence> GetFence() const
@@ -205,33 +308,84 @@ namespace RenderStar
 
             UINT GetFrameIndex() const
 			{
-				return frameIndex;
+				return framePacer.GetFrameIndex();
 			}
 
-            void WaitForPreviousFrame()
+            UINT GetFrameCount() const
+            {
+                return frameCount;
+            }
+
+            UINT64 GetFenceValue() const
+            {
+                return framePacer.GetFenceValue();
+            }
+
+            const FrameStatistics& GetFrameStatistics() const
             {
-                const UINT64 currentFenceValue = fenceValue;
+                return frameStatistics;
+            }
+
+            void ReleaseDeferred(ComPtr<ID3D12Resource> resource)
+            {
+                if (resource)
+                    pendingReleases[framePacer.GetFrameIndex()].push_back(std::move(resource));
+            }
+
+            void WaitForGpu()
+            {
+                if (headless)
+                    return;
+
+                const UINT64 currentFenceValue = framePacer.GetFenceValue();
+
                 HRESULT result = commandQueue->Signal(fence.Get(), currentFenceValue);
                 if (FAILED(result))
                     Logger_ThrowError("FAILED", "Failed to signal fence.", true);
 
-                fenceValue++;
+                WaitForFenceValue(currentFenceValue);
+
+                framePacer.IncrementFenceValue();
+
+                for (UINT f = 0; f < frameCount; f++)
+                    pendingReleases[f].clear();
+            }
+
+            void MoveToNextFrame()
+            {
+                const UINT64 currentFenceValue = framePacer.GetFenceValue();
 
-                if (fence->GetCompletedValue() < currentFenceValue)
+                if (headless)
+                    completedHeadlessFenceValue = currentFenceValue;
+                else
                 {
-                    result = fence->SetEventOnCompletion(currentFenceValue, fenceEvent);
+                    HRESULT result = commandQueue->Signal(fence.Get(), currentFenceValue);
                     if (FAILED(result))
-                        Logger_ThrowError("FAILED", "Failed to set event on completion.", true);
-
-                    WaitForSingleObject(fenceEvent, INFINITE);
+                        Logger_ThrowError("FAILED", "Failed to signal fence.", true);
                 }
 
-                frameIndex = swapChain->GetCurrentBackBufferIndex();
+                const UINT nextFrameIndex = headless ? framePacer.GetNextFrameIndex() : swapChain->GetCurrentBackBufferIndex();
+
+                const float cpuWaitTime = framePacer.Advance(nextFrameIndex, [this] { return headless ? completedHeadlessFenceValue : fence->GetCompletedValue(); }, [this](UINT64 value) { WaitForFenceValue(value); });
+
+                pendingReleases[framePacer.GetFrameIndex()].clear();
+
+                frameStatistics.cpuWaitCount = framePacer.GetWaitCount();
+
+                RecordFrameTiming(cpuWaitTime, Clock::now());
             }
 
             void CleanUp()
             {
-                WaitForPreviousFrame();
+                if (headless)
+                    return;
+
+                WaitForGpu();
+
+                renderGraph.CleanUp();
+
+                cbvSrvUavDescriptorHeap.CleanUp();
+                samplerDescriptorHeap.CleanUp();
 
                 CloseHandle(fenceEvent);
             }
@@ -353,7 +507,6 @@ namespace RenderStar
                     Logger_ThrowError("FAILED", "Failed to create swap chain.", true);
 
                 swapChain.As(&this->swapChain);
-                frameIndex = this->swapChain->GetCurrentBackBufferIndex();
             }
 
             void CreateRenderTargetView()
@@ -381,6 +534,7 @@ namespace RenderStar
                         Logger_ThrowError("FAILED", "Failed to get swap chain buffer.", true);
 
                     device->CreateRenderTargetView(renderTargets[f].Get(), nullptr, renderTargetViewHandle);
+                    resourceStates.Register(renderTargets[f].Get(), D3D12_RESOURCE_STATE_PRESENT);
                     renderTargetViewHandle.Offset(1, renderTargetHeapDescriptorSize);
                 }
             }
@@ -417,39 +571,82 @@ namespace RenderStar
                 device->CreateDepthStencilView(depthStencilBuffer.Get(), nullptr, depthStencilViewHandle);
             }
 
-            void CreateCommandAllocatorsAndLists()
+            void CreateRenderGraph()
             {
-                for (UINT f = 0; f < frameCount; f++)
+                renderGraph.Initialize(device.Get(), &cbvSrvUavDescriptorHeap, &resourceStates);
+                renderGraph.SetOutputDimensions(GetOutputDimensions());
+
+                backBuffer = renderGraph.ImportTexture("BackBuffer", D3D12_RESOURCE_STATE_PRESENT);
+                depthBuffer = renderGraph.ImportTexture("DepthBuffer", D3D12_RESOURCE_STATE_DEPTH_WRITE);
+
+                renderGraph.AddPass("Scene", [this](RenderGraphBuilder& builder)
                 {
-                    HRESULT result = device->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_DIRECT, IID_PPV_ARGS(&commandAllocators[f]));
-                    if (FAILED(result))
-                        Logger_ThrowError("FAILED", "Failed to create command allocator.", true);
+                    builder.Write(backBuffer, D3D12_RESOURCE_STATE_RENDER_TARGET);
+                    builder.Write(depthBuffer, D3D12_RESOURCE_STATE_DEPTH_WRITE);
+                },
+                [this](const RenderGraph& graph)
+                {
+                    float clearColor[] = { 0.0f, 0.45f, 0.75f, 1.0f };
 
-                    result = device->CreateCommandList(0, D3D12_COMMAND_LIST_TYPE_DIRECT, commandAllocators[f].Get(), nullptr, IID_PPV_ARGS(&commandLists[f]));
-                    if (FAILED(result))
-                        Logger_ThrowError("FAILED", "Failed to create command list.", true);
+                    CommandContext* context = GetCommandContext();
 
-                    commandLists[f]->Close();
-                }
+                    context->SetRenderTargets(graph.GetRenderTargetView(backBuffer), graph.GetDepthStencilView(depthBuffer));
+                    context->ClearRenderTarget(graph.GetRenderTargetView(backBuffer), clearColor);
+                    context->ClearDepthStencil(graph.GetDepthStencilView(depthBuffer), 1.0f);
+
+                    for (auto& renderFunction : renderFunctions)
+                        renderFunction();
+                });
+
+                renderGraph.AddPass("Present", [this](RenderGraphBuilder& builder)
+                {
+                    builder.Read(backBuffer, D3D12_RESOURCE_STATE_PRESENT);
+                    builder.SetSideEffect();
+                },
+                [](const RenderGraph&) { });
             }
 
-            void CreateViewportAndScissorRect()
+            Vector2i GetOutputDimensions() const
             {
+                return headless ? Settings::GetInstance()->Get<Vector2i>("defaultWindowDimensions") : Window::GetInstance()->GetClientDimensions();
+            }
+
+            void CreateViewportAndScissorRect(CommandContext* context)
+            {
+                const Vector2i dimensions = GetOutputDimensions();
+
                 D3D12_VIEWPORT viewport = {};
 
-                viewport.Width = static_cast<float>(Window::GetInstance()->GetClientDimensions().x);
-                viewport.Height = static_cast<float>(Window::GetInstance()->GetClientDimensions().y);
+                viewport.Width = static_cast<float>(dimensions.x);
+                viewport.Height = static_cast<float>(dimensions.y);
                 viewport.MinDepth = 0.0f;
                 viewport.MaxDepth = 1.0f;
 
-                commandLists[frameIndex]->RSSetViewports(1, &viewport);
+                context->SetViewport(viewport);
 
                 D3D12_RECT scissorRect = {};
 
-                scissorRect.right = static_cast<LONG>(Window::GetInstance()->GetClientDimensions().x);
-                scissorRect.bottom = static_cast<LONG>(Window::GetInstance()->GetClientDimensions().y);
+                scissorRect.right = static_cast<LONG>(dimensions.x);
+                scissorRect.bottom = static_cast<LONG>(dimensions.y);
+
+                context->SetScissorRect(scissorRect);
+            }
+
+            D3D12_CPU_DESCRIPTOR_HANDLE GetRenderTargetViewHandle() const
+            {
+                if (headless)
+                    return {};
+
+                return CD3DX12_CPU_DESCRIPTOR_HANDLE(renderTargetViewHeap->GetCPUDescriptorHandleForHeapStart(), framePacer.GetFrameIndex(), renderTargetHeapDescriptorSize);
+            }
+
+            void CreateDescriptorHeaps()
+            {
+                const Size capacity = Settings::GetInstance()->Get<uint>("descriptorHeapSize");
+                const Size transientCapacity = std::min<Size>(Settings::GetInstance()->Get<uint>("transientDescriptorCount"), capacity / 2);
 
-                commandLists[frameIndex]->RSSetScissorRects(1, &scissorRect);
+                cbvSrvUavDescriptorHeap.Initialize(device.Get(), D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, capacity - transientCapacity, transientCapacity, frameCount);
+                samplerDescriptorHeap.Initialize(device.Get(), D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER, MaxSamplerDescriptors, 0, frameCount);
             }
 
             void CreateFenceAndEvent()
@@ -459,34 +656,267 @@ namespace RenderStar
                 if (FAILED(result))
                     Logger_ThrowError("FAILED", "Failed to create fence.", true);
 
-                fenceValue = 1;
+                framePacer.Initialize(frameCount, swapChain->GetCurrentBackBufferIndex());
+
                 fenceEvent = CreateEvent(nullptr, FALSE, FALSE, nullptr);
 
                 if (fenceEvent == nullptr)
                     Logger_ThrowError("FAILED", "Failed to create fence event.", true);
             }
 
-            static const UINT frameCount = 2;
+            struct RecordingContext
+            {
+                ComPtr<ID3D12CommandAllocator> commandAllocator;
+                ComPtr<ID3D12GraphicsCommandList> commandList;
+
+                D3D12CommandContext deviceContext;
+                RecordingCommandContext recordingContext;
+            };
+
+            Size AcquireRecordingContexts(Size count)
+            {
+                Vector<Unique<RecordingContext>>& contexts = recordingContexts[framePacer.GetFrameIndex()];
+
+                while (contexts.size() < usedRecordingContexts + count)
+                {
+                    Unique<RecordingContext> context = std::make_unique<RecordingContext>();
+
+                    if (!headless)
+                    {
+                        HRESULT result = device->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_DIRECT, IID_PPV_ARGS(&context->commandAllocator));
+                        if (FAILED(result))
+                            Logger_ThrowError("FAILED", "Failed to create command allocator.", true);
+
+                        result = device->CreateCommandList(0, D3D12_COMMAND_LIST_TYPE_DIRECT, context->commandAllocator.Get(), nullptr, IID_PPV_ARGS(&context->commandList));
+                        if (FAILED(result))
+                            Logger_ThrowError("FAILED", "Failed to create command list.", true);
+
+                        context->commandList->Close();
+                        context->deviceContext.SetCommandList(context->commandList.Get());
+                    }
+
+                    contexts.push_back(std::move(context));
+                }
+
+                const Size out = usedRecordingContexts;
+
+                usedRecordingContexts += count;
+
+                return out;
+            }
+
+            CommandContext* GetContext(RecordingContext& context)
+            {
+                if (headless)
+                    return &context.recordingContext;
+
+                return &context.deviceContext;
+            }
+
+            CommandContext* BeginRecording(RecordingContext& context, ResourceStateRegistry* registry = nullptr, bool setup = true)
+            {
+                CommandContext* out = &context.recordingContext;
+
+                if (headless)
+                    context.recordingContext.Reset(registry);
+                else
+                {
+                    context.deviceContext.Reset(registry);
+
+                    HRESULT result = context.commandAllocator->Reset();
+                    if (FAILED(result))
+                        Logger_ThrowError("FAILED", "Failed to reset command allocator.", true);
+
+                    result = context.commandList->Reset(context.commandAllocator.Get(), nullptr);
+                    if (FAILED(result))
+                        Logger_ThrowError("FAILED", "Failed to reset command list.", true);
+
+                    out = &context.deviceContext;
+                }
+
+                if (!setup)
+                    return out;
+
+                out->SetRenderTargets(GetRenderTargetViewHandle(), depthStencilViewHandle);
+                out->SetDescriptorHeaps(cbvSrvUavDescriptorHeap.Get(), samplerDescriptorHeap.Get());
+
+                CreateViewportAndScissorRect(out);
+
+                return out;
+            }
+
+            void EndRecording(RecordingContext& context)
+            {
+                GetContext(context)->FlushBarriers();
+
+                if (headless)
+                    return;
+
+                HRESULT result = context.commandList->Close();
+                if (FAILED(result))
+                    Logger_ThrowError("FAILED", "Failed to close command list.", true);
+            }
+
+            void SubmitFrame()
+            {
+                EndRecording(*serialRecording);
+                submittedContexts.push_back(serialRecording);
+
+                ResolveResourceStates();
+
+                if (headless)
+                {
+                    frameRecording.Reset();
+
+                    for (RecordingContext* context : submittedContexts)
+                        frameRecording.Append(context->recordingContext);
+                }
+                else
+                {
+                    for (RecordingContext* context : submittedContexts)
+                        submissionLists.push_back(context->commandList.Get());
+
+                    commandQueue->ExecuteCommandLists(static_cast<UINT>(submissionLists.size()), submissionLists.data());
+
+                    submissionLists.clear();
+                }
+
+                resourceStates.Decay();
+
+                frameStatistics.commandListCount = static_cast<uint>(submittedContexts.size());
+                frameStatistics.descriptorHeapBindCount = 0;
+
+                for (RecordingContext* context : submittedContexts)
+                    frameStatistics.descriptorHeapBindCount += static_cast<uint>(headless ? context->recordingContext.GetStatistics().descriptorHeapChanges : context->deviceContext.GetDescriptorHeapChanges());
+
+                submittedContexts.clear();
+
+                serialRecording = nullptr;
+                serialContext = nullptr;
+            }
+
+            void ResolveResourceStates()
+            {
+                ResourceStateStatistics statistics;
+
+                resolvedContexts.clear();
+
+                for (RecordingContext* context : submittedContexts)
+                {
+                    const ResourceStateTracker& tracker = GetContext(*context)->GetStateTracker();
+
+                    statistics.Merge(tracker.GetStatistics());
+
+                    resolveBarriers.clear();
+
+                    tracker.Resolve(resourceStates, resolveBarriers, statistics);
+
+                    if (!resolveBarriers.empty())
+                    {
+                        RecordingContext* preamble = recordingContexts[framePacer.GetFrameIndex()][AcquireRecordingContexts(1)].get();
+
+                        BeginRecording(*preamble, nullptr, false)->ResourceBarriers(resolveBarriers);
+                        EndRecording(*preamble);
+
+                        resolvedContexts.push_back(preamble);
+
+                        statistics.barrierCount += resolveBarriers.size();
+                        statistics.batchCount++;
+                    }
+
+                    resolvedContexts.push_back(context);
+                }
+
+                submittedContexts.swap(resolvedContexts);
+
+                frameStatistics.barrierCount = static_cast<uint>(statistics.barrierCount);
+                frameStatistics.barrierBatchCount = static_cast<uint>(statistics.batchCount);
+                frameStatistics.droppedBarrierCount = static_cast<uint>(statistics.droppedCount);
+            }
+
+            void WaitForFenceValue(UINT64 value)
+            {
+                if (fence->GetCompletedValue() >= value)
+                    return;
+
+                HRESULT result = fence->SetEventOnCompletion(value, fenceEvent);
+                if (FAILED(result))
+                    Logger_ThrowError("FAILED", "Failed to set event on completion.", true);
+
+                WaitForSingleObject(fenceEvent, INFINITE);
+            }
+
+            void RecordFrameTiming(float cpuWaitTime, const TimePoint& frameEnd)
+            {
+                const float frameTime = frameStatistics.frameNumber > 0 ? Duration(frameEnd - previousFrameEnd).count() : 0.0f;
+                const float smoothing = frameStatistics.frameNumber > 0 ? 0.05f : 1.0f;
+
+                previousFrameEnd = frameEnd;
+
+                frameStatistics.frameNumber++;
+                frameStatistics.frameTime = frameTime * 1000.0f;
+                frameStatistics.cpuWaitTime = cpuWaitTime * 1000.0f;
+                frameStatistics.averageFrameTime += (frameStatistics.frameTime - frameStatistics.averageFrameTime) * smoothing;
+                frameStatistics.averageCpuWaitTime += (frameStatistics.cpuWaitTime - frameStatistics.averageCpuWaitTime) * smoothing;
+
+                const uint logInterval = Settings::GetInstance()->Get<uint>("frameTimingLogInterval");
+
+                if (logInterval > 0 && frameStatistics.frameNumber % logInterval == 0)
+                    Logger_WriteConsole("Frame " + std::to_string(frameStatistics.frameNumber) + ": " + std::to_string(frameStatistics.averageFrameTime) + " ms frame, " + std::to_string(frameStatistics.averageCpuWaitTime) + " ms CPU wait, " + std::to_string(frameCount) + " frames in flight, " + std::to_string(frameStatistics.descriptorHeapBindCount) + " descriptor heap binds, " + std::to_string(frameStatistics.barrierCount) + " barriers in " + std::to_string(frameStatistics.barrierBatchCount) + " batches, " + std::to_string(frameStatistics.droppedBarrierCount) + " redundant transitions dropped", LogLevel::INFORMATION);
+            }
+
+            static constexpr UINT MaxFrameCount = FramePacer::MaxFrameCount;
+            static constexpr Size MaxRecordingBatches = 64;
+            static constexpr Size MaxSamplerDescriptors = 2048;
+
+            UINT frameCount = 2;
 
             ComPtr<ID3D12Device2> device;
             ComPtr<ID3D12CommandQueue> commandQueue;
             ComPtr<IDXGISwapChain4> swapChain;
             ComPtr<ID3D12DescriptorHeap> renderTargetViewHeap;
-            ComPtr<ID3D12Resource> renderTargets[frameCount];
-            ComPtr<ID3D12CommandAllocator> commandAllocators[frameCount];
-            ComPtr<ID3D12GraphicsCommandList> commandLists[frameCount];
+            ComPtr<ID3D12Resource> renderTargets[MaxFrameCount];
             ComPtr<ID3D12Fence> fence;
             HANDLE fenceEvent = nullptr;
             UINT renderTargetHeapDescriptorSize = 0;
-            UINT frameIndex = 0;
-            UINT64 fenceValue = 0;
+            FramePacer framePacer;
+            UINT64 completedHeadlessFenceValue = 0;
+            Vector<ComPtr<ID3D12Resource>> pendingReleases[MaxFrameCount];
+
+            Vector<Unique<RecordingContext>> recordingContexts[MaxFrameCount];
+            Size usedRecordingContexts = 0;
+
+            RecordingContext* serialRecording = nullptr;
+            CommandContext* serialContext = nullptr;
+
+            Vector<RecordingContext*> submittedContexts;
+            Vector<RecordingContext*> resolvedContexts;
+            Vector<D3D12_RESOURCE_BARRIER> resolveBarriers;
+
+            ResourceStateRegistry resourceStates;
+            Vector<ID3D12CommandList*> submissionLists;
+
+            RecordingCommandContext frameRecording;
+
+            inline static thread_local CommandContext* workerContext = nullptr;
+
+            FrameStatistics frameStatistics;
+            TimePoint previousFrameEnd;
+
+            DescriptorHeap cbvSrvUavDescriptorHeap;
+            DescriptorHeap samplerDescriptorHeap;
 
             ComPtr<ID3D12DescriptorHeap> depthStencilHeap;
             ComPtr<ID3D12Resource> depthStencilBuffer;
-            D3D12_CPU_DESCRIPTOR_HANDLE depthStencilViewHandle;
+            D3D12_CPU_DESCRIPTOR_HANDLE depthStencilViewHandle = {};
 
             Vector<Function<void()>> renderFunctions;
 
+            RenderGraph renderGraph;
+            RenderGraphHandle backBuffer;
+            RenderGraphHandle depthBuffer;
+
+            bool headless = false;
             bool resizing = false;
             bool isInitialized = false;
         };
@@ -0,0 +1,286 @@
+#pragma once
+
+#include <d3d12.h>
+#include "RenderStar/Util/Typedefs.hpp"
+
+using namespace RenderStar::Util;
+
+namespace RenderStar
+{
+	namespace Render
+	{
+        struct ResourceStateStatistics
+        {
+            Size transitionCount = 0;
+            Size barrierCount = 0;
+            Size batchCount = 0;
+            Size droppedCount = 0;
+            Size resolvedCount = 0;
+            Size promotedCount = 0;
+
+            void Merge(const ResourceStateStatistics& other)
+            {
+                transitionCount += other.transitionCount;
+                barrierCount += other.barrierCount;
+                batchCount += other.batchCount;
+                droppedCount += other.droppedCount;
+                resolvedCount += other.resolvedCount;
+                promotedCount += other.promotedCount;
+            }
+        };
+
+        class ResourceStateRegistry
+        {
+
+        public:
+
+            void Register(ID3D12Resource* resource, D3D12_RESOURCE_STATES state, bool isBuffer = false)
+            {
+                if (!resource)
+                    return;
+
+                LockGuard<Mutex> lock(mutex);
+
+                entries[resource] = { state, isBuffer };
+            }
+
+            void Unregister(ID3D12Resource* resource)
+            {
+                LockGuard<Mutex> lock(mutex);
+
+                entries.erase(resource);
+            }
+
+            D3D12_RESOURCE_STATES GetState(ID3D12Resource* resource)
+            {
+                LockGuard<Mutex> lock(mutex);
+
+                auto found = entries.find(resource);
+
+                return found == entries.end() ? D3D12_RESOURCE_STATE_COMMON : found->second.state;
+            }
+
+            bool Resolve(ID3D12Resource* resource, D3D12_RESOURCE_STATES state, D3D12_RESOURCE_BARRIER& barrier, ResourceStateStatistics& statistics)
+            {
+                LockGuard<Mutex> lock(mutex);
+
+                return ResolveLocked(resource, state, barrier, statistics);
+            }
+
+            void SetState(ID3D12Resource* resource, D3D12_RESOURCE_STATES state)
+            {
+                LockGuard<Mutex> lock(mutex);
+
+                auto found = entries.find(resource);
+
+                if (found != entries.end())
+                    found->second.state = state;
+            }
+
+            void Decay()
+            {
+                LockGuard<Mutex> lock(mutex);
+
+                for (auto& [resource, entry] : entries)
+                {
+                    if (entry.isBuffer)
+                        entry.state = D3D12_RESOURCE_STATE_COMMON;
+                }
+            }
+
+            static D3D12_RESOURCE_BARRIER CreateTransition(ID3D12Resource* resource, D3D12_RESOURCE_STATES before, D3D12_RESOURCE_STATES after)
+            {
+                D3D12_RESOURCE_BARRIER out = {};
+
+                out.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+                out.Transition.pResource = resource;
+                out.Transition.StateBefore = before;
+                out.Transition.StateAfter = after;
+                out.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
+
+                return out;
+            }
+
+        private:
+
+            struct Entry
+            {
+                D3D12_RESOURCE_STATES state;
+
+                bool isBuffer;
+            };
+
+            bool ResolveLocked(ID3D12Resource* resource, D3D12_RESOURCE_STATES state, D3D12_RESOURCE_BARRIER& barrier, ResourceStateStatistics& statistics)
+            {
+                auto found = entries.find(resource);
+
+                if (found == entries.end())
+                    found = entries.emplace(resource, Entry{ D3D12_RESOURCE_STATE_COMMON, false }).first;
+
+                Entry& entry = found->second;
+
+                if (entry.state == state)
+                {
+                    statistics.droppedCount++;
+                    return false;
+                }
+
+                if (entry.isBuffer && entry.state == D3D12_RESOURCE_STATE_COMMON)
+                {
+                    statistics.promotedCount++;
+                    entry.state = state;
+                    return false;
+                }
+
+                barrier = CreateTransition(resource, entry.state, state);
+
+                entry.state = state;
+
+                statistics.resolvedCount++;
+
+                return true;
+            }
+
+            UnorderedMap<ID3D12Resource*, Entry> entries;
+
+            Mutex mutex;
+        };
+
+        class ResourceStateTracker
+        {
+
+        public:
+
+            void Reset(ResourceStateRegistry* registry = nullptr)
+            {
+                eagerRegistry = registry;
+
+                finalStates.clear();
+                stateIndices.clear();
+                unresolvedTransitions.clear();
+                pendingBarriers.clear();
+
+                statistics = {};
+            }
+
+            void Transition(ID3D12Resource* resource, D3D12_RESOURCE_STATES state)
+            {
+                if (!resource)
+                    return;
+
+                statistics.transitionCount++;
+
+                auto index = stateIndices.find(resource);
+
+                if (index == stateIndices.end())
+                {
+                    stateIndices.emplace(resource, finalStates.size());
+                    finalStates.push_back({ resource, state });
+
+                    if (!eagerRegistry)
+                    {
+                        unresolvedTransitions.push_back({ resource, state });
+                        return;
+                    }
+
+                    D3D12_RESOURCE_BARRIER barrier;
+
+                    if (eagerRegistry->Resolve(resource, state, barrier, statistics))
+                        pendingBarriers.push_back(barrier);
+
+                    return;
+                }
+
+                Pair<ID3D12Resource*, D3D12_RESOURCE_STATES>& found = finalStates[index->second];
+
+                if (found.second == state)
+                {
+                    statistics.droppedCount++;
+                    return;
+                }
+
+                auto pending = std::find_if(pendingBarriers.begin(), pendingBarriers.end(), [resource](const D3D12_RESOURCE_BARRIER& barrier) { return barrier.Type == D3D12_RESOURCE_BARRIER_TYPE_TRANSITION && barrier.Transition.pResource == resource; });
+
+                if (pending == pendingBarriers.end())
+                    pendingBarriers.push_back(ResourceStateRegistry::CreateTransition(resource, found.second, state));
+                else if (pending->Transition.StateBefore == state)
+                {
+                    pendingBarriers.erase(pending);
+                    statistics.droppedCount += 2;
+                }
+                else
+                {
+                    pending->Transition.StateAfter = state;
+                    statistics.droppedCount++;
+                }
+
+                found.second = state;
+            }
+
+            void Alias(ID3D12Resource* before, ID3D12Resource* after)
+            {
+                if (!after)
+                    return;
+
+                D3D12_RESOURCE_BARRIER barrier = {};
+
+                barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_ALIASING;
+                barrier.Aliasing.pResourceBefore = before;
+                barrier.Aliasing.pResourceAfter = after;
+
+                pendingBarriers.push_back(barrier);
+            }
+
+            bool HasPendingBarriers() const
+            {
+                return !pendingBarriers.empty();
+            }
+
+            Span<const D3D12_RESOURCE_BARRIER> GetPendingBarriers() const
+            {
+                return pendingBarriers;
+            }
+
+            void ClearPendingBarriers()
+            {
+                if (pendingBarriers.empty())
+                    return;
+
+                statistics.barrierCount += pendingBarriers.size();
+                statistics.batchCount++;
+
+                pendingBarriers.clear();
+            }
+
+            void Resolve(ResourceStateRegistry& registry, Vector<D3D12_RESOURCE_BARRIER>& barriers, ResourceStateStatistics& resolveStatistics) const
+            {
+                for (const Pair<ID3D12Resource*, D3D12_RESOURCE_STATES>& transition : unresolvedTransitions)
+                {
+                    D3D12_RESOURCE_BARRIER barrier;
+
+                    if (registry.Resolve(transition.first, transition.second, barrier, resolveStatistics))
+                        barriers.push_back(barrier);
+                }
+
+                for (const Pair<ID3D12Resource*, D3D12_RESOURCE_STATES>& state : finalStates)
+                    registry.SetState(state.first, state.second);
+            }
+
+            const ResourceStateStatistics& GetStatistics() const
+            {
+                return statistics;
+            }
+
+        private:
+
+            ResourceStateRegistry* eagerRegistry = nullptr;
+
+            Vector<Pair<ID3D12Resource*, D3D12_RESOURCE_STATES>> finalStates;
+            UnorderedMap<ID3D12Resource*, Size> stateIndices;
+            Vector<Pair<ID3D12Resource*, D3D12_RESOURCE_STATES>> unresolvedTransitions;
+            Vector<D3D12_RESOURCE_BARRIER> pendingBarriers;
+
+            ResourceStateStatistics statistics;
+        };
+	}
+}
\ No newline at end of file
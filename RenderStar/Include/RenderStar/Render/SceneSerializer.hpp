@@ -0,0 +1,223 @@
+#pragma once
+
+#include "RenderStar/ECS/GameObjectManager.hpp"
+#include "RenderStar/Render/Mesh.hpp"
+#include "RenderStar/Render/ShaderManager.hpp"
+#include "RenderStar/Render/TextureManager.hpp"
+#include "RenderStar/Util/SceneFile.hpp"
+#include "RenderStar/Util/Typedefs.hpp"
+
+using namespace RenderStar::ECS;
+using namespace RenderStar::Util;
+
+namespace RenderStar
+{
+	namespace Render
+	{
+        class SceneSerializer
+        {
+
+        public:
+
+            static bool Save(const String& path)
+            {
+                Shared<GameObjectManager> manager = GameObjectManager::GetInstance();
+
+                SceneFileWriter writer;
+
+                UnorderedMap<Entity, uint> entityIndices;
+                Map<std::tuple<const MeshGeometry*, const Shader*, const Texture*>, uint> meshIndices;
+
+                Vector<GameObject*> stack;
+
+                for (GameObject* gameObject : manager->GetGameObjects())
+                {
+                    if (gameObject->GetParentEntity().IsNull())
+                        stack.push_back(gameObject);
+                }
+
+                std::reverse(stack.begin(), stack.end());
+
+                while (!stack.empty())
+                {
+                    GameObject* gameObject = stack.back();
+                    stack.pop_back();
+
+                    SceneEntity entity = {};
+
+                    entity.name = writer.AddString(gameObject->name);
+                    entity.parent = gameObject->GetParentEntity().IsNull() ? InvalidSceneIndex : entityIndices[gameObject->GetParentEntity()];
+                    entity.mesh = InvalidSceneIndex;
+                    entity.isActive = gameObject->isActive ? 1 : 0;
+                    entity.scale = { 1.0f, 1.0f, 1.0f };
+
+                    Transform* transform = gameObject->GetComponent<Transform>();
+
+                    if (transform)
+                    {
+                        DirectX::XMStoreFloat3(&entity.position, transform->GetLocalPosition());
+                        DirectX::XMStoreFloat3(&entity.rotation, transform->GetLocalRotation());
+                        DirectX::XMStoreFloat3(&entity.scale, transform->GetLocalScale());
+                    }
+
+                    Shared<Mesh> mesh = gameObject->GetComponent<Mesh>();
+                    Shared<Shader> shader = gameObject->GetComponent<Shader>();
+                    Shared<Texture> texture = gameObject->GetComponent<Texture>();
+
+                    if (mesh && mesh->GetGeometry() && shader && texture)
+                    {
+                        Shared<const MeshGeometry> geometry = mesh->GetGeometry();
+
+                        const auto key = std::make_tuple(geometry.get(), shader.get(), texture.get());
+
+                        auto iterator = meshIndices.find(key);
+
+                        if (iterator == meshIndices.end())
+                            iterator = meshIndices.emplace(key, writer.AddMesh(mesh->GetName(), shader->GetName(), texture->GetName(), geometry->GetVertices().data(), static_cast<uint>(geometry->GetVertices().size()), sizeof(Vertex), geometry->GetIndices().data(), static_cast<uint>(geometry->GetIndices().size()))).first;
+
+                        entity.mesh = iterator->second;
+                    }
+
+                    entityIndices[gameObject->GetEntity()] = writer.AddEntity(entity);
+
+                    const Vector<Entity>& children = gameObject->GetChildEntities();
+
+                    for (auto child = children.rbegin(); child != children.rend(); ++child)
+                    {
+                        GameObject* childObject = manager->Get(*child);
+
+                        if (childObject)
+                            stack.push_back(childObject);
+                    }
+                }
+
+                return writer.Write(path);
+            }
+
+            static bool Load(const String& path, bool generate = true)
+            {
+                Shared<SceneFile> file = SceneFile::Open(path);
+
+                if (!file)
+                    return false;
+
+                Shared<GameObjectManager> manager = GameObjectManager::GetInstance();
+
+                Span<const SceneEntity> entities = file->GetEntities();
+                Span<const SceneMesh> meshes = file->GetMeshes();
+
+                for (const SceneMesh& mesh : meshes)
+                {
+                    if (mesh.vertexStride != sizeof(Vertex))
+                    {
+                        Logger_ThrowError("FAILED", "Scene file '" + path + "' has an incompatible vertex layout", false);
+                        return false;
+                    }
+                }
+
+                Vector<Shared<Shader>> shaders(meshes.size());
+                Vector<Shared<Texture>> textures(meshes.size());
+                Vector<Shared<MeshGeometry>> geometries(meshes.size());
+                Vector<String> meshNames(meshes.size());
+
+                for (Size m = 0; m < meshes.size(); ++m)
+                {
+                    const Span<const Vertex> vertices = { file->GetData<Vertex>(meshes[m].vertexOffset), meshes[m].vertexCount };
+                    const Span<const uint> indices = { file->GetData<uint>(meshes[m].indexOffset), meshes[m].indexCount };
+
+                    shaders[m] = ShaderManager::GetInstance()->Get(file->GetString(meshes[m].shader));
+                    textures[m] = TextureManager::GetInstance()->Get(file->GetString(meshes[m].texture));
+                    geometries[m] = MeshGeometry::CreateView(file, vertices, indices);
+                    meshNames[m] = file->GetString(meshes[m].name);
+                }
+
+                manager->Reserve(manager->GetCount() + entities.size());
+                TransformSystem::GetInstance()->Reserve(TransformSystem::GetInstance()->GetCount() + entities.size());
+
+                auto HasMesh = [&](const SceneEntity& entity)
+                {
+                    return entity.mesh != InvalidSceneIndex && shaders[entity.mesh] && textures[entity.mesh];
+                };
+
+                Vector<GameObject*> gameObjects(entities.size());
+                Vector<Pair<TypeIndex, Unique<ComponentColumn>>> components;
+
+                for (Size begin = 0; begin < entities.size();)
+                {
+                    const bool hasMesh = HasMesh(entities[begin]);
+
+                    Size end = begin + 1;
+
+                    while (end < entities.size() && HasMesh(entities[end]) == hasMesh)
+                        end++;
+
+                    Vector<String> names;
+                    Vector<Transform> transforms;
+                    Vector<Shared<Shader>> runShaders;
+                    Vector<Shared<Texture>> runTextures;
+                    Vector<Shared<Mesh>> runMeshes;
+
+                    names.reserve(end - begin);
+                    transforms.reserve(end - begin);
+
+                    for (Size e = begin; e < end; ++e)
+                    {
+                        const SceneEntity& entity = entities[e];
+
+                        Transform transform = Transform::Create();
+
+                        transform.SetLocalPosition(entity.position);
+                        transform.SetLocalRotation(entity.rotation);
+                        transform.SetLocalScale(entity.scale);
+
+                        names.push_back(file->GetString(entity.name));
+                        transforms.push_back(std::move(transform));
+
+                        if (hasMesh)
+                        {
+                            runShaders.push_back(shaders[entity.mesh]);
+                            runTextures.push_back(textures[entity.mesh]);
+                            runMeshes.push_back(Mesh::Create(meshNames[entity.mesh], geometries[entity.mesh]));
+                        }
+                    }
+
+                    components.clear();
+                    components.push_back(GameObjectManager::CreateComponents(transforms));
+
+                    if (hasMesh)
+                    {
+                        components.push_back(GameObjectManager::CreateComponents(runShaders));
+                        components.push_back(GameObjectManager::CreateComponents(runTextures));
+                        components.push_back(GameObjectManager::CreateComponents(runMeshes));
+                    }
+
+                    const Vector<GameObject*> created = manager->Create(names, components);
+
+                    if (created.size() != end - begin)
+                        return false;
+
+                    for (Size e = begin; e < end; ++e)
+                    {
+                        const SceneEntity& entity = entities[e];
+                        GameObject* gameObject = created[e - begin];
+
+                        if (entity.parent != InvalidSceneIndex)
+                            gameObjects[entity.parent]->AddChild(gameObject);
+
+                        if (hasMesh && generate)
+                            gameObject->GetComponent<Mesh>()->Generate();
+
+                        gameObject->isActive = entity.isActive != 0;
+                        gameObjects[e] = gameObject;
+                    }
+
+                    begin = end;
+                }
+
+                Logger_WriteConsole("Loaded " + std::to_string(entities.size()) + " entities from scene '" + path + "'.", LogLevel::INFORMATION);
+
+                return true;
+            }
+        };
+	}
+}
\ No newline at end of file
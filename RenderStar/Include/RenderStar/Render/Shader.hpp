@@ -3,11 +3,17 @@
 #include <d3dx12.h>
 #include <d3d12.h>
 #include <dxc/dxcapi.h>
+#include "RenderStar/Core/JobSystem.hpp"
 #include "RenderStar/Core/Logger.hpp"
+#include "RenderStar/Core/PoolAllocator.hpp"
 #include "RenderStar/Core/Settings.hpp"
 #include "RenderStar/ECS/Component.hpp"
+#include "RenderStar/Render/ConstantBufferAllocator.hpp"
+#include "RenderStar/Render/PipelineStateCache.hpp"
 #include "RenderStar/Render/Renderer.hpp"
+#include "RenderStar/Render/ShaderCompiler.hpp"
 #include "RenderStar/Render/Vertex.hpp"
+#include "RenderStar/Util/Hash.hpp"
 #include "RenderStar/Util/Loader.hpp"
 #include "RenderStar/Util/RootSignature.hpp"
 
@@ -25,110 +31,134 @@ namespace RenderStar
 
         public:
 
-            void Bind()
+            void Bind(Size textureDescriptor)
             {
-                auto commandList = Renderer::GetInstance()->GetCommandList();
+                CommandContext* context = Renderer::GetInstance()->GetCommandContext();
 
+                BindRootSignature(context);
+                BindPipelineState(context);
+                BindDescriptors(context, textureDescriptor);
+            }
+
+            void BindRootSignature(CommandContext* context)
+            {
                 if (rootSignature)
-                    commandList->SetGraphicsRootSignature(rootSignature.Get());
+                    context->SetRootSignature(rootSignature.Get());
+            }
 
-                if (pipelineState)
-                    commandList->SetPipelineState(pipelineState.Get());
+            void BindPipelineState(CommandContext* context)
+            {
+                if (defaultPipeline && defaultPipeline->pipelineState)
+                    context->SetPipelineState(defaultPipeline->pipelineState.Get());
+            }
 
-                ID3D12DescriptorHeap* descriptorHeaps[] = { cbvSrvUavHeap.Get(), samplerHeap.Get() };
-                commandList->SetDescriptorHeaps(_countof(descriptorHeaps), descriptorHeaps);
+            void BindDescriptors(CommandContext* context, Size textureDescriptor)
+            {
+                const Shared<Renderer> renderer = Renderer::GetInstance();
 
-                if (!constantBuffers.empty())
-                {
-                    CD3DX12_GPU_DESCRIPTOR_HANDLE cbvSrvUavHeapHandle(cbvSrvUavHeap->GetGPUDescriptorHandleForHeapStart());
-                    commandList->SetGraphicsRootDescriptorTable(0, cbvSrvUavHeapHandle);
-                }
+                if (bindlessParameter)
+                    context->SetRootDescriptorTable(*bindlessParameter, renderer->GetDescriptorHeap().GetGpuStart());
 
-                if (!textures.empty())
-                {
-                    CD3DX12_GPU_DESCRIPTOR_HANDLE shaderResourceViewHandle(cbvSrvUavHeap->GetGPUDescriptorHandleForHeapStart(), maxConstantBuffers, cbvSrvUavDescriptorSize);
-                    commandList->SetGraphicsRootDescriptorTable(0, shaderResourceViewHandle);
-                }
+                if (textureParameter)
+                    context->SetRootDescriptorTable(*textureParameter, renderer->GetDescriptorHeap().GetGpuHandle(textureDescriptor));
 
-                if (!samplers.empty())
-                {
-                    CD3DX12_GPU_DESCRIPTOR_HANDLE samplerHandle(samplerHeap->GetGPUDescriptorHandleForHeapStart());
-                    commandList->SetGraphicsRootDescriptorTable(1, samplerHandle);
-                }
+                if (samplerParameter && sampler)
+                    context->SetRootDescriptorTable(*samplerParameter, renderer->GetSamplerHeap().GetGpuHandle(sampler->index));
             }
 
-            void CreateConstantBuffer(UINT bufferSize, UINT bufferIndex)
+            void UpdateConstantBuffer(CommandContext* context, const void* data, Size dataSize, UINT rootParameterIndex)
             {
-                if (bufferIndex >= constantBuffers.size())
-                    constantBuffers.resize(bufferIndex + 1);
+                context->SetRootConstantBufferView(rootParameterIndex, ConstantBufferAllocator::GetInstance()->Push(data, dataSize));
+            }
 
-                CD3DX12_HEAP_PROPERTIES heapProps(D3D12_HEAP_TYPE_UPLOAD);
-                CD3DX12_RESOURCE_DESC bufferDescription = CD3DX12_RESOURCE_DESC::Buffer(bufferSize);
+            void CreateSampler()
+            {
+                if (Renderer::GetInstance()->IsHeadless() || sampler)
+                    return;
 
-                HRESULT result = Renderer::GetInstance()->GetDevice()->CreateCommittedResource(&heapProps, D3D12_HEAP_FLAG_NONE, &bufferDescription, D3D12_RESOURCE_STATE_GENERIC_READ, nullptr, IID_PPV_ARGS(&constantBuffers[bufferIndex]));
+                sampler = Renderer::GetInstance()->GetSamplerHeap().AllocatePersistent();
 
-                if (FAILED(result))
-                    Logger_ThrowError("FAILED", "Failed to create constant buffer", false);
+                D3D12_SAMPLER_DESC samplerDescription = {};
 
-                constantBuffers[bufferIndex]->Map(0, nullptr, reinterpret_cast<void**>(&constantBufferDatas[bufferIndex]));
+                samplerDescription.Filter = D3D12_FILTER_MIN_MAG_MIP_LINEAR;
+                samplerDescription.AddressU = D3D12_TEXTURE_ADDRESS_MODE_WRAP;
+                samplerDescription.AddressV = D3D12_TEXTURE_ADDRESS_MODE_WRAP;
+                samplerDescription.AddressW = D3D12_TEXTURE_ADDRESS_MODE_WRAP;
+                samplerDescription.MinLOD = 0;
+                samplerDescription.MaxLOD = D3D12_FLOAT32_MAX;
+                samplerDescription.MipLODBias = 0.0f;
+                samplerDescription.MaxAnisotropy = 1;
+                samplerDescription.ComparisonFunc = D3D12_COMPARISON_FUNC_ALWAYS;
 
-                D3D12_CONSTANT_BUFFER_VIEW_DESC constantBufferViewDescription = {};
+                Renderer::GetInstance()->GetDevice()->CreateSampler(&samplerDescription, Renderer::GetInstance()->GetSamplerHeap().GetCpuHandle(sampler->index));
+            }
 
-                constantBufferViewDescription.BufferLocation = constantBuffers[bufferIndex]->GetGPUVirtualAddress();
-                constantBufferViewDescription.SizeInBytes = (bufferSize + 255) & ~255;
+            void CleanUp() override
+            {
+                Wait();
+
+                {
+                    LockGuard<Mutex> lock(permutationMutex);
+
+                    for (auto& [key, permutation] : permutations)
+                        permutation->CleanUp();
+
+                    permutations.clear();
+                }
+
+                if (sampler && !base)
+                    Renderer::GetInstance()->GetSamplerHeap().FreePersistent(*sampler);
 
-                CD3DX12_CPU_DESCRIPTOR_HANDLE constantBufferViewHandle(cbvSrvUavHeap->GetCPUDescriptorHandleForHeapStart(), bufferIndex, cbvSrvUavDescriptorSize);
-                Renderer::GetInstance()->GetDevice()->CreateConstantBufferView(&constantBufferViewDescription, constantBufferViewHandle);
+                sampler.reset();
             }
 
-            void UpdateConstantBuffer(const void* data, Size dataSize, UINT bufferIndex)
+            Shared<Shader> GetPermutation(const Vector<String>& keywords)
             {
-                memcpy(constantBufferDatas[bufferIndex], data, dataSize);
+                if (base)
+                    return base->GetPermutation(keywords);
+
+                return FindOrCreatePermutation(keywords, false);
             }
 
-            void CreateTexture(ComPtr<ID3D12Resource> resource, UINT textureIndex)
+            void DeclarePermutations(const Vector<Vector<String>>& keywordSets)
             {
-                if (textureIndex >= textures.size())
-                    textures.resize(textureIndex + 1);
+                if (base)
+                {
+                    base->DeclarePermutations(keywordSets);
+                    return;
+                }
 
-                textures[textureIndex] = resource;
+                for (const Vector<String>& keywords : keywordSets)
+                    FindOrCreatePermutation(keywords, true);
+            }
+
+            Vector<Shared<Shader>> GetPermutations()
+            {
+                LockGuard<Mutex> lock(permutationMutex);
 
-                D3D12_SHADER_RESOURCE_VIEW_DESC shaderResourceViewDescription = {};
+                Vector<Shared<Shader>> out;
 
-                shaderResourceViewDescription.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
-                shaderResourceViewDescription.Format = resource->GetDesc().Format;
-                shaderResourceViewDescription.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
-                shaderResourceViewDescription.Texture2D.MipLevels = resource->GetDesc().MipLevels;
+                out.reserve(permutations.size());
 
-                CD3DX12_CPU_DESCRIPTOR_HANDLE shaderResourceViewHandle(cbvSrvUavHeap->GetCPUDescriptorHandleForHeapStart(), textureIndex + maxConstantBuffers, cbvSrvUavDescriptorSize);
-                Renderer::GetInstance()->GetDevice()->CreateShaderResourceView(resource.Get(), &shaderResourceViewDescription, shaderResourceViewHandle);
+                for (const auto& [key, permutation] : permutations)
+                    out.push_back(permutation);
 
-                Logger_WriteConsole("Created texture at index: " + std::to_string(textureIndex), LogLevel::INFORMATION);
-                assert(textures[textureIndex] != nullptr);
+                return out;
             }
 
-            void CreateSampler(UINT samplerIndex)
+            const Vector<String>& GetKeywords() const
             {
-                if (samplerIndex >= samplers.size())
-                    samplers.resize(samplerIndex + 1);
-
-                D3D12_SAMPLER_DESC samplerDescription = {};
-
-                samplerDescription.Filter = D3D12_FILTER_MIN_MAG_MIP_LINEAR;
-                samplerDescription.AddressU = D3D12_TEXTURE_ADDRESS_MODE_WRAP;
-                samplerDescription.AddressV = D3D12_TEXTURE_ADDRESS_MODE_WRAP;
-                samplerDescription.AddressW = D3D12_TEXTURE_ADDRESS_MODE_WRAP;
-                samplerDescription.MinLOD = 0;
-                samplerDescription.MaxLOD = D3D12_FLOAT32_MAX;
-                samplerDescription.MipLODBias = 0.0f;
-                samplerDescription.MaxAnisotropy = 1;
-                samplerDescription.ComparisonFunc = D3D12_COMPARISON_FUNC_ALWAYS;
-
-                CD3DX12_CPU_DESCRIPTOR_HANDLE samplerHandle(samplerHeap->GetCPUDescriptorHandleForHeapStart(), samplerIndex, samplerDescriptorSize);
+                return keywords;
+            }
 
-                Renderer::GetInstance()->GetDevice()->CreateSampler(&samplerDescription, samplerHandle);
+            bool IsPermutation() const
+            {
+                return base != nullptr;
+            }
 
-                samplers[samplerIndex] = samplerHandle;
+            bool IsDeclared() const
+            {
+                return declared;
             }
 
             String GetName() const
@@ -166,21 +196,45 @@ namespace RenderStar
 
             ComPtr<ID3D12PipelineState> GetPipelineState() const
             {
-                return pipelineState;
+                return defaultPipeline ? defaultPipeline->pipelineState : nullptr;
             }
 
-            void CleanUp()
+            const CachedPipelineState* GetPipelineState(const PipelineStateVariant& variant)
             {
-                for (auto& buffer : constantBuffers)
-                {
-                    if (buffer)
-                        buffer->Unmap(0, nullptr);
-                }
+                Wait();
+
+                return ResolvePipelineState(variant);
+            }
+
+            bool IsReady() const
+            {
+                return ready.load(std::memory_order_acquire);
+            }
+
+            void Wait()
+            {
+                if (generating.load(std::memory_order_acquire))
+                    JobSystem::GetInstance()->WaitUntil([this] { return IsReady(); });
+            }
+
+            bool IsBindless() const
+            {
+                return bindlessParameter.has_value();
+            }
+
+            uint GetSortId() const
+            {
+                return sortId;
+            }
+
+            uint GetRootSignatureSortId() const
+            {
+                return rootSignatureSortId;
             }
 
             static Shared<Shader> Create(const String& name, const String& localPath, Shared<RootSignature> rootSignature, const String& domain = Settings::GetInstance()->Get<String>("defaultDomain"))
             {
-                Shared<Shader> out = std::make_shared<Shader>();
+                Shared<Shader> out = MakePooled<Shader>();
 
                 out->name = name;
                 out->localPath = localPath;
@@ -192,6 +246,12 @@ namespace RenderStar
                 out->hullPath = "Assets/" + domain + "/" + localPath + "Hull.hlsl";
                 out->domainPath = "Assets/" + domain + "/" + localPath + "Domain.hlsl";
                 out->rootSignature = rootSignature->Generate();
+                out->sortId = SortKey::AllocateId();
+                out->rootSignatureSortId = rootSignature->GetSortId();
+                out->rootSignatureHash = rootSignature->GetHash();
+                out->textureParameter = rootSignature->FindParameter(RootSignatureParameterType::SHADER_RESOURCE_VIEW);
+                out->samplerParameter = rootSignature->FindParameter(RootSignatureParameterType::SAMPLER);
+                out->bindlessParameter = rootSignature->FindParameter(RootSignatureParameterType::BINDLESS_SHADER_RESOURCE_VIEWS);
 
                 out->Generate();
 
@@ -202,121 +262,126 @@ namespace RenderStar
 
             void Generate()
             {
-                ComPtr<IDxcUtils> utils;
-                ComPtr<IDxcCompiler3> compiler;
-                ComPtr<IDxcIncludeHandler> includeHandler;
+                if (Renderer::GetInstance()->IsHeadless())
+                {
+                    ready.store(true, std::memory_order_release);
+                    return;
+                }
 
-                HRESULT result = DxcCreateInstance(CLSID_DxcUtils, IID_PPV_ARGS(&utils));
+                if (samplerParameter)
+                    CreateSampler();
 
-                if (FAILED(result))
-                    Logger_ThrowError("FAILED", "Failed to create DxcUtils instance", false);
+                const Shared<JobSystem> jobSystem = JobSystem::GetInstance();
 
-                result = DxcCreateInstance(CLSID_DxcCompiler, IID_PPV_ARGS(&compiler));
+                JobHandle stages = jobSystem->CreateJob(nullptr);
 
-                if (FAILED(result))
-                    Logger_ThrowError("FAILED", "Failed to create DxcCompiler instance", false);
+                const auto compile = [this, &jobSystem, stages](ComPtr<IDxcBlob>& blob, const String& path, const wchar_t* target)
+                {
+                    jobSystem->Run(jobSystem->CreateChildJob(stages, [this, &blob, &path, target] { blob = ShaderCompiler::GetInstance()->Compile(path, target, keywords); }));
+                };
 
-                result = utils->CreateDefaultIncludeHandler(&includeHandler);
+                compile(vertexShaderBlob, vertexPath, L"vs_6_6");
+                compile(pixelShaderBlob, pixelPath, L"ps_6_6");
+                compile(computeShaderBlob, computePath, L"cs_6_6");
+                compile(geometryShaderBlob, geometryPath, L"gs_6_6");
+                compile(hullShaderBlob, hullPath, L"hs_6_6");
+                compile(domainShaderBlob, domainPath, L"ds_6_6");
 
-                if (FAILED(result))
-                    Logger_ThrowError("FAILED", "Failed to create default include handler", false);
+                JobHandle readyJob = jobSystem->CreateJob([this]
+                {
+                    if (!vertexShaderBlob || !pixelShaderBlob)
+                        Logger_ThrowError("FAILED", "Failed to compile shader: " + GetDisplayName(), false);
 
-                CreateDescriptorHeaps();
+                    defaultPipeline = ResolvePipelineState(PipelineStateVariant());
 
-                ComPtr<IDxcBlob> vertexShaderBlob = CompileShader(utils, compiler, includeHandler, vertexPath, L"vs_6_6");
-                ComPtr<IDxcBlob> pixelShaderBlob = CompileShader(utils, compiler, includeHandler, pixelPath, L"ps_6_6");
-                ComPtr<IDxcBlob> computeShaderBlob = CompileShader(utils, compiler, includeHandler, computePath, L"cs_6_6");
-                ComPtr<IDxcBlob> geometryShaderBlob = CompileShader(utils, compiler, includeHandler, geometryPath, L"gs_6_6");
-                ComPtr<IDxcBlob> hullShaderBlob = CompileShader(utils, compiler, includeHandler, hullPath, L"hs_6_6");
-                ComPtr<IDxcBlob> domainShaderBlob = CompileShader(utils, compiler, includeHandler, domainPath, L"ds_6_6");
+                    ready.store(true, std::memory_order_release);
+                });
 
-                if (!vertexShaderBlob || !pixelShaderBlob)
-                    Logger_ThrowError("FAILED", "Failed to compile shader", false);
+                jobSystem->AddContinuation(stages, readyJob);
 
-                CreateGraphicsPipelineState(vertexShaderBlob, pixelShaderBlob, geometryShaderBlob, hullShaderBlob, domainShaderBlob);
+                generating.store(true, std::memory_order_release);
+                jobSystem->Run(stages);
             }
 
-            void CreateDescriptorHeaps()
+            Shared<Shader> FindOrCreatePermutation(Vector<String> keywords, bool declared)
             {
-                D3D12_DESCRIPTOR_HEAP_DESC cbvSrvUavHeapDescription = {};
+                std::sort(keywords.begin(), keywords.end());
+                keywords.erase(std::unique(keywords.begin(), keywords.end()), keywords.end());
 
-                cbvSrvUavHeapDescription.NumDescriptors = maxConstantBuffers + maxTextures;
-                cbvSrvUavHeapDescription.Type = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
-                cbvSrvUavHeapDescription.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE;
+                ullong key = Hash::Seed;
 
-                HRESULT result = Renderer::GetInstance()->GetDevice()->CreateDescriptorHeap(&cbvSrvUavHeapDescription, IID_PPV_ARGS(&cbvSrvUavHeap));
+                for (const String& keyword : keywords)
+                    key = Hash::Combine(key, keyword);
 
-                if (FAILED(result))
-                    Logger_ThrowError("FAILED", "Failed to create CBV/SRV/UAV descriptor heap", false);
+                LockGuard<Mutex> lock(permutationMutex);
 
-                cbvSrvUavDescriptorSize = Renderer::GetInstance()->GetDevice()->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+                auto found = permutations.find(key);
 
-                D3D12_DESCRIPTOR_HEAP_DESC samplerHeapDescription = {};
+                if (found != permutations.end())
+                    return found->second;
 
-                samplerHeapDescription.NumDescriptors = maxTextures;
-                samplerHeapDescription.Type = D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER;
-                samplerHeapDescription.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE;
+                Shared<Shader> out = MakePooled<Shader>();
 
-                result = Renderer::GetInstance()->GetDevice()->CreateDescriptorHeap(&samplerHeapDescription, IID_PPV_ARGS(&samplerHeap));
+                out->name = name;
+                out->localPath = localPath;
+                out->domain = domain;
+                out->vertexPath = vertexPath;
+                out->pixelPath = pixelPath;
+                out->computePath = computePath;
+                out->geometryPath = geometryPath;
+                out->hullPath = hullPath;
+                out->domainPath = domainPath;
+                out->rootSignature = rootSignature;
+                out->sortId = SortKey::AllocateId();
+                out->rootSignatureSortId = rootSignatureSortId;
+                out->rootSignatureHash = rootSignatureHash;
+                out->textureParameter = textureParameter;
+                out->samplerParameter = samplerParameter;
+                out->bindlessParameter = bindlessParameter;
+                out->sampler = sampler;
+                out->base = this;
+                out->keywords = std::move(keywords);
+                out->declared = declared;
+
+                if (!declared && !Renderer::GetInstance()->IsHeadless())
+                    Logger_WriteConsole("Shader permutation " + out->GetDisplayName() + " was not declared up front; compiling it on first use", LogLevel::WARNING);
+
+                out->Generate();
 
-                if (FAILED(result))
-                    Logger_ThrowError("FAILED", "Failed to create sampler descriptor heap", false);
+                permutations.emplace(key, out);
 
-                samplerDescriptorSize = Renderer::GetInstance()->GetDevice()->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER);
+                return out;
             }
 
-            ComPtr<IDxcBlob> CompileShader(ComPtr<IDxcUtils>& utils, ComPtr<IDxcCompiler3>& compiler, ComPtr<IDxcIncludeHandler>& includeHandler, const String& path, const wchar_t* target)
+            String GetDisplayName() const
             {
-                InputFileStream shaderFile(path);
+                String out = name;
 
-                if (!shaderFile.good())
-                    return nullptr;
+                for (Size k = 0; k < keywords.size(); ++k)
+                    out += (k == 0 ? "[" : ",") + keywords[k];
 
-                StringStream shaderStream;
-
-                shaderStream << shaderFile.rdbuf();
-
-                String shaderCode = shaderStream.str();
-
-                DxcBuffer sourceBuffer = {};
-
-                sourceBuffer.Ptr = shaderCode.data();
-                sourceBuffer.Size = shaderCode.size();
-                sourceBuffer.Encoding = DXC_CP_UTF8;
-
-                const wchar_t* arguments[] =
-                {
-                    L"-E", L"Main",
-                    L"-T", target,
-                    L"-Zi",
-                    L"-Qstrip_reflect"
-                };
-
-                ComPtr<IDxcResult> results;
-
-                HRESULT result = compiler->Compile(&sourceBuffer, arguments, _countof(arguments), includeHandler.Get(), IID_PPV_ARGS(&results));
-
-                if (FAILED(result))
-                    Logger_ThrowError("FAILED", "Failed to compile shader: " + path, false);
+                return keywords.empty() ? out : out + "]";
+            }
 
-                ComPtr<IDxcBlobUtf8> errors;
+            const CachedPipelineState* ResolvePipelineState(const PipelineStateVariant& variant)
+            {
+                const uint key = variant.GetKey();
 
-                result = results->GetOutput(DXC_OUT_ERRORS, IID_PPV_ARGS(&errors), nullptr);
+                LockGuard<Mutex> lock(variantMutex);
 
-                if (errors && errors->GetStringLength() > 0)
-                    Logger_ThrowError("FAILED", errors->GetStringPointer(), false);
+                auto found = variants.find(key);
 
-                ComPtr<IDxcBlob> shaderBlob;
+                if (found != variants.end())
+                    return found->second;
 
-                result = results->GetOutput(DXC_OUT_OBJECT, IID_PPV_ARGS(&shaderBlob), nullptr);
+                const CachedPipelineState* out = PipelineStateCache::GetInstance()->GetOrCreate(rootSignatureHash, variant, CreatePipelineStateDescription());
 
-                if (FAILED(result))
-                    Logger_ThrowError("FAILED", "Failed to retrieve shader blob: " + path, false);
+                variants.emplace(key, out);
 
-                return shaderBlob;
+                return out;
             }
 
-            void CreateGraphicsPipelineState(ComPtr<IDxcBlob>& vertexShaderBlob, ComPtr<IDxcBlob>& pixelShaderBlob, ComPtr<IDxcBlob>& geometryShaderBlob, ComPtr<IDxcBlob>& hullShaderBlob, ComPtr<IDxcBlob>& domainShaderBlob)
+            D3D12_GRAPHICS_PIPELINE_STATE_DESC CreatePipelineStateDescription() const
             {
                 D3D12_GRAPHICS_PIPELINE_STATE_DESC pipelineStateDescription = {};
 
@@ -327,21 +392,12 @@ namespace RenderStar
                 pipelineStateDescription.DS = domainShaderBlob ? D3D12_SHADER_BYTECODE{ domainShaderBlob->GetBufferPointer(), domainShaderBlob->GetBufferSize() } : D3D12_SHADER_BYTECODE{};
 
                 pipelineStateDescription.pRootSignature = rootSignature.Get();
-                pipelineStateDescription.RasterizerState = CD3DX12_RASTERIZER_DESC(D3D12_DEFAULT);
-                pipelineStateDescription.BlendState = CD3DX12_BLEND_DESC(D3D12_DEFAULT);
-                pipelineStateDescription.DepthStencilState = CD3DX12_DEPTH_STENCIL_DESC(D3D12_DEFAULT);
                 pipelineStateDescription.InputLayout = { Vertex::GetInputLayout().data(), (UINT)Vertex::GetInputLayout().size() };
                 pipelineStateDescription.SampleMask = UINT_MAX;
                 pipelineStateDescription.PrimitiveTopologyType = D3D12_PRIMITIVE_TOPOLOGY_TYPE_TRIANGLE;
-                pipelineStateDescription.NumRenderTargets = 1;
-                pipelineStateDescription.RTVFormats[0] = DXGI_FORMAT_R8G8B8A8_UNORM;
-                pipelineStateDescription.DSVFormat = DXGI_FORMAT_D32_FLOAT;
                 pipelineStateDescription.SampleDesc.Count = 1;
 
-                HRESULT result = Renderer::GetInstance()->GetDevice()->CreateGraphicsPipelineState(&pipelineStateDescription, IID_PPV_ARGS(&pipelineState));
-
-                if (FAILED(result))
-                    Logger_ThrowError("FAILED", "Failed to create graphics pipeline state", true);
+                return pipelineStateDescription;
             }
 
             String name;
@@ -352,22 +408,36 @@ namespace RenderStar
             String computePath, geometryPath;
             String hullPath, domainPath;
 
-            ComPtr<ID3D12PipelineState> pipelineState;
+            ComPtr<IDxcBlob> vertexShaderBlob, pixelShaderBlob;
+            ComPtr<IDxcBlob> computeShaderBlob, geometryShaderBlob;
+            ComPtr<IDxcBlob> hullShaderBlob, domainShaderBlob;
+
             ComPtr<ID3D12RootSignature> rootSignature;
 
-            Vector<ComPtr<ID3D12Resource>> constantBuffers;
-            Vector<UINT8*> constantBufferDatas;
-            Vector<ComPtr<ID3D12Resource>> textures;
-            Vector<CD3DX12_CPU_DESCRIPTOR_HANDLE> samplers;
+            const CachedPipelineState* defaultPipeline = nullptr;
+
+            UnorderedMap<uint, const CachedPipelineState*> variants;
+            Mutex variantMutex;
+
+            AtomicBool generating = false;
+            AtomicBool ready = false;
+
+            Shader* base = nullptr;
+            Vector<String> keywords;
+            bool declared = false;
+
+            UnorderedMap<ullong, Shared<Shader>> permutations;
+            Mutex permutationMutex;
 
-            ComPtr<ID3D12DescriptorHeap> cbvSrvUavHeap;
-            ComPtr<ID3D12DescriptorHeap> samplerHeap;
+            Optional<UINT> textureParameter;
+            Optional<UINT> samplerParameter;
+            Optional<UINT> bindlessParameter;
 
-            UINT cbvSrvUavDescriptorSize = 0;
-            UINT samplerDescriptorSize = 0;
+            Optional<DescriptorAllocation> sampler;
 
-            static const UINT maxConstantBuffers = 8;
-            static const UINT maxTextures = 8;
+            uint sortId = 0;
+            uint rootSignatureSortId = 0;
+            ullong rootSignatureHash = 0;
         };
 	}
 }
\ No newline at end of file
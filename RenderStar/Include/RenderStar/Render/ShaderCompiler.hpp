@@ -0,0 +1,578 @@
+#pragma once
+
+#include <dxc/dxcapi.h>
+#include "RenderStar/Core/Logger.hpp"
+#include "RenderStar/Core/Settings.hpp"
+#include "RenderStar/Util/Hash.hpp"
+#include "RenderStar/Util/Typedefs.hpp"
+
+using namespace RenderStar::Core;
+using namespace RenderStar::Util;
+
+namespace RenderStar
+{
+	namespace Render
+	{
+        struct ShaderCompilerStatistics
+        {
+            Size cacheHits = 0;
+            Size cacheMisses = 0;
+            Size invalidations = 0;
+            Size absentStages = 0;
+            Size compilerInstances = 0;
+            Size permutationCompiles = 0;
+
+            float compileTime = 0.0f;
+            float cacheLoadTime = 0.0f;
+        };
+
+        struct ShaderInclude
+        {
+            String path;
+
+            ullong hash = 0;
+        };
+
+        class ShaderIncludeHandler : public IDxcIncludeHandler
+        {
+
+        public:
+
+            void Initialize(ComPtr<IDxcIncludeHandler> defaultHandler)
+            {
+                this->defaultHandler = defaultHandler;
+            }
+
+            void Reset()
+            {
+                includes.clear();
+            }
+
+            const Vector<ShaderInclude>& GetIncludes() const
+            {
+                return includes;
+            }
+
+            HRESULT STDMETHODCALLTYPE LoadSource(LPCWSTR fileName, IDxcBlob** includeSource) override
+            {
+                HRESULT result = defaultHandler->LoadSource(fileName, includeSource);
+
+                if (SUCCEEDED(result) && *includeSource)
+                    includes.push_back({ Path(fileName).string(), Hash::Combine(Hash::Seed, (*includeSource)->GetBufferPointer(), (*includeSource)->GetBufferSize()) });
+
+                return result;
+            }
+
+            HRESULT STDMETHODCALLTYPE QueryInterface(REFIID id, void** object) override
+            {
+                if (id == __uuidof(IDxcIncludeHandler) || id == __uuidof(IUnknown))
+                {
+                    *object = static_cast<IDxcIncludeHandler*>(this);
+                    return S_OK;
+                }
+
+                *object = nullptr;
+
+                return E_NOINTERFACE;
+            }
+
+            ULONG STDMETHODCALLTYPE AddRef() override
+            {
+                return 1;
+            }
+
+            ULONG STDMETHODCALLTYPE Release() override
+            {
+                return 1;
+            }
+
+        private:
+
+            ComPtr<IDxcIncludeHandler> defaultHandler;
+
+            Vector<ShaderInclude> includes;
+        };
+
+        class ShaderCompiler
+        {
+
+        public:
+
+            void Initialize()
+            {
+                cachePath = Settings::GetInstance()->Get<String>("shaderCachePath");
+            }
+
+            ComPtr<IDxcBlob> Compile(const String& path, const wchar_t* target, const Vector<String>& defines = {})
+            {
+                if (!FileExists(path))
+                {
+                    LockGuard<Mutex> lock(mutex);
+
+                    statistics.absentStages++;
+
+                    return nullptr;
+                }
+
+                String source;
+
+                if (!ReadFile(path, source))
+                    return nullptr;
+
+                Unique<Instance> instance = Acquire();
+
+                const Vector<WString> arguments = CreateArguments(target, defines);
+                const ullong key = CreateKey(instance->compilerVersion, source, arguments);
+
+                const TimePoint start = Clock::now();
+
+                ComPtr<IDxcBlob> out = LoadCached(*instance, key);
+
+                if (out)
+                {
+                    AddTime(statistics.cacheLoadTime, start);
+
+                    LockGuard<Mutex> lock(mutex);
+
+                    statistics.cacheHits++;
+                }
+                else
+                {
+                    out = CompileSource(*instance, path, source, arguments, key);
+
+                    AddTime(statistics.compileTime, start);
+
+                    LockGuard<Mutex> lock(mutex);
+
+                    statistics.cacheMisses++;
+
+                    if (!defines.empty())
+                        statistics.permutationCompiles++;
+                }
+
+                Release(std::move(instance));
+
+                return out;
+            }
+
+            bool FileExists(const String& path)
+            {
+                {
+                    LockGuard<Mutex> lock(mutex);
+
+                    auto found = existingFiles.find(path);
+
+                    if (found != existingFiles.end())
+                        return found->second;
+                }
+
+                std::error_code error;
+
+                const bool exists = std::filesystem::is_regular_file(path, error);
+
+                LockGuard<Mutex> lock(mutex);
+
+                existingFiles[path] = exists;
+
+                return exists;
+            }
+
+            ShaderCompilerStatistics GetStatistics()
+            {
+                LockGuard<Mutex> lock(mutex);
+
+                return statistics;
+            }
+
+            void LogStatistics()
+            {
+                const ShaderCompilerStatistics out = GetStatistics();
+
+                Logger_WriteConsole("Shader compiler: " + std::to_string(out.cacheHits) + " cache hits loaded in " + std::to_string(out.cacheLoadTime * 1000.0f) + " ms, " + std::to_string(out.cacheMisses) + " compiled in " + std::to_string(out.compileTime * 1000.0f) + " ms, " + std::to_string(out.invalidations) + " invalidated by includes, " + std::to_string(out.absentStages) + " absent stages skipped, " + std::to_string(out.permutationCompiles) + " permutation stages compiled, " + std::to_string(out.compilerInstances) + " compiler instances", LogLevel::INFORMATION);
+            }
+
+            void CleanUp()
+            {
+                LockGuard<Mutex> lock(mutex);
+
+                instances.clear();
+                existingFiles.clear();
+                includeHashes.clear();
+            }
+
+            static Shared<ShaderCompiler> GetInstance()
+            {
+                static Shared<ShaderCompiler> instance = std::make_shared<ShaderCompiler>();
+
+                return instance;
+            }
+
+        private:
+
+            static constexpr uint CacheMagic = 0x43485352;
+            static constexpr uint CacheVersion = 2;
+
+            struct IncludeStamp
+            {
+                ullong hash = 0;
+
+                FileTime lastWriteTime;
+                uintmax_t size = 0;
+            };
+
+            struct Instance
+            {
+                ComPtr<IDxcUtils> utils;
+                ComPtr<IDxcCompiler3> compiler;
+
+                ShaderIncludeHandler includeHandler;
+
+                ullong compilerVersion = 0;
+            };
+
+            Unique<Instance> Acquire()
+            {
+                {
+                    LockGuard<Mutex> lock(mutex);
+
+                    if (!instances.empty())
+                    {
+                        Unique<Instance> out = std::move(instances.back());
+
+                        instances.pop_back();
+
+                        return out;
+                    }
+                }
+
+                Unique<Instance> out = std::make_unique<Instance>();
+
+                HRESULT result = DxcCreateInstance(CLSID_DxcUtils, IID_PPV_ARGS(&out->utils));
+
+                if (FAILED(result))
+                    Logger_ThrowError("FAILED", "Failed to create DxcUtils instance", true);
+
+                result = DxcCreateInstance(CLSID_DxcCompiler, IID_PPV_ARGS(&out->compiler));
+
+                if (FAILED(result))
+                    Logger_ThrowError("FAILED", "Failed to create DxcCompiler instance", true);
+
+                ComPtr<IDxcIncludeHandler> defaultHandler;
+
+                result = out->utils->CreateDefaultIncludeHandler(&defaultHandler);
+
+                if (FAILED(result))
+                    Logger_ThrowError("FAILED", "Failed to create default include handler", true);
+
+                out->includeHandler.Initialize(defaultHandler);
+                out->compilerVersion = QueryCompilerVersion(out->compiler);
+
+                LockGuard<Mutex> lock(mutex);
+
+                statistics.compilerInstances++;
+
+                return out;
+            }
+
+            void Release(Unique<Instance> instance)
+            {
+                LockGuard<Mutex> lock(mutex);
+
+                instances.push_back(std::move(instance));
+            }
+
+            static Vector<WString> CreateArguments(const wchar_t* target, const Vector<String>& defines)
+            {
+                Vector<WString> out =
+                {
+                    L"-E", L"Main",
+                    L"-T", target,
+                    L"-Zi",
+                    L"-Qstrip_reflect"
+                };
+
+                for (const String& define : defines)
+                {
+                    out.push_back(L"-D");
+                    out.push_back(WString(define.begin(), define.end()));
+                }
+
+                return out;
+            }
+
+            static ullong QueryCompilerVersion(const ComPtr<IDxcCompiler3>& compiler)
+            {
+                ullong out = Hash::Seed;
+
+                ComPtr<IDxcVersionInfo> versionInfo;
+
+                if (SUCCEEDED(compiler.As(&versionInfo)))
+                {
+                    UINT32 major = 0, minor = 0;
+
+                    if (SUCCEEDED(versionInfo->GetVersion(&major, &minor)))
+                        out = Hash::Combine(Hash::Combine(out, major), minor);
+                }
+
+                ComPtr<IDxcVersionInfo2> commitInfo;
+
+                if (SUCCEEDED(compiler.As(&commitInfo)))
+                {
+                    UINT32 commitCount = 0;
+                    char* commitHash = nullptr;
+
+                    if (SUCCEEDED(commitInfo->GetCommitInfo(&commitCount, &commitHash)) && commitHash)
+                    {
+                        out = Hash::Combine(Hash::Combine(out, commitCount), String(commitHash));
+
+                        CoTaskMemFree(commitHash);
+                    }
+                }
+
+                return out;
+            }
+
+            static ullong CreateKey(ullong compilerVersion, const String& source, const Vector<WString>& arguments)
+            {
+                ullong hash = Hash::Combine(Hash::Seed, CacheVersion);
+
+                hash = Hash::Combine(hash, compilerVersion);
+
+                hash = Hash::Combine(hash, source);
+
+                for (const WString& argument : arguments)
+                    hash = Hash::Combine(hash, argument.data(), argument.size() * sizeof(wchar_t));
+
+                return hash;
+            }
+
+            ComPtr<IDxcBlob> CompileSource(Instance& instance, const String& path, const String& source, const Vector<WString>& argumentStrings, ullong key)
+            {
+                DxcBuffer sourceBuffer = {};
+
+                sourceBuffer.Ptr = source.data();
+                sourceBuffer.Size = source.size();
+                sourceBuffer.Encoding = DXC_CP_UTF8;
+
+                Vector<const wchar_t*> arguments;
+
+                for (const WString& argument : argumentStrings)
+                    arguments.push_back(argument.c_str());
+
+                instance.includeHandler.Reset();
+
+                ComPtr<IDxcResult> results;
+
+                HRESULT result = instance.compiler->Compile(&sourceBuffer, arguments.data(), static_cast<UINT32>(arguments.size()), &instance.includeHandler, IID_PPV_ARGS(&results));
+
+                if (FAILED(result))
+                {
+                    Logger_ThrowError("FAILED", "Failed to compile shader: " + path, false);
+                    return nullptr;
+                }
+
+                ComPtr<IDxcBlobUtf8> errors;
+
+                result = results->GetOutput(DXC_OUT_ERRORS, IID_PPV_ARGS(&errors), nullptr);
+
+                if (errors && errors->GetStringLength() > 0)
+                    Logger_ThrowError("FAILED", errors->GetStringPointer(), false);
+
+                ComPtr<IDxcBlob> shaderBlob;
+
+                result = results->GetOutput(DXC_OUT_OBJECT, IID_PPV_ARGS(&shaderBlob), nullptr);
+
+                if (FAILED(result) || !shaderBlob)
+                {
+                    Logger_ThrowError("FAILED", "Failed to retrieve shader blob: " + path, false);
+                    return nullptr;
+                }
+
+                StoreCached(key, instance.includeHandler.GetIncludes(), shaderBlob);
+
+                return shaderBlob;
+            }
+
+            ComPtr<IDxcBlob> LoadCached(Instance& instance, ullong key)
+            {
+                if (cachePath.empty())
+                    return nullptr;
+
+                InputFileStream stream(GetCacheFile(key), std::ios::binary);
+
+                if (!stream.is_open())
+                    return nullptr;
+
+                uint magic = 0, version = 0, includeCount = 0;
+
+                stream.read(reinterpret_cast<char*>(&magic), sizeof(magic));
+                stream.read(reinterpret_cast<char*>(&version), sizeof(version));
+                stream.read(reinterpret_cast<char*>(&includeCount), sizeof(includeCount));
+
+                if (!stream || magic != CacheMagic || version != CacheVersion)
+                    return nullptr;
+
+                for (uint i = 0; i < includeCount; ++i)
+                {
+                    uint pathLength = 0;
+                    ullong hash = 0;
+
+                    stream.read(reinterpret_cast<char*>(&pathLength), sizeof(pathLength));
+
+                    String includePath(pathLength, '\0');
+
+                    stream.read(includePath.data(), pathLength);
+                    stream.read(reinterpret_cast<char*>(&hash), sizeof(hash));
+
+                    if (!stream)
+                        return nullptr;
+
+                    if (HashFile(includePath) != hash)
+                    {
+                        LockGuard<Mutex> lock(mutex);
+
+                        statistics.invalidations++;
+
+                        return nullptr;
+                    }
+                }
+
+                ullong objectSize = 0;
+
+                stream.read(reinterpret_cast<char*>(&objectSize), sizeof(objectSize));
+
+                Vector<char> object(static_cast<Size>(objectSize));
+
+                stream.read(object.data(), static_cast<StreamSize>(object.size()));
+
+                if (!stream || object.empty())
+                    return nullptr;
+
+                ComPtr<IDxcBlobEncoding> out;
+
+                if (FAILED(instance.utils->CreateBlob(object.data(), static_cast<UINT32>(object.size()), DXC_CP_ACP, &out)))
+                    return nullptr;
+
+                return out;
+            }
+
+            void StoreCached(ullong key, const Vector<ShaderInclude>& includes, const ComPtr<IDxcBlob>& object)
+            {
+                if (cachePath.empty())
+                    return;
+
+                std::error_code error;
+
+                std::filesystem::create_directories(cachePath, error);
+
+                const String file = GetCacheFile(key);
+                const String temporaryFile = file + "." + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) + ".tmp";
+
+                {
+                    OutputFileStream stream(temporaryFile, std::ios::binary | std::ios::trunc);
+
+                    if (!stream.is_open())
+                    {
+                        Logger_WriteConsole("Failed to write shader cache entry '" + file + "'", LogLevel::WARNING);
+                        return;
+                    }
+
+                    const uint includeCount = static_cast<uint>(includes.size());
+                    const ullong objectSize = object->GetBufferSize();
+
+                    stream.write(reinterpret_cast<const char*>(&CacheMagic), sizeof(CacheMagic));
+                    stream.write(reinterpret_cast<const char*>(&CacheVersion), sizeof(CacheVersion));
+                    stream.write(reinterpret_cast<const char*>(&includeCount), sizeof(includeCount));
+
+                    for (const ShaderInclude& include : includes)
+                    {
+                        const uint pathLength = static_cast<uint>(include.path.size());
+
+                        stream.write(reinterpret_cast<const char*>(&pathLength), sizeof(pathLength));
+                        stream.write(include.path.data(), pathLength);
+                        stream.write(reinterpret_cast<const char*>(&include.hash), sizeof(include.hash));
+                    }
+
+                    stream.write(reinterpret_cast<const char*>(&objectSize), sizeof(objectSize));
+                    stream.write(static_cast<const char*>(object->GetBufferPointer()), static_cast<StreamSize>(objectSize));
+                }
+
+                std::filesystem::rename(temporaryFile, file, error);
+
+                if (error)
+                    std::filesystem::remove(temporaryFile, error);
+            }
+
+            ullong HashFile(const String& path)
+            {
+                std::error_code error;
+
+                const FileTime lastWriteTime = std::filesystem::last_write_time(path, error);
+                const uintmax_t size = error ? 0 : std::filesystem::file_size(path, error);
+
+                {
+                    LockGuard<Mutex> lock(mutex);
+
+                    auto found = includeHashes.find(path);
+
+                    if (!error && found != includeHashes.end() && found->second.lastWriteTime == lastWriteTime && found->second.size == size)
+                        return found->second.hash;
+                }
+
+                String contents;
+
+                const ullong hash = ReadFile(path, contents) ? Hash::Combine(Hash::Seed, contents.data(), contents.size()) : 0;
+
+                LockGuard<Mutex> lock(mutex);
+
+                if (error)
+                    includeHashes.erase(path);
+                else
+                    includeHashes[path] = { hash, lastWriteTime, size };
+
+                return hash;
+            }
+
+            String GetCacheFile(ullong key) const
+            {
+                return (Path(cachePath) / (Hash::ToString(key) + ".dxil")).string();
+            }
+
+            static bool ReadFile(const String& path, String& out)
+            {
+                InputFileStream stream(path, std::ios::binary);
+
+                if (!stream.is_open())
+                    return false;
+
+                StringStream contents;
+
+                contents << stream.rdbuf();
+
+                out = contents.str();
+
+                return true;
+            }
+
+            void AddTime(float& total, const TimePoint& start)
+            {
+                const float elapsed = Duration(Clock::now() - start).count();
+
+                LockGuard<Mutex> lock(mutex);
+
+                total += elapsed;
+            }
+
+            String cachePath;
+
+            Vector<Unique<Instance>> instances;
+
+            UnorderedMap<String, bool> existingFiles;
+            UnorderedMap<String, IncludeStamp> includeHashes;
+
+            ShaderCompilerStatistics statistics;
+
+            Mutex mutex;
+        };
+	}
+}
\ No newline at end of file
@@ -1,14 +1,143 @@
 #pragma once
 
+#include "RenderStar/Core/JobSystem.hpp"
+#include "RenderStar/Core/Logger.hpp"
 #include "RenderStar/Render/Shader.hpp"
 #include "RenderStar/Util/Manager.hpp"
 
+using namespace RenderStar::Core;
 using namespace RenderStar::Util;
 
 namespace RenderStar
 {
 	namespace Render
 	{
-		class ShaderManager : public Manager<Shader, ShaderManager> {};
+        struct ShaderCompileProgress
+        {
+            Size readyCount = 0;
+            Size totalCount = 0;
+
+            float GetFraction() const
+            {
+                return totalCount == 0 ? 1.0f : static_cast<float>(readyCount) / static_cast<float>(totalCount);
+            }
+        };
+
+        struct ShaderPermutationStatistics
+        {
+            Size declaredCount = 0;
+            Size lazyCount = 0;
+            Size readyCount = 0;
+        };
+
+        class ShaderManager : public Manager<Shader, ShaderManager>
+        {
+
+        public:
+
+            void Register(Shared<Shader> value) override
+            {
+                if (!value->IsReady() && !pendingStart)
+                    pendingStart = Clock::now();
+
+                Manager::Register(value);
+            }
+
+            ShaderCompileProgress GetProgress() const
+            {
+                ShaderCompileProgress out;
+
+                for (const auto& [name, shader] : registeredObjects)
+                {
+                    out.totalCount++;
+
+                    if (shader->IsReady())
+                        out.readyCount++;
+
+                    for (const Shared<Shader>& permutation : shader->GetPermutations())
+                    {
+                        out.totalCount++;
+
+                        if (permutation->IsReady())
+                            out.readyCount++;
+                    }
+                }
+
+                return out;
+            }
+
+            void WaitAll()
+            {
+                Size permutationCount = 0;
+
+                for (const auto& [name, shader] : registeredObjects)
+                {
+                    shader->Wait();
+
+                    for (const Shared<Shader>& permutation : shader->GetPermutations())
+                    {
+                        permutation->Wait();
+                        permutationCount++;
+                    }
+                }
+
+                if (!pendingStart)
+                    return;
+
+                const float elapsed = Duration(Clock::now() - *pendingStart).count();
+
+                pendingStart.reset();
+
+                Logger_WriteConsole("Shader compilation: " + std::to_string(registeredObjects.size()) + " shader(s) and " + std::to_string(permutationCount) + " permutation(s) ready in " + std::to_string(elapsed * 1000.0f) + " ms wall time on " + std::to_string(JobSystem::GetInstance()->GetWorkerCount()) + " job thread(s)", LogLevel::INFORMATION);
+            }
+
+            void DeclarePermutations(const String& name, const Vector<Vector<String>>& keywordSets)
+            {
+                Shared<Shader> shader = Get(name);
+
+                if (!shader)
+                {
+                    Logger_ThrowError("FAILED", "Cannot declare permutations for unknown shader '" + name + "'", false);
+                    return;
+                }
+
+                if (!Renderer::GetInstance()->IsHeadless() && !pendingStart)
+                    pendingStart = Clock::now();
+
+                shader->DeclarePermutations(keywordSets);
+            }
+
+            ShaderPermutationStatistics GetPermutationStatistics() const
+            {
+                ShaderPermutationStatistics out;
+
+                for (const auto& [name, shader] : registeredObjects)
+                {
+                    for (const Shared<Shader>& permutation : shader->GetPermutations())
+                    {
+                        if (permutation->IsDeclared())
+                            out.declaredCount++;
+                        else
+                            out.lazyCount++;
+
+                        if (permutation->IsReady())
+                            out.readyCount++;
+                    }
+                }
+
+                return out;
+            }
+
+            void LogStatistics() const
+            {
+                const ShaderPermutationStatistics out = GetPermutationStatistics();
+
+                Logger_WriteConsole("Shader permutations: " + std::to_string(out.declaredCount) + " declared, " + std::to_string(out.lazyCount) + " compiled on first use, " + std::to_string(out.readyCount) + " ready", LogLevel::INFORMATION);
+            }
+
+        private:
+
+            Optional<TimePoint> pendingStart;
+        };
 	}
 }
\ No newline at end of file
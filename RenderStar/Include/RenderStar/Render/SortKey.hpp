@@ -0,0 +1,100 @@
+#pragma once
+
+#include "RenderStar/Util/Typedefs.hpp"
+
+using namespace RenderStar::Util;
+
+namespace RenderStar
+{
+	namespace Render
+	{
+        class SortKey
+        {
+
+        public:
+
+            static constexpr uint PassBits = 4;
+            static constexpr uint RootSignatureBits = 8;
+            static constexpr uint PipelineBits = 12;
+            static constexpr uint MaterialBits = 16;
+            static constexpr uint GeometryBits = 12;
+            static constexpr uint DepthBits = 12;
+
+            static ullong Create(uint pass, uint rootSignature, uint pipeline, uint material, uint geometry, float depth, bool reverseDepth = false)
+            {
+                const uint quantizedDepth = reverseDepth ? ~QuantizeDepth(depth) : QuantizeDepth(depth);
+
+                return Pack(pass, PassShift, PassBits) | Pack(rootSignature, RootSignatureShift, RootSignatureBits) | Pack(pipeline, PipelineShift, PipelineBits) | Pack(material, MaterialShift, MaterialBits) | Pack(geometry, GeometryShift, GeometryBits) | Pack(quantizedDepth, DepthShift, DepthBits);
+            }
+
+            static uint GetPass(ullong key)
+            {
+                return Unpack(key, PassShift, PassBits);
+            }
+
+            static uint GetRootSignature(ullong key)
+            {
+                return Unpack(key, RootSignatureShift, RootSignatureBits);
+            }
+
+            static uint GetPipeline(ullong key)
+            {
+                return Unpack(key, PipelineShift, PipelineBits);
+            }
+
+            static uint GetMaterial(ullong key)
+            {
+                return Unpack(key, MaterialShift, MaterialBits);
+            }
+
+            static uint GetGeometry(ullong key)
+            {
+                return Unpack(key, GeometryShift, GeometryBits);
+            }
+
+            static uint GetDepth(ullong key)
+            {
+                return Unpack(key, DepthShift, DepthBits);
+            }
+
+            static uint AllocateId()
+            {
+                static std::atomic<uint> nextId = 0;
+
+                return nextId.fetch_add(1, std::memory_order_relaxed);
+            }
+
+        private:
+
+            static constexpr uint DepthShift = 0;
+            static constexpr uint GeometryShift = DepthShift + DepthBits;
+            static constexpr uint MaterialShift = GeometryShift + GeometryBits;
+            static constexpr uint PipelineShift = MaterialShift + MaterialBits;
+            static constexpr uint RootSignatureShift = PipelineShift + PipelineBits;
+            static constexpr uint PassShift = RootSignatureShift + RootSignatureBits;
+
+            static_assert(PassShift + PassBits == 64, "Sort key fields must fill 64 bits.");
+
+            static ullong Pack(uint value, uint shift, uint bits)
+            {
+                return (static_cast<ullong>(value) & ((1ull << bits) - 1)) << shift;
+            }
+
+            static uint Unpack(ullong key, uint shift, uint bits)
+            {
+                return static_cast<uint>((key >> shift) & ((1ull << bits) - 1));
+            }
+
+            static uint QuantizeDepth(float depth)
+            {
+                uint bits = 0;
+
+                memcpy(&bits, &depth, sizeof(bits));
+
+                bits = (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+
+                return bits >> (32 - DepthBits);
+            }
+        };
+	}
+}
\ No newline at end of file
@@ -1,8 +1,11 @@
 #pragma once
 
 #include <DirectXTex.h>
+#include "RenderStar/Core/PoolAllocator.hpp"
 #include "RenderStar/Core/Settings.hpp"
 #include "RenderStar/ECS/Component.hpp"
+#include "RenderStar/Render/SortKey.hpp"
+#include "RenderStar/Render/UploadQueue.hpp"
 #include "RenderStar/Util/Loader.hpp"
 #include "RenderStar/Util/Typedefs.hpp"
 
@@ -20,22 +23,19 @@ namespace RenderStar
 
             void Bind()
             {
-                auto commandList = Renderer::GetInstance()->GetCommandList();
-
-                if (currentState != (D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE | D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE))
-                {
-                    CD3DX12_RESOURCE_BARRIER barrier = CD3DX12_RESOURCE_BARRIER::Transition(texture.Get(), currentState, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE | D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
-
-                    commandList->ResourceBarrier(1, &barrier);
-
-                    currentState = D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE | D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
-                }
+                if (texture)
+                    Renderer::GetInstance()->GetCommandContext()->TransitionResource(texture.Get(), D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE | D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
             }
 
             void CleanUp() override
             {
-                texture.Reset();
-                textureUploadHeap.Reset();
+                Renderer::GetInstance()->GetResourceStates().Unregister(texture.Get());
+                Renderer::GetInstance()->ReleaseDeferred(std::move(texture));
+
+                if (descriptor)
+                    Renderer::GetInstance()->GetDescriptorHeap().FreePersistent(*descriptor);
+
+                descriptor.reset();
             }
 
             ComPtr<ID3D12Resource> GetRaw()
@@ -48,13 +48,29 @@ namespace RenderStar
                 return name;
             }
 
+            uint GetDescriptorIndex() const
+            {
+                return descriptor ? static_cast<uint>(descriptor->index) : 0;
+            }
+
+            bool IsUploaded() const
+            {
+                return UploadQueue::GetInstance()->IsComplete(uploadFenceValue);
+            }
+
+            uint GetSortId() const
+            {
+                return sortId;
+            }
+
             static Shared<Texture> Create(const String& name, const String& localPath, const String& domain = Settings::GetInstance()->Get<String>("defaultDomain"))
             {
-                Shared<Texture> out = std::make_shared<Texture>();
+                Shared<Texture> out = MakePooled<Texture>();
 
                 out->name = name;
                 out->localPath = localPath;
                 out->path = "Assets/" + domain + "/" + localPath;
+                out->sortId = SortKey::AllocateId();
                 out->Generate();
 
                 return std::move(out);
@@ -64,6 +80,11 @@ namespace RenderStar
 
             void Generate()
             {
+                descriptor = Renderer::GetInstance()->GetDescriptorHeap().AllocatePersistent();
+
+                if (Renderer::GetInstance()->IsHeadless())
+                    return;
+
                 HRESULT result = CoInitializeEx(nullptr, COINITBASE_MULTITHREADED);
 
                 if (FAILED(result))
@@ -77,8 +98,6 @@ namespace RenderStar
                 if (FAILED(result))
                     Logger_ThrowError("FAILED", "Failed to load DDS file.", false);
 
-                const Image* image = scratchImage.GetImage(0, 0, 0);
-
                 auto device = Renderer::GetInstance()->GetDevice();
 
                 D3D12_RESOURCE_DESC textureDescription = {};
@@ -95,41 +114,39 @@ namespace RenderStar
 
                 CD3DX12_HEAP_PROPERTIES heapProperties(D3D12_HEAP_TYPE_DEFAULT);
 
-                result = device->CreateCommittedResource(&heapProperties, D3D12_HEAP_FLAG_NONE, &textureDescription, D3D12_RESOURCE_STATE_COPY_DEST, nullptr, IID_PPV_ARGS(&texture));
+                result = device->CreateCommittedResource(&heapProperties, D3D12_HEAP_FLAG_NONE, &textureDescription, D3D12_RESOURCE_STATE_COMMON, nullptr, IID_PPV_ARGS(&texture));
 
                 if (FAILED(result))
                     Logger_ThrowError("FAILED", "Failed to create texture resource.", false);
 
-                const UINT64 uploadBufferSize = GetRequiredIntermediateSize(texture.Get(), 0, metadata.mipLevels);
-
-                CD3DX12_HEAP_PROPERTIES uploadHeapProperties(D3D12_HEAP_TYPE_UPLOAD);
-                CD3DX12_RESOURCE_DESC bufferDescription = CD3DX12_RESOURCE_DESC::Buffer(uploadBufferSize);
-
-                result = device->CreateCommittedResource(&uploadHeapProperties, D3D12_HEAP_FLAG_NONE, &bufferDescription, D3D12_RESOURCE_STATE_GENERIC_READ, nullptr, IID_PPV_ARGS(&textureUploadHeap));
-
-                if (FAILED(result))
-                    Logger_ThrowError("FAILED", "Failed to create texture upload heap.", false);
+                Vector<D3D12_SUBRESOURCE_DATA> subresources(metadata.mipLevels);
 
-                D3D12_SUBRESOURCE_DATA textureData = {};
-
-                textureData.pData = image->pixels;
-                textureData.RowPitch = static_cast<LONG_PTR>(image->rowPitch);
-                textureData.SlicePitch = textureData.RowPitch * static_cast<LONG_PTR>(image->height);
+                for (Size l = 0; l < metadata.mipLevels; ++l)
+                {
+                    const Image* image = scratchImage.GetImage(l, 0, 0);
 
-                auto commandList = Renderer::GetInstance()->GetCommandList();
+                    subresources[l].pData = image->pixels;
+                    subresources[l].RowPitch = static_cast<LONG_PTR>(image->rowPitch);
+                    subresources[l].SlicePitch = static_cast<LONG_PTR>(image->slicePitch);
+                }
 
-                Renderer::GetInstance()->OpenCommandList();
+                uploadFenceValue = UploadQueue::GetInstance()->UploadTexture(texture.Get(), subresources);
 
-                UpdateSubresources(commandList.Get(), texture.Get(), textureUploadHeap.Get(), 0, 0, metadata.mipLevels, &textureData);
+                Renderer::GetInstance()->GetResourceStates().Register(texture.Get(), D3D12_RESOURCE_STATE_COMMON);
 
-                CD3DX12_RESOURCE_BARRIER barrier = CD3DX12_RESOURCE_BARRIER::Transition(texture.Get(), D3D12_RESOURCE_STATE_COPY_DEST, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+                CreateShaderResourceView();
+            }
 
-                commandList->ResourceBarrier(1, &barrier);
+            void CreateShaderResourceView()
+            {
+                D3D12_SHADER_RESOURCE_VIEW_DESC shaderResourceViewDescription = {};
 
-                Renderer::GetInstance()->CloseCommandList();
-                Renderer::GetInstance()->WaitForPreviousFrame();
+                shaderResourceViewDescription.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+                shaderResourceViewDescription.Format = texture->GetDesc().Format;
+                shaderResourceViewDescription.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
+                shaderResourceViewDescription.Texture2D.MipLevels = texture->GetDesc().MipLevels;
 
-                currentState = D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
+                Renderer::GetInstance()->GetDevice()->CreateShaderResourceView(texture.Get(), &shaderResourceViewDescription, Renderer::GetInstance()->GetDescriptorHeap().GetCpuHandle(descriptor->index));
             }
 
             String name;
@@ -137,11 +154,14 @@ namespace RenderStar
             String path;
 
             ComPtr<ID3D12Resource> texture;
-            ComPtr<ID3D12Resource> textureUploadHeap;
 
             D3D12_SUBRESOURCE_DATA subresourceData = {};
 
-            D3D12_RESOURCE_STATES currentState = D3D12_RESOURCE_STATE_COPY_DEST;
+            Optional<DescriptorAllocation> descriptor;
+
+            UINT64 uploadFenceValue = 0;
+
+            uint sortId = 0;
         };
 	}
 }
\ No newline at end of file
@@ -0,0 +1,394 @@
+#pragma once
+
+#include "RenderStar/Core/RingAllocator.hpp"
+#include "RenderStar/Core/Settings.hpp"
+#include "RenderStar/Render/Renderer.hpp"
+#include "RenderStar/Util/Typedefs.hpp"
+
+using namespace RenderStar::Core;
+using namespace RenderStar::Util;
+
+namespace RenderStar
+{
+	namespace Render
+	{
+        struct UploadStatistics
+        {
+            Size uploadCount = 0;
+            Size uploadedBytes = 0;
+            Size submissionCount = 0;
+            Size stallCount = 0;
+            Size dedicatedBufferCount = 0;
+
+            RingStatistics ring;
+        };
+
+        class UploadQueue
+        {
+
+        public:
+
+            void Initialize()
+            {
+                if (Renderer::GetInstance()->IsHeadless())
+                    return;
+
+                device = Renderer::GetInstance()->GetDevice();
+
+                CreateCommandQueue();
+                CreateFenceAndEvent();
+                CreateRingBuffer(Settings::GetInstance()->Get<uint>("uploadRingSize"));
+            }
+
+            UINT64 UploadBuffer(ID3D12Resource* destination, UINT64 destinationOffset, const void* data, Size size)
+            {
+                LockGuard<Mutex> lock(mutex);
+
+                Staging staging = AllocateStaging(size, 4);
+
+                memcpy(staging.data, data, size);
+
+                GetCommandList()->CopyBufferRegion(destination, destinationOffset, staging.resource, staging.offset, size);
+
+                statistics.uploadCount++;
+                statistics.uploadedBytes += size;
+
+                return nextFenceValue;
+            }
+
+            UINT64 CopyBuffer(ID3D12Resource* destination, UINT64 destinationOffset, ID3D12Resource* source, UINT64 sourceOffset, Size size)
+            {
+                LockGuard<Mutex> lock(mutex);
+
+                GetCommandList()->CopyBufferRegion(destination, destinationOffset, source, sourceOffset, size);
+
+                return nextFenceValue;
+            }
+
+            UINT64 UploadTexture(ID3D12Resource* destination, Span<const D3D12_SUBRESOURCE_DATA> subresources)
+            {
+                LockGuard<Mutex> lock(mutex);
+
+                const UINT subresourceCount = static_cast<UINT>(subresources.size());
+                const Size size = static_cast<Size>(GetRequiredIntermediateSize(destination, 0, subresourceCount));
+
+                Staging staging = AllocateStaging(size, D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT);
+
+                UpdateSubresources(GetCommandList(), destination, staging.resource, staging.offset, 0, subresourceCount, subresources.data());
+
+                statistics.uploadCount++;
+                statistics.uploadedBytes += size;
+
+                return nextFenceValue;
+            }
+
+            UINT64 Submit()
+            {
+                LockGuard<Mutex> lock(mutex);
+
+                return SubmitBatch();
+            }
+
+            void Flush()
+            {
+                if (Renderer::GetInstance()->IsHeadless())
+                    return;
+
+                LockGuard<Mutex> lock(mutex);
+
+                SubmitBatch();
+
+                if (lastSubmittedValue > lastWaitedValue)
+                {
+                    HRESULT result = Renderer::GetInstance()->GetCommandQueue()->Wait(fence.Get(), lastSubmittedValue);
+                    if (FAILED(result))
+                        Logger_ThrowError("FAILED", "Failed to wait on copy fence.", true);
+
+                    lastWaitedValue = lastSubmittedValue;
+                }
+
+                Retire();
+            }
+
+            bool IsComplete(UINT64 fenceValue) const
+            {
+                return !fence || fence->GetCompletedValue() >= fenceValue;
+            }
+
+            UploadStatistics GetStatistics()
+            {
+                LockGuard<Mutex> lock(mutex);
+
+                UploadStatistics out = statistics;
+
+                out.ring = ring.GetStatistics();
+
+                return out;
+            }
+
+            void LogStatistics()
+            {
+                const UploadStatistics out = GetStatistics();
+
+                Logger_WriteConsole("Upload queue: " + std::to_string(out.uploadCount) + " uploads, " + std::to_string(out.uploadedBytes / 1024) + " KiB in " + std::to_string(out.submissionCount) + " submissions, " + std::to_string(out.ring.wrapCount) + " ring wraps, " + std::to_string(out.stallCount) + " stalls, " + std::to_string(out.dedicatedBufferCount) + " oversized uploads, " + std::to_string(out.ring.peakUsedSize / 1024) + " KiB peak ring usage", LogLevel::INFORMATION);
+            }
+
+            void CleanUp()
+            {
+                if (Renderer::GetInstance()->IsHeadless())
+                    return;
+
+                LockGuard<Mutex> lock(mutex);
+
+                SubmitBatch();
+                WaitForFenceValue(lastSubmittedValue);
+                Retire();
+
+                ringBuffer->Unmap(0, nullptr);
+                ringBuffer.Reset();
+
+                batches.clear();
+
+                CloseHandle(fenceEvent);
+            }
+
+            static Shared<UploadQueue> GetInstance()
+            {
+                static Shared<UploadQueue> instance = std::make_shared<UploadQueue>();
+
+                return instance;
+            }
+
+        private:
+
+            struct Staging
+            {
+                ID3D12Resource* resource;
+
+                Size offset;
+
+                uchar* data;
+            };
+
+            struct CommandBatch
+            {
+                ComPtr<ID3D12CommandAllocator> commandAllocator;
+                ComPtr<ID3D12GraphicsCommandList> commandList;
+
+                UINT64 fenceValue = 0;
+            };
+
+            struct DedicatedBuffer
+            {
+                UINT64 fenceValue;
+
+                ComPtr<ID3D12Resource> resource;
+            };
+
+            void CreateCommandQueue()
+            {
+                D3D12_COMMAND_QUEUE_DESC commandQueueDescription = {};
+
+                commandQueueDescription.Flags = D3D12_COMMAND_QUEUE_FLAG_NONE;
+                commandQueueDescription.Type = D3D12_COMMAND_LIST_TYPE_COPY;
+
+                HRESULT result = device->CreateCommandQueue(&commandQueueDescription, IID_PPV_ARGS(&commandQueue));
+
+                if (FAILED(result))
+                    Logger_ThrowError("FAILED", "Failed to create copy command queue.", true);
+            }
+
+            void CreateFenceAndEvent()
+            {
+                HRESULT result = device->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&fence));
+
+                if (FAILED(result))
+                    Logger_ThrowError("FAILED", "Failed to create copy fence.", true);
+
+                fenceEvent = CreateEvent(nullptr, FALSE, FALSE, nullptr);
+
+                if (fenceEvent == nullptr)
+                    Logger_ThrowError("FAILED", "Failed to create copy fence event.", true);
+            }
+
+            void CreateRingBuffer(Size capacity)
+            {
+                ring = RingAllocator(capacity);
+
+                CD3DX12_HEAP_PROPERTIES heapProperties(D3D12_HEAP_TYPE_UPLOAD);
+                CD3DX12_RESOURCE_DESC bufferDescription = CD3DX12_RESOURCE_DESC::Buffer(capacity);
+
+                HRESULT result = device->CreateCommittedResource(&heapProperties, D3D12_HEAP_FLAG_NONE, &bufferDescription, D3D12_RESOURCE_STATE_GENERIC_READ, nullptr, IID_PPV_ARGS(&ringBuffer));
+
+                if (FAILED(result))
+                    Logger_ThrowError("FAILED", "Failed to create upload ring buffer.", true);
+
+                CD3DX12_RANGE readRange(0, 0);
+                ringBuffer->Map(0, &readRange, reinterpret_cast<void**>(&ringData));
+            }
+
+            Staging AllocateStaging(Size size, Size alignment)
+            {
+                if (size + alignment > ring.GetCapacity())
+                    return AllocateDedicated(size);
+
+                while (true)
+                {
+                    Retire();
+
+                    Optional<Size> offset = ring.Allocate(size, alignment);
+
+                    if (offset)
+                        return { ringBuffer.Get(), *offset, ringData + *offset };
+
+                    if (ring.HasOpenAllocations())
+                        SubmitBatch();
+
+                    statistics.stallCount++;
+
+                    WaitForFenceValue(*ring.GetOldestFence());
+                }
+            }
+
+            Staging AllocateDedicated(Size size)
+            {
+                DedicatedBuffer buffer = { nextFenceValue };
+
+                CD3DX12_HEAP_PROPERTIES heapProperties(D3D12_HEAP_TYPE_UPLOAD);
+                CD3DX12_RESOURCE_DESC bufferDescription = CD3DX12_RESOURCE_DESC::Buffer(size);
+
+                HRESULT result = device->CreateCommittedResource(&heapProperties, D3D12_HEAP_FLAG_NONE, &bufferDescription, D3D12_RESOURCE_STATE_GENERIC_READ, nullptr, IID_PPV_ARGS(&buffer.resource));
+
+                if (FAILED(result))
+                    Logger_ThrowError("FAILED", "Failed to create dedicated upload buffer.", true);
+
+                uchar* data = nullptr;
+
+                CD3DX12_RANGE readRange(0, 0);
+                buffer.resource->Map(0, &readRange, reinterpret_cast<void**>(&data));
+
+                dedicatedBuffers.push_back(std::move(buffer));
+
+                statistics.dedicatedBufferCount++;
+
+                return { dedicatedBuffers.back().resource.Get(), 0, data };
+            }
+
+            ID3D12GraphicsCommandList* GetCommandList()
+            {
+                if (openBatch)
+                    return openBatch->commandList.Get();
+
+                const UINT64 completedValue = fence->GetCompletedValue();
+
+                for (Unique<CommandBatch>& batch : batches)
+                {
+                    if (batch->fenceValue <= completedValue)
+                    {
+                        openBatch = batch.get();
+                        break;
+                    }
+                }
+
+                if (!openBatch)
+                {
+                    Unique<CommandBatch> batch = std::make_unique<CommandBatch>();
+
+                    HRESULT result = device->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_COPY, IID_PPV_ARGS(&batch->commandAllocator));
+                    if (FAILED(result))
+                        Logger_ThrowError("FAILED", "Failed to create copy command allocator.", true);
+
+                    result = device->CreateCommandList(0, D3D12_COMMAND_LIST_TYPE_COPY, batch->commandAllocator.Get(), nullptr, IID_PPV_ARGS(&batch->commandList));
+                    if (FAILED(result))
+                        Logger_ThrowError("FAILED", "Failed to create copy command list.", true);
+
+                    batch->commandList->Close();
+
+                    openBatch = batch.get();
+                    batches.push_back(std::move(batch));
+                }
+
+                HRESULT result = openBatch->commandAllocator->Reset();
+                if (FAILED(result))
+                    Logger_ThrowError("FAILED", "Failed to reset copy command allocator.", true);
+
+                result = openBatch->commandList->Reset(openBatch->commandAllocator.Get(), nullptr);
+                if (FAILED(result))
+                    Logger_ThrowError("FAILED", "Failed to reset copy command list.", true);
+
+                return openBatch->commandList.Get();
+            }
+
+            UINT64 SubmitBatch()
+            {
+                if (!openBatch)
+                    return lastSubmittedValue;
+
+                HRESULT result = openBatch->commandList->Close();
+                if (FAILED(result))
+                    Logger_ThrowError("FAILED", "Failed to close copy command list.", true);
+
+                ID3D12CommandList* commandLists[] = { openBatch->commandList.Get() };
+                commandQueue->ExecuteCommandLists(_countof(commandLists), commandLists);
+
+                result = commandQueue->Signal(fence.Get(), nextFenceValue);
+                if (FAILED(result))
+                    Logger_ThrowError("FAILED", "Failed to signal copy fence.", true);
+
+                openBatch->fenceValue = nextFenceValue;
+                openBatch = nullptr;
+
+                ring.Close(nextFenceValue);
+
+                lastSubmittedValue = nextFenceValue++;
+
+                statistics.submissionCount++;
+
+                return lastSubmittedValue;
+            }
+
+            void Retire()
+            {
+                const UINT64 completedValue = fence->GetCompletedValue();
+
+                ring.Retire(completedValue);
+
+                std::erase_if(dedicatedBuffers, [completedValue](const DedicatedBuffer& buffer) { return buffer.fenceValue <= completedValue; });
+            }
+
+            void WaitForFenceValue(UINT64 value)
+            {
+                if (fence->GetCompletedValue() >= value)
+                    return;
+
+                HRESULT result = fence->SetEventOnCompletion(value, fenceEvent);
+                if (FAILED(result))
+                    Logger_ThrowError("FAILED", "Failed to set event on completion.", true);
+
+                WaitForSingleObject(fenceEvent, INFINITE);
+            }
+
+            ComPtr<ID3D12Device2> device;
+            ComPtr<ID3D12CommandQueue> commandQueue;
+            ComPtr<ID3D12Fence> fence;
+            HANDLE fenceEvent = nullptr;
+
+            UINT64 nextFenceValue = 1;
+            UINT64 lastSubmittedValue = 0;
+            UINT64 lastWaitedValue = 0;
+
+            RingAllocator ring;
+            ComPtr<ID3D12Resource> ringBuffer;
+            uchar* ringData = nullptr;
+
+            Vector<Unique<CommandBatch>> batches;
+            CommandBatch* openBatch = nullptr;
+
+            Vector<DedicatedBuffer> dedicatedBuffers;
+
+            UploadStatistics statistics;
+
+            Mutex mutex;
+        };
+	}
+}
\ No newline at end of file
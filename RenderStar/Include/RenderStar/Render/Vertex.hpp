@@ -16,14 +16,19 @@ namespace RenderStar
 			Vector3f normal;
 			Vector2f textureCoordinates;
 
-			static Array<D3D12_INPUT_ELEMENT_DESC, 4> GetInputLayout()
+			static const Array<D3D12_INPUT_ELEMENT_DESC, 9>& GetInputLayout()
 			{
-				static Array<D3D12_INPUT_ELEMENT_DESC, 4> out =
+				static Array<D3D12_INPUT_ELEMENT_DESC, 9> out =
 				{
 					D3D12_INPUT_ELEMENT_DESC{ "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
 					D3D12_INPUT_ELEMENT_DESC{ "COLOR", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 12, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
 					D3D12_INPUT_ELEMENT_DESC{ "NORMAL", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 24, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
-					D3D12_INPUT_ELEMENT_DESC{ "TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT, 0, 36, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 }
+					D3D12_INPUT_ELEMENT_DESC{ "TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT, 0, 36, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
+					D3D12_INPUT_ELEMENT_DESC{ "WORLD", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, 0, D3D12_INPUT_CLASSIFICATION_PER_INSTANCE_DATA, 1 },
+					D3D12_INPUT_ELEMENT_DESC{ "WORLD", 1, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, 16, D3D12_INPUT_CLASSIFICATION_PER_INSTANCE_DATA, 1 },
+					D3D12_INPUT_ELEMENT_DESC{ "WORLD", 2, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, 32, D3D12_INPUT_CLASSIFICATION_PER_INSTANCE_DATA, 1 },
+					D3D12_INPUT_ELEMENT_DESC{ "WORLD", 3, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, 48, D3D12_INPUT_CLASSIFICATION_PER_INSTANCE_DATA, 1 },
+					D3D12_INPUT_ELEMENT_DESC{ "TEXTUREINDEX", 0, DXGI_FORMAT_R32_UINT, 1, 64, D3D12_INPUT_CLASSIFICATION_PER_INSTANCE_DATA, 1 }
 				};
 
 				return out;
@@ -34,5 +39,12 @@ namespace RenderStar
 				return { position, color, normal, textureCoordinates };
 			}
 		};
+
+		struct InstanceData
+		{
+			Matrix4x4f world;
+
+			uint textureIndex;
+		};
 	}
 }
\ No newline at end of file
@@ -1,12 +1,20 @@
 #pragma once
 
+#include "RenderStar/Core/JobSystem.hpp"
 #include "RenderStar/Core/Logger.hpp"
+#include "RenderStar/Core/PoolAllocator.hpp"
 #include "RenderStar/Core/Settings.hpp"
+#include "RenderStar/Render/ConstantBufferAllocator.hpp"
 #include "RenderStar/ECS/GameObjectManager.hpp"
+#include "RenderStar/Render/GeometryBuffer.hpp"
 #include "RenderStar/Render/Mesh.hpp"
+#include "RenderStar/Render/PipelineStateCache.hpp"
 #include "RenderStar/Render/Renderer.hpp"
+#include "RenderStar/Render/RenderQueue.hpp"
+#include "RenderStar/Render/ShaderCompiler.hpp"
 #include "RenderStar/Render/ShaderManager.hpp"
 #include "RenderStar/Render/TextureManager.hpp"
+#include "RenderStar/Render/UploadQueue.hpp"
 #include "RenderStar/Util/CommonVersionFormat.hpp"
 
 using namespace RenderStar::Core;
@@ -26,6 +34,24 @@ namespace RenderStar
 			Settings::GetInstance()->Set<String>("defaultApplicationName", "RenderStar*");
 			Settings::GetInstance()->Set<CommonVersionFormat>("defaultApplicationVersion", CommonVersionFormat::Create(0, 0, 9));
 			Settings::GetInstance()->Set<Vector2i>("defaultWindowDimensions", { 750, 450 });
+			Settings::GetInstance()->Set<uint>("workerThreadCount", 0);
+			Settings::GetInstance()->Set<bool>("parallelUpdate", false);
+			Settings::GetInstance()->Set<uint>("parallelUpdateBatchSize", 64);
+			Settings::GetInstance()->Set<bool>("batchedComponentDispatch", true);
+			Settings::GetInstance()->Set<bool>("parallelRender", false);
+			Settings::GetInstance()->Set<uint>("parallelRenderBatchSize", 256);
+			Settings::GetInstance()->Set<bool>("automaticInstancing", true);
+			Settings::GetInstance()->Set<uint>("geometryBufferVertexCapacity", 65536);
+			Settings::GetInstance()->Set<uint>("geometryBufferIndexCapacity", 262144);
+			Settings::GetInstance()->Set<uint>("uploadRingSize", 33554432);
+			Settings::GetInstance()->Set<uint>("constantBufferPageSize", 2097152);
+			Settings::GetInstance()->Set<uint>("descriptorHeapSize", 65536);
+			Settings::GetInstance()->Set<uint>("transientDescriptorCount", 8192);
+			Settings::GetInstance()->Set<uint>("framesInFlight", 2);
+			Settings::GetInstance()->Set<String>("pipelineLibraryPath", "Cache/PipelineLibrary.bin");
+			Settings::GetInstance()->Set<String>("shaderCachePath", "Cache/Shaders");
+			Settings::GetInstance()->Set<bool>("headless", false);
+			Settings::GetInstance()->Set<uint>("frameTimingLogInterval", 0);
 			Settings::GetInstance()->Set<WNDPROC>("defaultWindowProceadure", [](HWND handle, UINT message, WPARAM wParam, LPARAM  lParam) -> LRESULT
 			{
 				switch (message)
@@ -68,14 +94,33 @@ namespace RenderStar
 		{
 			Logger_WriteConsole("RenderStar Engine Initialized.", LogLevel::INFORMATION);
 
+			JobSystem::GetInstance()->Initialize(Settings::GetInstance()->Get<uint>("workerThreadCount"));
+
 			Renderer::GetInstance()->Initialize();
 
+			UploadQueue::GetInstance()->Initialize();
+			GeometryBuffer::GetInstance()->Initialize();
+			ConstantBufferAllocator::GetInstance()->Initialize();
+			PipelineStateCache::GetInstance()->Initialize();
+			ShaderCompiler::GetInstance()->Initialize();
+
+			Renderer::GetInstance()->AddRenderFunction([]{ConstantBufferAllocator::GetInstance()->Reset(); });
 			Renderer::GetInstance()->AddRenderFunction([]{GameObjectManager::GetInstance()->Render(); });
+			Renderer::GetInstance()->AddRenderFunction([]{GeometryBuffer::GetInstance()->Flush(); });
+			Renderer::GetInstance()->AddRenderFunction([]{UploadQueue::GetInstance()->Flush(); });
+			Renderer::GetInstance()->AddRenderFunction([]{RenderQueue::GetInstance()->Flush(); });
 
-			ShaderManager::GetInstance()->Register(Shader::Create("default", "Shader/Default", RootSignature::Create({ RootSignatureParameter::Create(RootSignatureParameterType::SHADER_RESOURCE_VIEW, 0), RootSignatureParameter::Create(RootSignatureParameterType::SAMPLER, 0) })));
+			SystemRegistry::GetInstance()->SetParallelRecorder([](Size count, Size batchSize, const Function<void(Size, Size)>& record) { Renderer::GetInstance()->RecordParallel(count, batchSize, record); });
+
+			ShaderManager::GetInstance()->Register(Shader::Create("default", "Shader/Default", RootSignature::Create({ RootSignatureParameter::Create(RootSignatureParameterType::BINDLESS_SHADER_RESOURCE_VIEWS, 0), RootSignatureParameter::Create(RootSignatureParameterType::SAMPLER, 0) })));
 			TextureManager::GetInstance()->Register(Texture::Create("test", "Texture/Test.dds"));
 
-			Shared<GameObject> square = Mesh::CreateGameObject("square", "default", "test",
+			ShaderManager::GetInstance()->WaitAll();
+
+			ShaderCompiler::GetInstance()->LogStatistics();
+			PipelineStateCache::GetInstance()->LogStatistics();
+
+			GameObject* square = Mesh::CreateGameObject("square", "default", "test",
 			{
 				{ { -0.5f, -0.5f, 0.0f }, { 1.0f, 1.0f, 1.0f }, { 0.0f, 0.0f, 1.0f }, { 0.0f, 1.0f } },
 				{ {  0.5f, -0.5f, 0.0f }, { 1.0f, 1.0f, 1.0f }, { 0.0f, 0.0f, 1.0f }, { 1.0f, 1.0f } },
@@ -89,6 +134,8 @@ namespace RenderStar
 		static void Update()
 		{
 			GameObjectManager::GetInstance()->Update();
+
+			TransformSystem::GetInstance()->Update();
 		}
 
 		static void Render()
@@ -96,14 +143,42 @@ namespace RenderStar
 			Renderer::GetInstance()->Render();
 		}
 
+		static void RunHeadless(uint frameCount)
+		{
+			for (uint f = 0; f < frameCount; ++f)
+			{
+				Update();
+				Render();
+			}
+		}
+
 		static void CleanUp()
 		{
 			Logger_WriteConsole("RenderStar Engine Cleaned Up.", LogLevel::INFORMATION);
 
+			ShaderManager::GetInstance()->LogStatistics();
+			ShaderCompiler::GetInstance()->LogStatistics();
+
 			GameObjectManager::GetInstance()->CleanUp();
+
+			PoolRegistry::GetInstance()->LogStatistics();
+			GeometryBuffer::GetInstance()->LogStatistics();
+			UploadQueue::GetInstance()->LogStatistics();
+			ConstantBufferAllocator::GetInstance()->LogStatistics();
+			Renderer::GetInstance()->GetDescriptorHeap().LogStatistics("CBV/SRV/UAV");
+			Renderer::GetInstance()->GetSamplerHeap().LogStatistics("sampler");
+			Renderer::GetInstance()->GetRenderGraph().LogStatistics();
 			
+			RenderQueue::GetInstance()->CleanUp();
+			GeometryBuffer::GetInstance()->CleanUp();
+			UploadQueue::GetInstance()->CleanUp();
+			ConstantBufferAllocator::GetInstance()->CleanUp();
+			PipelineStateCache::GetInstance()->CleanUp();
+			ShaderCompiler::GetInstance()->CleanUp();
 			
 			Renderer::GetInstance()->CleanUp();
+
+			JobSystem::GetInstance()->Shutdown();
 		}
 	};
 }
\ No newline at end of file
@@ -66,7 +66,7 @@ namespace RenderStar
 
 		};
 
-		const CommonVersionFormat CommonVersionFormat::DEFAULT = CommonVersionFormat::Create(0, 0, 1);
-		const CommonVersionFormat CommonVersionFormat::NULL = CommonVersionFormat::Create(0, 0, 0);
+		inline const CommonVersionFormat CommonVersionFormat::DEFAULT = CommonVersionFormat::Create(0, 0, 1);
+		inline const CommonVersionFormat CommonVersionFormat::NULL = CommonVersionFormat::Create(0, 0, 0);
 	}
 }
\ No newline at end of file
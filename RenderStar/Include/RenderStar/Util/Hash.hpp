@@ -0,0 +1,52 @@
+#pragma once
+
+#include "RenderStar/Util/Typedefs.hpp"
+
+namespace RenderStar
+{
+	namespace Util
+	{
+		class Hash
+		{
+
+		public:
+
+			static constexpr ullong Seed = 14695981039346656037ull;
+
+			static ullong Combine(ullong hash, const void* data, Size size)
+			{
+				const uchar* bytes = static_cast<const uchar*>(data);
+
+				for (Size b = 0; b < size; ++b)
+				{
+					hash ^= bytes[b];
+					hash *= Prime;
+				}
+
+				return hash;
+			}
+
+			static ullong Combine(ullong hash, const String& value)
+			{
+				hash = Combine(hash, value.data(), value.size());
+
+				return Combine(hash, static_cast<ullong>(value.size()));
+			}
+
+			template<typename T>
+			static ullong Combine(ullong hash, const T& value) requires std::is_trivially_copyable_v<T>
+			{
+				return Combine(hash, &value, sizeof(T));
+			}
+
+			static String ToString(ullong hash)
+			{
+				return std::format("{:016x}", hash);
+			}
+
+		private:
+
+			static constexpr ullong Prime = 1099511628211ull;
+		};
+	}
+}
\ No newline at end of file
@@ -54,7 +54,7 @@ namespace RenderStar
                 return instance;
             }
 
-        private:
+        protected:
 
             UnorderedMap<String, Shared<T>> registeredObjects;
         };
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <Windows.h>
+#include "RenderStar/Util/Typedefs.hpp"
+
+using namespace RenderStar::Util;
+
+namespace RenderStar
+{
+	namespace Util
+	{
+		class MappedFile
+		{
+
+		public:
+
+			MappedFile() = default;
+
+			MappedFile(const MappedFile&) = delete;
+			MappedFile& operator=(const MappedFile&) = delete;
+
+			~MappedFile()
+			{
+				if (data)
+					UnmapViewOfFile(data);
+
+				if (mapping)
+					CloseHandle(mapping);
+
+				if (file != INVALID_HANDLE_VALUE)
+					CloseHandle(file);
+			}
+
+			const uchar* GetData() const
+			{
+				return data;
+			}
+
+			Size GetSize() const
+			{
+				return size;
+			}
+
+			bool IsValid() const
+			{
+				return data != nullptr;
+			}
+
+			static Shared<MappedFile> Create(const String& path)
+			{
+				Shared<MappedFile> out = std::make_shared<MappedFile>();
+
+				out->file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+
+				if (out->file == INVALID_HANDLE_VALUE)
+					return out;
+
+				LARGE_INTEGER fileSize = {};
+
+				if (!GetFileSizeEx(out->file, &fileSize) || fileSize.QuadPart == 0)
+					return out;
+
+				out->mapping = CreateFileMappingA(out->file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+				if (!out->mapping)
+					return out;
+
+				out->data = static_cast<const uchar*>(MapViewOfFile(out->mapping, FILE_MAP_READ, 0, 0, 0));
+				out->size = static_cast<Size>(fileSize.QuadPart);
+
+				return out;
+			}
+
+		private:
+
+			HANDLE file = INVALID_HANDLE_VALUE;
+			HANDLE mapping = nullptr;
+
+			const uchar* data = nullptr;
+			Size size = 0;
+		};
+	}
+}
\ No newline at end of file
@@ -2,6 +2,8 @@
 
 #include <d3dx12.h>
 #include "RenderStar/Render/Renderer.hpp"
+#include "RenderStar/Render/SortKey.hpp"
+#include "RenderStar/Util/Hash.hpp"
 #include "RenderStar/Util/Typedefs.hpp"
 
 using namespace DirectX;
@@ -15,7 +17,9 @@ namespace RenderStar
 		{
 			CONSTANT_BUFFER_VIEW,
 			SHADER_RESOURCE_VIEW,
-            SAMPLER
+            SAMPLER,
+            ROOT_CONSTANT_BUFFER_VIEW,
+            BINDLESS_SHADER_RESOURCE_VIEWS
 		};
 
         struct RootSignatureParameter
@@ -37,6 +41,12 @@ namespace RenderStar
 
             ComPtr<ID3D12RootSignature> Generate()
             {
+                if (Renderer::GetInstance()->IsHeadless())
+                    return nullptr;
+
+                if (rootSignature)
+                    return rootSignature;
+
                 for (const auto& parameter : rootParameters)
                 {
                     CD3DX12_DESCRIPTOR_RANGE1 descriptorRange;
@@ -55,16 +65,27 @@ namespace RenderStar
                     case RootSignatureParameterType::SAMPLER:
                         descriptorRange.Init(D3D12_DESCRIPTOR_RANGE_TYPE_SAMPLER, 1, parameter.slot);
                         break;
+
+                    case RootSignatureParameterType::ROOT_CONSTANT_BUFFER_VIEW:
+                        break;
+
+                    case RootSignatureParameterType::BINDLESS_SHADER_RESOURCE_VIEWS:
+                        descriptorRange.Init(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, UINT_MAX, parameter.slot, 1, D3D12_DESCRIPTOR_RANGE_FLAG_DESCRIPTORS_VOLATILE);
+                        break;
                     }
 
                     descriptorRanges.push_back(descriptorRange);
 
                     rootParametersDescriptors.emplace_back();
-                    rootParametersDescriptors.back().InitAsDescriptorTable(1, &descriptorRanges.back());
                 }
 
                 for (int r = 0; r < rootParameters.size(); ++r)
-                    rootParametersDescriptors[r].InitAsDescriptorTable(1, &descriptorRanges[r]);
+                {
+                    if (rootParameters[r].type == RootSignatureParameterType::ROOT_CONSTANT_BUFFER_VIEW)
+                        rootParametersDescriptors[r].InitAsConstantBufferView(rootParameters[r].slot, 0, D3D12_ROOT_DESCRIPTOR_FLAG_DATA_STATIC_WHILE_SET_AT_EXECUTE);
+                    else
+                        rootParametersDescriptors[r].InitAsDescriptorTable(1, &descriptorRanges[r]);
+                }
 
                 CD3DX12_VERSIONED_ROOT_SIGNATURE_DESC versionedRootSignatureDescription;
 
@@ -89,7 +110,6 @@ namespace RenderStar
                     throw std::runtime_error("Failed to serialize root signature.");
                 }
 
-                ComPtr<ID3D12RootSignature> rootSignature;
                 result = Renderer::GetInstance()->GetDevice()->CreateRootSignature(0, serializedRootSignature->GetBufferPointer(), serializedRootSignature->GetBufferSize(), IID_PPV_ARGS(&rootSignature));
 
                 if (FAILED(result))
@@ -98,10 +118,32 @@ namespace RenderStar
                 return rootSignature;
             }
 
+            Optional<UINT> FindParameter(RootSignatureParameterType type) const
+            {
+                for (UINT p = 0; p < rootParameters.size(); ++p)
+                {
+                    if (rootParameters[p].type == type)
+                        return p;
+                }
+
+                return std::nullopt;
+            }
+
+            uint GetSortId() const
+            {
+                return sortId;
+            }
+
+            ullong GetHash() const
+            {
+                return hash;
+            }
+
             static Shared<RootSignature> Create(const Vector<RootSignatureParameter>& parameters, const Vector<CD3DX12_STATIC_SAMPLER_DESC>& samplers = {})
             {
                 Shared<RootSignature> out = std::make_shared<RootSignature>();
 
+                out->sortId = SortKey::AllocateId();
                 out->Initialize(parameters, samplers);
 
                 return out;
@@ -113,12 +155,28 @@ namespace RenderStar
             {
                 rootParameters = parameters;
                 staticSamplers = samplers;
+
+                hash = Hash::Combine(Hash::Seed, static_cast<ullong>(rootParameters.size()));
+
+                for (const RootSignatureParameter& parameter : rootParameters)
+                {
+                    hash = Hash::Combine(hash, parameter.type);
+                    hash = Hash::Combine(hash, parameter.slot);
+                }
+
+                for (const D3D12_STATIC_SAMPLER_DESC& sampler : staticSamplers)
+                    hash = Hash::Combine(hash, sampler);
             }
 
             Vector<RootSignatureParameter> rootParameters;
             Vector<CD3DX12_DESCRIPTOR_RANGE1> descriptorRanges;
             Vector<CD3DX12_ROOT_PARAMETER1> rootParametersDescriptors;
             Vector<CD3DX12_STATIC_SAMPLER_DESC> staticSamplers;
+
+            ComPtr<ID3D12RootSignature> rootSignature;
+
+            uint sortId = 0;
+            ullong hash = 0;
         };
 	}
 }
\ No newline at end of file
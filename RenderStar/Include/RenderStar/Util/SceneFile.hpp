@@ -0,0 +1,327 @@
+#pragma once
+
+#include "RenderStar/Core/Logger.hpp"
+#include "RenderStar/Util/MappedFile.hpp"
+#include "RenderStar/Util/Typedefs.hpp"
+
+using namespace RenderStar::Core;
+using namespace RenderStar::Util;
+
+namespace RenderStar
+{
+	namespace Util
+	{
+		static constexpr uint SceneMagic = 0x43535352;
+		static constexpr uint SceneVersion = 1;
+		static constexpr uint InvalidSceneIndex = ~0u;
+
+		struct SceneHeader
+		{
+			uint magic;
+			uint version;
+			uint stringCount;
+			uint entityCount;
+			uint meshCount;
+			uint reserved;
+
+			ullong stringTableOffset;
+			ullong entityTableOffset;
+			ullong meshTableOffset;
+			ullong fileSize;
+		};
+
+		struct SceneString
+		{
+			ullong offset;
+			uint length;
+			uint reserved;
+		};
+
+		struct SceneEntity
+		{
+			uint name;
+			uint parent;
+			uint mesh;
+			uint isActive;
+
+			Vector3f position;
+			Vector3f rotation;
+			Vector3f scale;
+		};
+
+		struct SceneMesh
+		{
+			uint name;
+			uint shader;
+			uint texture;
+			uint vertexStride;
+			uint vertexCount;
+			uint indexCount;
+
+			ullong vertexOffset;
+			ullong indexOffset;
+		};
+
+		class SceneFile
+		{
+
+		public:
+
+			const SceneHeader& GetHeader() const
+			{
+				return *header;
+			}
+
+			Span<const SceneEntity> GetEntities() const
+			{
+				return { entities, header->entityCount };
+			}
+
+			Span<const SceneMesh> GetMeshes() const
+			{
+				return { meshes, header->meshCount };
+			}
+
+			String GetString(uint index) const
+			{
+				if (index >= header->stringCount)
+					return "";
+
+				return String(reinterpret_cast<const char*>(file->GetData() + strings[index].offset), strings[index].length);
+			}
+
+			template<typename T>
+			const T* GetData(ullong offset) const
+			{
+				return reinterpret_cast<const T*>(file->GetData() + offset);
+			}
+
+			static Shared<SceneFile> Open(const String& path)
+			{
+				Shared<SceneFile> out = std::make_shared<SceneFile>();
+
+				out->file = MappedFile::Create(path);
+
+				if (!out->file->IsValid())
+				{
+					Logger_ThrowError("FAILED", "Failed to map scene file '" + path + "'", false);
+					return nullptr;
+				}
+
+				if (!out->Resolve())
+				{
+					Logger_ThrowError("FAILED", "Scene file '" + path + "' is corrupt or has an unsupported version", false);
+					return nullptr;
+				}
+
+				return out;
+			}
+
+		private:
+
+			bool IsInBounds(ullong offset, ullong count, ullong stride) const
+			{
+				return offset <= file->GetSize() && count <= (file->GetSize() - offset) / std::max<ullong>(stride, 1);
+			}
+
+			bool Resolve()
+			{
+				if (!IsInBounds(0, 1, sizeof(SceneHeader)))
+					return false;
+
+				header = GetData<SceneHeader>(0);
+
+				if (header->magic != SceneMagic || header->version != SceneVersion || header->fileSize != file->GetSize())
+					return false;
+
+				if (!IsInBounds(header->stringTableOffset, header->stringCount, sizeof(SceneString)) || !IsInBounds(header->entityTableOffset, header->entityCount, sizeof(SceneEntity)) || !IsInBounds(header->meshTableOffset, header->meshCount, sizeof(SceneMesh)))
+					return false;
+
+				if (header->stringTableOffset % alignof(SceneString) || header->entityTableOffset % alignof(SceneEntity) || header->meshTableOffset % alignof(SceneMesh))
+					return false;
+
+				strings = GetData<SceneString>(header->stringTableOffset);
+				entities = GetData<SceneEntity>(header->entityTableOffset);
+				meshes = GetData<SceneMesh>(header->meshTableOffset);
+
+				for (uint s = 0; s < header->stringCount; ++s)
+				{
+					if (!IsInBounds(strings[s].offset, strings[s].length, 1))
+						return false;
+				}
+
+				for (uint m = 0; m < header->meshCount; ++m)
+				{
+					const SceneMesh& mesh = meshes[m];
+
+					if (mesh.name >= header->stringCount || mesh.shader >= header->stringCount || mesh.texture >= header->stringCount)
+						return false;
+
+					if (!IsInBounds(mesh.vertexOffset, mesh.vertexCount, mesh.vertexStride) || !IsInBounds(mesh.indexOffset, mesh.indexCount, sizeof(uint)) || mesh.vertexOffset % alignof(float) || mesh.indexOffset % alignof(uint))
+						return false;
+				}
+
+				for (uint e = 0; e < header->entityCount; ++e)
+				{
+					const SceneEntity& entity = entities[e];
+
+					if (entity.name >= header->stringCount || (entity.parent != InvalidSceneIndex && entity.parent >= e) || (entity.mesh != InvalidSceneIndex && entity.mesh >= header->meshCount))
+						return false;
+				}
+
+				return true;
+			}
+
+			Shared<MappedFile> file;
+
+			const SceneHeader* header = nullptr;
+			const SceneString* strings = nullptr;
+			const SceneEntity* entities = nullptr;
+			const SceneMesh* meshes = nullptr;
+		};
+
+		class SceneFileWriter
+		{
+
+		public:
+
+			uint AddString(const String& value)
+			{
+				auto iterator = stringIndices.find(value);
+
+				if (iterator != stringIndices.end())
+					return iterator->second;
+
+				const uint index = static_cast<uint>(strings.size());
+
+				strings.push_back(value);
+				stringIndices.emplace(value, index);
+
+				return index;
+			}
+
+			uint AddMesh(const String& name, const String& shader, const String& texture, const void* vertices, uint vertexCount, uint vertexStride, const uint* indices, uint indexCount)
+			{
+				SceneMesh mesh = {};
+
+				mesh.name = AddString(name);
+				mesh.shader = AddString(shader);
+				mesh.texture = AddString(texture);
+				mesh.vertexStride = vertexStride;
+				mesh.vertexCount = vertexCount;
+				mesh.indexCount = indexCount;
+				mesh.vertexOffset = AppendData(vertices, static_cast<Size>(vertexCount) * vertexStride);
+				mesh.indexOffset = AppendData(indices, static_cast<Size>(indexCount) * sizeof(uint));
+
+				meshes.push_back(mesh);
+
+				return static_cast<uint>(meshes.size() - 1);
+			}
+
+			uint AddEntity(const SceneEntity& entity)
+			{
+				entities.push_back(entity);
+
+				return static_cast<uint>(entities.size() - 1);
+			}
+
+			bool Write(const String& path)
+			{
+				SceneHeader header = {};
+
+				header.magic = SceneMagic;
+				header.version = SceneVersion;
+				header.stringCount = static_cast<uint>(strings.size());
+				header.entityCount = static_cast<uint>(entities.size());
+				header.meshCount = static_cast<uint>(meshes.size());
+
+				ullong offset = Align(sizeof(SceneHeader));
+
+				header.stringTableOffset = offset;
+				offset = Align(offset + strings.size() * sizeof(SceneString));
+
+				header.entityTableOffset = offset;
+				offset = Align(offset + entities.size() * sizeof(SceneEntity));
+
+				header.meshTableOffset = offset;
+				offset = Align(offset + meshes.size() * sizeof(SceneMesh));
+
+				const ullong dataOffset = offset;
+
+				Vector<SceneString> stringTable(strings.size());
+				ullong stringOffset = dataOffset + data.size();
+
+				for (Size s = 0; s < strings.size(); ++s)
+				{
+					stringTable[s] = { stringOffset, static_cast<uint>(strings[s].size()), 0 };
+					stringOffset += strings[s].size();
+				}
+
+				Vector<SceneMesh> meshTable = meshes;
+
+				for (SceneMesh& mesh : meshTable)
+				{
+					mesh.vertexOffset += dataOffset;
+					mesh.indexOffset += dataOffset;
+				}
+
+				header.fileSize = stringOffset;
+
+				OutputFileStream stream(path, std::ios::binary | std::ios::trunc);
+
+				if (!stream.is_open())
+				{
+					Logger_ThrowError("FAILED", "Failed to open scene file '" + path + "' for writing", false);
+					return false;
+				}
+
+				WritePadded(stream, &header, sizeof(SceneHeader), header.stringTableOffset);
+				WritePadded(stream, stringTable.data(), stringTable.size() * sizeof(SceneString), header.entityTableOffset - header.stringTableOffset);
+				WritePadded(stream, entities.data(), entities.size() * sizeof(SceneEntity), header.meshTableOffset - header.entityTableOffset);
+				WritePadded(stream, meshTable.data(), meshTable.size() * sizeof(SceneMesh), dataOffset - header.meshTableOffset);
+
+				stream.write(reinterpret_cast<const char*>(data.data()), static_cast<StreamSize>(data.size()));
+
+				for (const String& value : strings)
+					stream.write(value.data(), static_cast<StreamSize>(value.size()));
+
+				return stream.good();
+			}
+
+		private:
+
+			static ullong Align(ullong value)
+			{
+				return (value + 15) & ~15ull;
+			}
+
+			static void WritePadded(OutputFileStream& stream, const void* source, Size size, ullong paddedSize)
+			{
+				static const char padding[16] = {};
+
+				stream.write(static_cast<const char*>(source), static_cast<StreamSize>(size));
+				stream.write(padding, static_cast<StreamSize>(paddedSize - size));
+			}
+
+			ullong AppendData(const void* source, Size size)
+			{
+				const ullong offset = Align(data.size());
+
+				data.resize(offset + size);
+
+				if (size > 0)
+					memcpy(data.data() + offset, source, size);
+
+				return offset;
+			}
+
+			Vector<String> strings;
+			UnorderedMap<String, uint> stringIndices;
+
+			Vector<SceneEntity> entities;
+			Vector<SceneMesh> meshes;
+
+			Vector<uchar> data;
+		};
+	}
+}
\ No newline at end of file
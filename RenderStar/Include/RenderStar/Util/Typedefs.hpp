@@ -21,13 +21,17 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <set>
 #include <unordered_map>
 #include <functional>
 #include <any>
 #include <exception>
 #include <array>
+#include <span>
+#include <optional>
 #include <format>
 #include <list>
+#include <deque>
 #include <regex>
 #include <typeindex>
 #include <filesystem>
@@ -114,6 +118,7 @@ namespace RenderStar
 		typedef std::filesystem::directory_entry DirectoryEntry;
 		typedef std::filesystem::file_status FileStatus;
 		typedef std::filesystem::file_type FileType;
+		typedef std::filesystem::file_time_type FileTime;
 
 		typedef std::random_device RandomDevice;
 		typedef std::mt19937 RandomEngine;
@@ -146,9 +151,15 @@ namespace RenderStar
 		template<typename T>
 		using Vector = std::vector<T>;
 
+		template<typename T>
+		using Deque = std::deque<T>;
+
 		template<typename T, typename A>
 		using Map = std::map<T, A>;
 
+		template<typename T>
+		using Set = std::set<T>;
+
 		template<typename T, typename A>
 		using UnorderedMap = std::unordered_map<T, A>;
 
@@ -158,6 +169,12 @@ namespace RenderStar
 		template<typename T, size_t S>
 		using Array = std::array<T, S>;
 
+		template<typename T>
+		using Span = std::span<T>;
+
+		template<typename T>
+		using Optional = std::optional<T>;
+
 		template<class... _Args>
 		using FormatString = std::basic_format_string<char, std::type_identity_t<_Args>...>;
 
@@ -0,0 +1,198 @@
+#include "Test.hpp"
+
+using namespace RenderStar::ECS;
+
+class MarkerComponent : public Component
+{
+
+public:
+
+    uint value = 0;
+};
+
+class ChurnComponent : public Component
+{
+
+public:
+
+    void Update() override
+    {
+        Shared<GameObjectManager> manager = GameObjectManager::GetInstance();
+
+        observedCounts.push_back(manager->GetCount());
+
+        const Entity spawned = manager->CreateDeferred("spawned");
+
+        manager->GetCommandBuffer().AddComponent<MarkerComponent>(spawned, std::make_shared<MarkerComponent>());
+        manager->GetCommandBuffer().AddComponent<MarkerComponent>(entity, std::make_shared<MarkerComponent>());
+
+        if (entity.index % 2 == 1)
+            manager->Remove(entity);
+    }
+
+    bool IsThreadSafe() const override
+    {
+        return false;
+    }
+
+    static Vector<Size> observedCounts;
+};
+
+Vector<Size> ChurnComponent::observedCounts;
+
+Test_Case(StructuralChangesDuringUpdateAreDeferred)
+{
+    Shared<GameObjectManager> manager = GameObjectManager::GetInstance();
+
+    constexpr Size ObjectCount = 4000;
+
+    Vector<Entity> entities;
+
+    for (Size n = 0; n < ObjectCount; ++n)
+    {
+        GameObject* gameObject = manager->Create("churn");
+        gameObject->AddComponent(std::make_shared<ChurnComponent>());
+
+        entities.push_back(gameObject->GetEntity());
+    }
+
+    const Size countBefore = manager->GetCount();
+
+    ChurnComponent::observedCounts.clear();
+
+    manager->Update();
+
+    Test_Assert(ChurnComponent::observedCounts.size() == ObjectCount);
+
+    for (Size count : ChurnComponent::observedCounts)
+        Test_Assert(count == countBefore);
+
+    Size removedCount = 0;
+
+    for (const Entity& entity : entities)
+    {
+        GameObject* gameObject = manager->Get(entity);
+
+        if (entity.index % 2 == 1)
+        {
+            Test_Assert(gameObject == nullptr);
+            removedCount++;
+        }
+        else
+            Test_Assert(gameObject && gameObject->HasComponent<MarkerComponent>() && gameObject->HasComponent<ChurnComponent>());
+    }
+
+    Size spawnedCount = 0;
+
+    for (GameObject* gameObject : manager->GetGameObjects())
+    {
+        if (gameObject->name != "spawned")
+            continue;
+
+        Test_Assert(gameObject->HasComponent<MarkerComponent>() && gameObject->HasComponent<Transform>());
+        spawnedCount++;
+    }
+
+    Test_Assert(spawnedCount == ObjectCount);
+    Test_Assert(manager->GetCount() == countBefore - removedCount + ObjectCount);
+    Test_Assert(manager->GetCommandBuffer().IsEmpty());
+}
+
+Test_Case(ThreadLocalBuffersPlayBackTogether)
+{
+    Shared<GameObjectManager> manager = GameObjectManager::GetInstance();
+
+    constexpr Size ObjectCount = 10000;
+
+    Vector<Entity> entities(ObjectCount);
+
+    const Size countBefore = manager->GetCount();
+
+    JobSystem::GetInstance()->ParallelFor(ObjectCount, 64, [&](Size begin, Size end)
+    {
+        for (Size n = begin; n < end; ++n)
+        {
+            entities[n] = manager->CreateDeferred("parallel");
+            manager->GetCommandBuffer().AddComponent<MarkerComponent>(entities[n], std::make_shared<MarkerComponent>());
+        }
+    });
+
+    Test_Assert(manager->GetCount() == countBefore);
+
+    manager->FlushCommandBuffers();
+
+    Test_Assert(manager->GetCount() == countBefore + ObjectCount);
+
+    Vector<Entity> sorted = entities;
+
+    std::sort(sorted.begin(), sorted.end(), [](const Entity& a, const Entity& b) { return a.GetValue() < b.GetValue(); });
+
+    Test_Assert(std::adjacent_find(sorted.begin(), sorted.end()) == sorted.end());
+
+    for (const Entity& entity : entities)
+    {
+        GameObject* gameObject = manager->Get(entity);
+
+        Test_Assert(gameObject && gameObject->HasComponent<MarkerComponent>());
+    }
+}
+
+Test_Case(AddThenRemoveInOneFrameCancels)
+{
+    Shared<GameObjectManager> manager = GameObjectManager::GetInstance();
+
+    GameObject* gameObject = manager->Create("cancel");
+    const Entity entity = gameObject->GetEntity();
+
+    World::GetInstance()->SetDeferringStructuralChanges(true);
+
+    gameObject->AddComponent(std::make_shared<MarkerComponent>());
+    gameObject->RemoveComponent<MarkerComponent>();
+
+    Test_Assert(!gameObject->HasComponent<MarkerComponent>());
+
+    World::GetInstance()->SetDeferringStructuralChanges(false);
+
+    manager->FlushCommandBuffers();
+
+    Test_Assert(manager->Get(entity) == gameObject);
+    Test_Assert(!gameObject->HasComponent<MarkerComponent>());
+}
+
+Test_Benchmark(StructuralChangesPerFrame)
+{
+    Shared<GameObjectManager> manager = GameObjectManager::GetInstance();
+
+    constexpr Size ObjectCount = 10000;
+    constexpr Size Frames = 100;
+
+    Vector<GameObject*> gameObjects;
+
+    for (Size n = 0; n < ObjectCount; ++n)
+        gameObjects.push_back(manager->Create("object"));
+
+    const double time = TestRegistry::Measure([&]
+    {
+        for (Size frame = 0; frame < Frames; ++frame)
+        {
+            World::GetInstance()->SetDeferringStructuralChanges(true);
+
+            for (GameObject* gameObject : gameObjects)
+            {
+                if (frame % 2 == 0)
+                    gameObject->AddComponent(std::make_shared<MarkerComponent>());
+                else
+                    gameObject->RemoveComponent<MarkerComponent>();
+            }
+
+            World::GetInstance()->SetDeferringStructuralChanges(false);
+
+            manager->FlushCommandBuffers();
+        }
+    });
+
+    for (GameObject* gameObject : gameObjects)
+        Test_Assert(!gameObject->HasComponent<MarkerComponent>());
+
+    TestRegistry::Report("Structural changes per frame (" + std::to_string(ObjectCount) + " changes)", time / Frames, "ms");
+}
\ No newline at end of file
@@ -0,0 +1,114 @@
+#include "Test.hpp"
+
+using namespace RenderStar::Render;
+
+struct alignas(16) ObjectConstants
+{
+    float tint[4];
+    float parameters[12];
+};
+
+Test_Case(ConstantAllocationsAreAlignedAndHoldTheirData)
+{
+    Shared<ConstantBufferAllocator> allocator = ConstantBufferAllocator::GetInstance();
+
+    allocator->Reset();
+
+    const ConstantAllocation first = allocator->Allocate(4);
+    const ConstantAllocation second = allocator->Allocate(ConstantBufferAllocator::Alignment + 1);
+    const ConstantAllocation third = allocator->Allocate(sizeof(ObjectConstants));
+
+    Test_Assert(first.gpuAddress % ConstantBufferAllocator::Alignment == 0);
+    Test_Assert(second.gpuAddress % ConstantBufferAllocator::Alignment == 0);
+    Test_Assert(third.gpuAddress % ConstantBufferAllocator::Alignment == 0);
+    Test_Assert(second.gpuAddress - first.gpuAddress == ConstantBufferAllocator::Alignment);
+    Test_Assert(third.gpuAddress - second.gpuAddress == 2 * ConstantBufferAllocator::Alignment);
+
+    ObjectConstants constants = {};
+    constants.tint[0] = 0.5f;
+    constants.parameters[11] = 2.0f;
+
+    const D3D12_GPU_VIRTUAL_ADDRESS address = allocator->Push(constants);
+
+    Test_Assert(address % ConstantBufferAllocator::Alignment == 0);
+    Test_Assert(address > third.gpuAddress);
+
+    const ObjectConstants* written = reinterpret_cast<const ObjectConstants*>(static_cast<const uchar*>(third.data) + (address - third.gpuAddress));
+
+    Test_Assert(written->tint[0] == 0.5f && written->parameters[11] == 2.0f);
+}
+
+Test_Case(ParallelPushesNeverShareMemory)
+{
+    Shared<ConstantBufferAllocator> allocator = ConstantBufferAllocator::GetInstance();
+
+    constexpr Size Count = 20000;
+
+    Vector<D3D12_GPU_VIRTUAL_ADDRESS> addresses(Count);
+
+    allocator->Reset();
+
+    JobSystem::GetInstance()->ParallelFor(Count, 256, [&](Size begin, Size end)
+    {
+        for (Size n = begin; n < end; ++n)
+        {
+            ObjectConstants constants = {};
+            constants.tint[0] = static_cast<float>(n);
+
+            addresses[n] = allocator->Push(constants);
+        }
+    });
+
+    std::sort(addresses.begin(), addresses.end());
+
+    for (Size n = 1; n < Count; ++n)
+        Test_Assert(addresses[n] - addresses[n - 1] >= sizeof(ObjectConstants));
+}
+
+Test_Benchmark(ConstantBufferPushCost)
+{
+    Shared<ConstantBufferAllocator> allocator = ConstantBufferAllocator::GetInstance();
+
+    constexpr Size Count = 100000;
+    constexpr Size Frames = 50;
+
+    ObjectConstants constants = {};
+
+    const double serialTime = TestRegistry::Measure([&]
+    {
+        for (Size frame = 0; frame < Frames; ++frame)
+        {
+            allocator->Reset();
+
+            for (Size n = 0; n < Count; ++n)
+            {
+                constants.tint[0] = static_cast<float>(n);
+
+                allocator->Push(constants);
+            }
+        }
+    });
+
+    const double parallelTime = TestRegistry::Measure([&]
+    {
+        for (Size frame = 0; frame < Frames; ++frame)
+        {
+            allocator->Reset();
+
+            JobSystem::GetInstance()->ParallelFor(Count, 1024, [&](Size begin, Size end)
+            {
+                ObjectConstants local = {};
+
+                for (Size n = begin; n < end; ++n)
+                {
+                    local.tint[0] = static_cast<float>(n);
+
+                    allocator->Push(local);
+                }
+            });
+        }
+    });
+
+    TestRegistry::Report("Constant buffer push, serial", serialTime * 1000000.0 / (Count * Frames), "ns per allocation");
+    TestRegistry::Report("Constant buffer push, parallel", parallelTime * 1000000.0 / (Count * Frames), "ns per allocation");
+}
\ No newline at end of file
@@ -0,0 +1,106 @@
+#include "Test.hpp"
+
+using namespace RenderStar::Render;
+
+Test_Case(PersistentDescriptorsAreFreedAfterFramesInFlight)
+{
+    DescriptorHeap heap;
+    heap.Initialize(nullptr, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, 64, 32, 2);
+
+    Test_Assert(heap.GetCapacity() == 96);
+
+    const DescriptorAllocation first = heap.AllocatePersistent(10);
+    const DescriptorAllocation second = heap.AllocatePersistent(20);
+    const DescriptorAllocation third = heap.AllocatePersistent(34);
+
+    Test_Assert(first.index == 0 && second.index == 10 && third.index == 30);
+
+    heap.BeginFrame(0, 0);
+    heap.FreePersistent(second);
+    heap.BeginFrame(1, 1);
+
+    Test_Assert(heap.GetStatistics().persistent.usedSize == 64);
+
+    heap.BeginFrame(0, 2);
+
+    Test_Assert(heap.GetStatistics().persistent.usedSize == 44);
+    Test_Assert(heap.AllocatePersistent(20).index == 10);
+}
+
+Test_Case(TransientDescriptorsUseOneRangePerFrame)
+{
+    DescriptorHeap heap;
+    heap.Initialize(nullptr, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, 64, 32, 2);
+
+    heap.BeginFrame(1, 0);
+
+    Test_Assert(heap.AllocateTransient(8).index == 64 + 16);
+    Test_Assert(heap.AllocateTransient(8).index == 64 + 24);
+
+    heap.BeginFrame(0, 1);
+
+    Test_Assert(heap.AllocateTransient(16).index == 64);
+
+    heap.BeginFrame(1, 2);
+
+    Test_Assert(heap.AllocateTransient(16).index == 64 + 16);
+    Test_Assert(heap.GetStatistics().peakTransientCount == 16);
+}
+
+Test_Case(DescriptorHeapIsBoundOncePerCommandList)
+{
+    if (!ShaderManager::GetInstance()->Get("descriptorBindless"))
+    {
+        Shared<RootSignature> bindless = RootSignature::Create({ RootSignatureParameter::Create(RootSignatureParameterType::BINDLESS_SHADER_RESOURCE_VIEWS, 0) });
+        Shared<RootSignature> bound = RootSignature::Create({ RootSignatureParameter::Create(RootSignatureParameterType::SHADER_RESOURCE_VIEW, 0) });
+
+        ShaderManager::GetInstance()->Register(Shader::Create("descriptorBindless", "Shader/Default", bindless));
+        ShaderManager::GetInstance()->Register(Shader::Create("descriptorBound", "Shader/Default", bound));
+        ShaderManager::GetInstance()->WaitAll();
+    }
+
+    Shared<MeshGeometry> geometry = MeshGeometry::Create({ { { 0.0f, 0.0f, 0.0f }, { 1.0f, 1.0f, 1.0f }, { 0.0f, 0.0f, 1.0f }, { 0.0f, 1.0f } } }, { 0, 0, 0 });
+
+    constexpr Size Count = 2000;
+
+    for (Size n = 0; n < Count; ++n)
+    {
+        GameObject* gameObject = GameObjectManager::GetInstance()->Create("descriptorMesh" + std::to_string(n));
+
+        gameObject->AddComponent(ShaderManager::GetInstance()->Get(n % 2 ? "descriptorBindless" : "descriptorBound"));
+        gameObject->AddComponent(TextureManager::GetInstance()->Get("test"));
+        gameObject->AddComponent(Mesh::Create("descriptorMesh", geometry))->Generate();
+    }
+
+    RenderStar::RenderStarEngine::RunHeadless(2);
+
+    const FrameStatistics& statistics = Renderer::GetInstance()->GetFrameStatistics();
+
+    Test_Assert(RenderQueue::GetInstance()->GetStatistics().itemCount == Count);
+    Test_Assert(statistics.descriptorHeapBindCount == statistics.commandListCount);
+}
+
+Test_Benchmark(TransientDescriptorAllocationCost)
+{
+    DescriptorHeap heap;
+    heap.Initialize(nullptr, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, 1024, 2 * 1000000, 2);
+
+    constexpr Size Count = 100000;
+    constexpr Size Frames = 20;
+
+    const double time = TestRegistry::Measure([&]
+    {
+        for (Size frame = 0; frame < Frames; ++frame)
+        {
+            heap.BeginFrame(static_cast<UINT>(frame % 2), frame);
+
+            JobSystem::GetInstance()->ParallelFor(Count, 1024, [&](Size begin, Size end)
+            {
+                for (Size n = begin; n < end; ++n)
+                    heap.AllocateTransient(4);
+            });
+        }
+    });
+
+    TestRegistry::Report("Transient descriptor allocation", time * 1000000.0 / (Count * Frames), "ns per allocation");
+}
\ No newline at end of file
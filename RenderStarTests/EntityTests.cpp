@@ -0,0 +1,334 @@
+#include "Test.hpp"
+
+using namespace RenderStar::ECS;
+
+struct Velocity
+{
+    Vector3f value;
+};
+
+class HealthComponent : public Component
+{
+
+public:
+
+    float value = 1.0f;
+};
+
+class CountedCleanUpComponent : public Component
+{
+
+public:
+
+    void CleanUp() override
+    {
+        cleanUpCount++;
+    }
+
+    static Size cleanUpCount;
+};
+
+Size CountedCleanUpComponent::cleanUpCount = 0;
+
+Test_Case(DestroyedEntitiesAreDetected)
+{
+    Shared<GameObjectManager> manager = GameObjectManager::GetInstance();
+
+    GameObject* first = manager->Create("first");
+    const Entity firstEntity = first->GetEntity();
+
+    manager->Remove(firstEntity);
+
+    Test_Assert(!manager->IsValid(firstEntity));
+    Test_Assert(!World::GetInstance()->IsValid(firstEntity));
+    Test_Assert(manager->Get("first") == nullptr);
+
+    GameObject* second = manager->Create("second");
+    const Entity secondEntity = second->GetEntity();
+
+    Test_Assert(secondEntity.index == firstEntity.index);
+    Test_Assert(secondEntity.generation != firstEntity.generation);
+    Test_Assert(manager->Get(firstEntity) == nullptr);
+    Test_Assert(manager->Get(secondEntity) == second);
+}
+
+Test_Case(RemovingParentRemovesChildren)
+{
+    Shared<GameObjectManager> manager = GameObjectManager::GetInstance();
+
+    GameObject* parent = manager->Create("parent");
+    GameObject* child = manager->Create("child");
+    GameObject* grandchild = manager->Create("grandchild");
+
+    parent->AddChild(child);
+    child->AddChild(grandchild);
+
+    const Entity childEntity = child->GetEntity();
+    const Entity grandchildEntity = grandchild->GetEntity();
+
+    Test_Assert(parent->GetChild("child") == child);
+    Test_Assert(grandchild->GetParent() == child);
+
+    manager->Remove(parent->GetEntity());
+
+    Test_Assert(!manager->IsValid(childEntity));
+    Test_Assert(!manager->IsValid(grandchildEntity));
+}
+
+Test_Case(SharedComponentsAreCleanedUpByTheirLastOwner)
+{
+    Shared<GameObjectManager> manager = GameObjectManager::GetInstance();
+
+    CountedCleanUpComponent::cleanUpCount = 0;
+
+    GameObject* first = manager->Create("first");
+    GameObject* second = manager->Create("second");
+
+    Shared<CountedCleanUpComponent> shared = std::make_shared<CountedCleanUpComponent>();
+
+    first->AddComponent(shared);
+    second->AddComponent(shared);
+
+    shared.reset();
+
+    manager->Remove(first->GetEntity());
+
+    Test_Assert(CountedCleanUpComponent::cleanUpCount == 0);
+
+    second->RemoveComponent<CountedCleanUpComponent>();
+
+    Test_Assert(CountedCleanUpComponent::cleanUpCount == 1);
+
+    GameObject* third = manager->Create("third");
+
+    third->AddComponent(std::make_shared<CountedCleanUpComponent>());
+
+    World::GetInstance()->SetDeferringStructuralChanges(true);
+    third->RemoveComponent<CountedCleanUpComponent>();
+    World::GetInstance()->SetDeferringStructuralChanges(false);
+
+    Test_Assert(CountedCleanUpComponent::cleanUpCount == 1);
+
+    manager->FlushCommandBuffers();
+
+    Test_Assert(CountedCleanUpComponent::cleanUpCount == 2);
+    Test_Assert(!third->HasComponent<CountedCleanUpComponent>());
+}
+
+Test_Case(EntityChurnRecyclesSlots)
+{
+    Shared<World> world = World::GetInstance();
+
+    constexpr Size BatchSize = 10000;
+    constexpr Size Cycles = 200;
+
+    Vector<Entity> live;
+    Vector<Entity> destroyed;
+
+    live.reserve(BatchSize);
+    destroyed.reserve(BatchSize);
+
+    const Size entityCountBefore = world->GetEntityCount();
+
+    uint highestIndex = 0;
+    uint firstCycleHighestIndex = 0;
+
+    for (Size cycle = 0; cycle < Cycles; ++cycle)
+    {
+        for (Size n = 0; n < BatchSize; ++n)
+        {
+            live.push_back(world->CreateEntity());
+            highestIndex = std::max(highestIndex, live.back().index);
+        }
+
+        for (const Entity& entity : destroyed)
+            Test_Assert(!world->IsValid(entity));
+
+        destroyed.clear();
+
+        for (const Entity& entity : live)
+        {
+            Test_Assert(world->IsValid(entity));
+
+            world->DestroyEntity(entity);
+            destroyed.push_back(entity);
+        }
+
+        live.clear();
+
+        if (cycle == 0)
+            firstCycleHighestIndex = highestIndex;
+    }
+
+    Test_Assert(world->GetEntityCount() == entityCountBefore);
+    Test_Assert(highestIndex == firstCycleHighestIndex);
+}
+
+Test_Case(PrefabInstancesLandInOneArchetype)
+{
+    Shared<GameObjectManager> manager = GameObjectManager::GetInstance();
+
+    constexpr Size Count = 1000;
+
+    Shared<HealthComponent> health = std::make_shared<HealthComponent>();
+    health->value = 7.0f;
+
+    Shared<Prefab> prefab = Prefab::Create("prefab");
+
+    prefab->AddComponent(health);
+    prefab->SetLocalPosition(Vector3f{ 1.0f, 2.0f, 3.0f });
+
+    const Size archetypeCount = World::GetInstance()->GetArchetypeCount();
+
+    const Vector<GameObject*> instances = manager->Instantiate(prefab, Count);
+
+    Test_Assert(instances.size() == Count);
+    Test_Assert(World::GetInstance()->GetArchetypeCount() <= archetypeCount + 1);
+
+    Size archetypeRows = 0;
+
+    for (Archetype* archetype : World::GetInstance()->GetArchetypes())
+    {
+        if (archetype->Contains(TypeIndex(typeid(HealthComponent))))
+            archetypeRows += archetype->GetSize();
+    }
+
+    Test_Assert(archetypeRows == Count);
+
+    for (GameObject* instance : instances)
+    {
+        Shared<HealthComponent> instanceHealth = instance->GetComponent<HealthComponent>();
+        Transform* transform = instance->GetComponent<Transform>();
+
+        Test_Assert(instanceHealth && instanceHealth != health && instanceHealth->value == 7.0f);
+        Test_Assert(instanceHealth->entity == instance->GetEntity());
+        Test_Assert(transform && transform->entity == instance->GetEntity());
+        Test_Assert(DirectX::XMVectorGetZ(transform->GetLocalPosition()) == 3.0f);
+    }
+}
+
+Test_Benchmark(GameObjectCreateRemoveMillion)
+{
+    Shared<GameObjectManager> manager = GameObjectManager::GetInstance();
+
+    constexpr Size BatchSize = 100000;
+    constexpr Size Cycles = 10;
+
+    Vector<Entity> entities;
+    entities.reserve(BatchSize);
+
+    double createTime = 0.0;
+    double removeTime = 0.0;
+
+    for (Size cycle = 0; cycle < Cycles; ++cycle)
+    {
+        createTime += TestRegistry::Measure([&]
+        {
+            for (Size n = 0; n < BatchSize; ++n)
+                entities.push_back(manager->Create("entity")->GetEntity());
+        });
+
+        removeTime += TestRegistry::Measure([&]
+        {
+            for (const Entity& entity : entities)
+                manager->Remove(entity);
+        });
+
+        for (const Entity& entity : entities)
+            Test_Assert(!manager->IsValid(entity));
+
+        entities.clear();
+    }
+
+    TestRegistry::Report("Create " + std::to_string(BatchSize * Cycles) + " game objects", createTime, "ms");
+    TestRegistry::Report("Remove " + std::to_string(BatchSize * Cycles) + " game objects", removeTime, "ms");
+}
+
+Test_Benchmark(ComponentIterationThroughput)
+{
+    Shared<World> world = World::GetInstance();
+
+    constexpr Size Passes = 10;
+
+    for (Size count : { Size(10000), Size(100000), Size(1000000) })
+    {
+        TransformSystem::GetInstance()->Reserve(TransformSystem::GetInstance()->GetCount() + count);
+
+        Vector<Transform> transforms(count);
+        Vector<Shared<HealthComponent>> healths;
+
+        healths.reserve(count);
+
+        Unique<TypedComponentColumn<Velocity>> velocities = std::make_unique<TypedComponentColumn<Velocity>>();
+        velocities->Reserve(count);
+
+        for (Size n = 0; n < count; ++n)
+        {
+            healths.push_back(MakePooled<HealthComponent>());
+            velocities->Push({ Vector3f{ static_cast<float>(n), 0.0f, 0.0f } }, 0);
+        }
+
+        Vector<Pair<TypeIndex, Unique<ComponentColumn>>> components;
+
+        components.push_back(GameObjectManager::CreateComponents(transforms));
+        components.push_back(GameObjectManager::CreateComponents(healths));
+        components.emplace_back(TypeIndex(typeid(Velocity)), std::move(velocities));
+
+        Vector<Entity> entities;
+
+        const double createTime = TestRegistry::Measure([&] { entities = world->CreateEntities(components, count); });
+
+        Test_Assert(entities.size() == count);
+
+        double inlineChecksum = 0.0;
+        double sharedChecksum = 0.0;
+
+        const double inlineTime = TestRegistry::Measure([&]
+        {
+            for (Size pass = 0; pass < Passes; ++pass)
+                world->ForEach<Transform, Velocity>([&](Transform& transform, Velocity& velocity) { inlineChecksum += transform.GetHandle().index + velocity.value.x; });
+        });
+
+        const double sharedTime = TestRegistry::Measure([&]
+        {
+            for (Size pass = 0; pass < Passes; ++pass)
+                world->ForEach<HealthComponent, Velocity>([&](HealthComponent& health, Velocity& velocity) { sharedChecksum += health.value + velocity.value.x; });
+        });
+
+        Test_Assert(inlineChecksum > 0.0 && sharedChecksum > 0.0);
+
+        for (const Entity& entity : entities)
+            world->DestroyEntity(entity);
+
+        const String label = std::to_string(count) + " entities";
+
+        TestRegistry::Report("Create " + label, createTime, "ms");
+        TestRegistry::Report("Iterate Transform + Velocity over " + label, inlineTime / Passes, "ms");
+        TestRegistry::Report("Iterate shared component + Velocity over " + label, sharedTime / Passes, "ms");
+        TestRegistry::Report("Inline iteration throughput over " + label, static_cast<double>(count * Passes) / (inlineTime * 1000.0), "M entities/s");
+        TestRegistry::Report("Shared iteration throughput over " + label, static_cast<double>(count * Passes) / (sharedTime * 1000.0), "M entities/s");
+    }
+}
+
+Test_Benchmark(PrefabSpawnRate)
+{
+    Shared<GameObjectManager> manager = GameObjectManager::GetInstance();
+
+    Shared<Prefab> prefab = Prefab::Create("spawned");
+    prefab->AddComponent(std::make_shared<HealthComponent>());
+
+    for (Size count : { Size(10000), Size(100000), Size(1000000) })
+    {
+        Vector<GameObject*> instances;
+
+        const double spawnTime = TestRegistry::Measure([&] { instances = manager->Instantiate(prefab, count); });
+
+        Test_Assert(instances.size() == count);
+
+        for (GameObject* instance : instances)
+            manager->Remove(instance->GetEntity());
+
+        TestRegistry::Report("Instantiate " + std::to_string(count) + " prefab instances", spawnTime, "ms");
+        TestRegistry::Report("Spawn rate at " + std::to_string(count) + " instances", static_cast<double>(count) / (spawnTime * 1000.0), "M instances/s");
+    }
+}
\ No newline at end of file
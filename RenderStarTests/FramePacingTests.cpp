@@ -0,0 +1,116 @@
+#include "Test.hpp"
+
+using namespace RenderStar::Render;
+
+struct SimulatedGpu
+{
+    UINT64 submittedValue = 0;
+    UINT64 completedValue = 0;
+    UINT64 latency = 0;
+
+    Vector<UINT64> waitedValues;
+
+    void Signal(UINT64 value)
+    {
+        submittedValue = value;
+        completedValue = std::max(completedValue, value > latency ? value - latency : 0);
+    }
+
+    void WaitFor(UINT64 value)
+    {
+        waitedValues.push_back(value);
+        completedValue = std::max(completedValue, value);
+    }
+};
+
+static Vector<UINT> RunPacedFrames(FramePacer& pacer, SimulatedGpu& gpu, Size frames)
+{
+    Vector<UINT> out = { pacer.GetFrameIndex() };
+
+    for (Size frame = 0; frame < frames; ++frame)
+    {
+        gpu.Signal(pacer.GetFenceValue());
+
+        pacer.Advance(pacer.GetNextFrameIndex(), [&gpu] { return gpu.completedValue; }, [&gpu](UINT64 value) { gpu.WaitFor(value); });
+
+        out.push_back(pacer.GetFrameIndex());
+    }
+
+    return out;
+}
+
+Test_Case(FramePacerWaitsOnlyWhenReusingAnUnfinishedSlot)
+{
+    constexpr Size Frames = 12;
+
+    for (UINT frameCount = 2; frameCount <= FramePacer::MaxFrameCount; ++frameCount)
+    {
+        FramePacer pacer;
+        SimulatedGpu stalled;
+
+        pacer.Initialize(frameCount);
+        stalled.latency = std::numeric_limits<UINT64>::max();
+
+        const Vector<UINT> slots = RunPacedFrames(pacer, stalled, Frames);
+
+        for (Size frame = 0; frame < slots.size(); ++frame)
+            Test_Assert(slots[frame] == frame % frameCount);
+
+        Test_Assert(pacer.GetWaitCount() == Frames - frameCount + 1);
+        Test_Assert(stalled.waitedValues.size() == Frames - frameCount + 1);
+
+        for (Size w = 0; w < stalled.waitedValues.size(); ++w)
+            Test_Assert(stalled.waitedValues[w] == w + 1);
+
+        FramePacer keepingUp;
+        SimulatedGpu oneSlotBehind;
+
+        keepingUp.Initialize(frameCount);
+        oneSlotBehind.latency = frameCount - 1;
+
+        RunPacedFrames(keepingUp, oneSlotBehind, Frames);
+
+        Test_Assert(keepingUp.GetWaitCount() == 0);
+
+        FramePacer fallingBehind;
+        SimulatedGpu fullQueueBehind;
+
+        fallingBehind.Initialize(frameCount);
+        fullQueueBehind.latency = frameCount;
+
+        RunPacedFrames(fallingBehind, fullQueueBehind, Frames);
+
+        Test_Assert(fallingBehind.GetWaitCount() == Frames - frameCount + 1);
+    }
+}
+
+Test_Case(HeadlessFramesRotateSlotsWithoutWaiting)
+{
+    const Shared<Renderer> renderer = Renderer::GetInstance();
+
+    const UINT frameCount = renderer->GetFrameCount();
+    const Size frames = 3 * frameCount;
+
+    const ullong firstFrame = renderer->GetFrameStatistics().frameNumber;
+    const ullong firstWaitCount = renderer->GetFrameStatistics().cpuWaitCount;
+
+    UINT slot = renderer->GetFrameIndex();
+
+    for (Size frame = 0; frame < frames; ++frame)
+    {
+        RenderStar::RenderStarEngine::RunHeadless(1);
+
+        const FrameStatistics& statistics = renderer->GetFrameStatistics();
+
+        Test_Assert(renderer->GetFrameIndex() == (slot + 1) % frameCount);
+        Test_Assert(statistics.cpuWaitTime >= 0.0f && std::isfinite(statistics.cpuWaitTime));
+
+        slot = renderer->GetFrameIndex();
+    }
+
+    const FrameStatistics& statistics = renderer->GetFrameStatistics();
+
+    Test_Assert(statistics.frameNumber == firstFrame + frames);
+    Test_Assert(statistics.cpuWaitCount == firstWaitCount);
+    Test_Assert(statistics.averageCpuWaitTime >= 0.0f && std::isfinite(statistics.averageCpuWaitTime));
+}
\ No newline at end of file
@@ -0,0 +1,155 @@
+#include "Test.hpp"
+
+using namespace RenderStar::Render;
+
+Test_Case(FreeListAllocatorReusesAndCoalescesBlocks)
+{
+    FreeListAllocator allocator(100);
+
+    const Size first = *allocator.Allocate(10);
+    const Size second = *allocator.Allocate(20);
+    const Size third = *allocator.Allocate(30);
+
+    Test_Assert(first == 0 && second == 10 && third == 30);
+
+    allocator.Free(second, 20);
+
+    FreeListStatistics statistics = allocator.GetStatistics();
+
+    Test_Assert(statistics.freeBlockCount == 2);
+    Test_Assert(statistics.largestFreeBlock == 40);
+    Test_Assert(*allocator.Allocate(15) == 10);
+
+    allocator.Free(10, 15);
+    allocator.Free(first, 10);
+    allocator.Free(third, 30);
+
+    statistics = allocator.GetStatistics();
+
+    Test_Assert(statistics.freeBlockCount == 1);
+    Test_Assert(statistics.largestFreeBlock == 100);
+    Test_Assert(statistics.usedSize == 0);
+    Test_Assert(statistics.GetFragmentation() == 0.0f);
+
+    Test_Assert(!allocator.Allocate(101));
+
+    allocator.Grow(200);
+
+    Test_Assert(*allocator.Allocate(150) == 0);
+}
+
+Test_Case(FreeListAllocatorChurnLeavesNoOverlap)
+{
+    FreeListAllocator allocator(1 << 20);
+
+    RandomEngine random(3);
+
+    Vector<Pair<Size, Size>> live;
+
+    for (Size n = 0; n < 100000; ++n)
+    {
+        if (live.empty() || random() % 2)
+        {
+            const Size size = 1 + random() % 500;
+            const Optional<Size> offset = allocator.Allocate(size);
+
+            if (offset)
+                live.push_back({ *offset, size });
+        }
+        else
+        {
+            const Size index = random() % live.size();
+
+            allocator.Free(live[index].first, live[index].second);
+
+            live[index] = live.back();
+            live.pop_back();
+        }
+    }
+
+    std::sort(live.begin(), live.end());
+
+    for (Size n = 1; n < live.size(); ++n)
+        Test_Assert(live[n - 1].first + live[n - 1].second <= live[n].first);
+
+    for (const Pair<Size, Size>& allocation : live)
+        allocator.Free(allocation.first, allocation.second);
+
+    const FreeListStatistics statistics = allocator.GetStatistics();
+
+    Test_Assert(statistics.freeBlockCount == 1);
+    Test_Assert(statistics.usedSize == 0);
+}
+
+Test_Case(GeometryBufferGrowsAndRetiresFreesAfterFramesInFlight)
+{
+    Shared<GeometryBuffer> geometryBuffer = GeometryBuffer::GetInstance();
+
+    const uint framesInFlight = Renderer::GetInstance()->GetFrameCount();
+
+    RenderStar::RenderStarEngine::RunHeadless(framesInFlight + 1);
+
+    const FreeListStatistics before = geometryBuffer->GetVertexStatistics();
+    const Vector<Vertex> vertices(before.capacity + 1);
+    const Vector<uint> indices = { 0, 1, 2 };
+
+    const GeometryAllocation allocation = geometryBuffer->Allocate(vertices, indices);
+
+    Test_Assert(geometryBuffer->GetVertexStatistics().capacity > before.capacity);
+    Test_Assert(geometryBuffer->GetVertexStatistics().liveAllocationCount == before.liveAllocationCount + 1);
+    Test_Assert(allocation.vertexCount == vertices.size() && allocation.indexCount == indices.size());
+
+    geometryBuffer->Free(allocation);
+    geometryBuffer->Flush();
+
+    Test_Assert(geometryBuffer->GetVertexStatistics().liveAllocationCount == before.liveAllocationCount + 1);
+
+    RenderStar::RenderStarEngine::RunHeadless(framesInFlight);
+
+    Test_Assert(geometryBuffer->GetVertexStatistics().liveAllocationCount == before.liveAllocationCount + 1);
+
+    RenderStar::RenderStarEngine::RunHeadless(1);
+
+    Test_Assert(geometryBuffer->GetVertexStatistics().liveAllocationCount == before.liveAllocationCount);
+}
+
+Test_Benchmark(FreeListAllocatorMillionOperations)
+{
+    FreeListAllocator allocator(1 << 24);
+
+    RandomEngine random(7);
+
+    Vector<Pair<Size, Size>> live;
+    live.reserve(1 << 16);
+
+    constexpr Size Operations = 1000000;
+
+    const double time = TestRegistry::Measure([&]
+    {
+        for (Size n = 0; n < Operations; ++n)
+        {
+            if (live.size() < 1000 || (live.size() < 60000 && random() % 2))
+            {
+                const Size size = 1 + random() % 256;
+                const Optional<Size> offset = allocator.Allocate(size);
+
+                if (offset)
+                    live.push_back({ *offset, size });
+            }
+            else
+            {
+                const Size index = random() % live.size();
+
+                allocator.Free(live[index].first, live[index].second);
+
+                live[index] = live.back();
+                live.pop_back();
+            }
+        }
+    });
+
+    const FreeListStatistics statistics = allocator.GetStatistics();
+
+    TestRegistry::Report("Free list allocate/free " + std::to_string(Operations) + " operations", time, "ms");
+    TestRegistry::Report("Free list fragmentation", statistics.GetFragmentation() * 100.0, "%");
+}
\ No newline at end of file
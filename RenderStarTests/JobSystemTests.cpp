@@ -0,0 +1,139 @@
+#include "Test.hpp"
+
+Test_Case(WaitingOnARecycledJobSlotReturns)
+{
+    const Shared<JobSystem> jobSystem = JobSystem::GetInstance();
+
+    const JobHandle first = jobSystem->CreateJob(nullptr);
+
+    jobSystem->Run(first);
+    jobSystem->Wait(first);
+
+    JobHandle recycled;
+
+    for (Size attempt = 0; attempt < 2 * 4096 && recycled.job != first.job; ++attempt)
+    {
+        const JobHandle candidate = jobSystem->CreateJob(nullptr);
+
+        if (candidate.job == first.job)
+            recycled = candidate;
+        else
+        {
+            jobSystem->Run(candidate);
+            jobSystem->Wait(candidate);
+        }
+    }
+
+    Test_Assert(recycled.job == first.job);
+    Test_Assert(recycled.generation != first.generation);
+    Test_Assert(!jobSystem->IsFinished(recycled));
+    Test_Assert(jobSystem->IsFinished(first));
+
+    jobSystem->Wait(first);
+
+    jobSystem->Run(recycled);
+    jobSystem->Wait(recycled);
+
+    Test_Assert(jobSystem->IsFinished(recycled));
+}
+
+Test_Case(ContinuationAddedAfterCompletionRuns)
+{
+    const Shared<JobSystem> jobSystem = JobSystem::GetInstance();
+
+    AtomicInt order = 0;
+    int ancestorOrder = -1;
+    int continuationOrder = -1;
+
+    const JobHandle ancestor = jobSystem->CreateJob([&] { ancestorOrder = order.fetch_add(1); });
+
+    jobSystem->Run(ancestor);
+    jobSystem->Wait(ancestor);
+
+    const JobHandle continuation = jobSystem->CreateJob([&] { continuationOrder = order.fetch_add(1); });
+
+    jobSystem->AddContinuation(ancestor, continuation);
+    jobSystem->Wait(continuation);
+
+    Test_Assert(ancestorOrder == 0);
+    Test_Assert(continuationOrder == 1);
+}
+
+Test_Case(ContinuationsRunAfterChildren)
+{
+    const Shared<JobSystem> jobSystem = JobSystem::GetInstance();
+
+    constexpr int ChildCount = 64;
+
+    AtomicInt finishedChildren = 0;
+    int observedChildren = -1;
+
+    const JobHandle root = jobSystem->CreateJob(nullptr);
+
+    for (int c = 0; c < ChildCount; ++c)
+        jobSystem->Run(jobSystem->CreateChildJob(root, [&] { finishedChildren.fetch_add(1); }));
+
+    const JobHandle continuation = jobSystem->CreateJob([&] { observedChildren = finishedChildren.load(); });
+
+    jobSystem->AddContinuation(root, continuation);
+    jobSystem->Run(root);
+    jobSystem->Wait(continuation);
+
+    Test_Assert(observedChildren == ChildCount);
+}
+
+Test_Benchmark(ParallelForScaling)
+{
+    const Shared<JobSystem> jobSystem = JobSystem::GetInstance();
+    const uint maximumThreads = std::max(2u, Thread::hardware_concurrency());
+
+    constexpr Size ElementCount = 1 << 22;
+    constexpr Size BatchSize = 4096;
+    constexpr Size Passes = 10;
+
+    Vector<float> values(ElementCount);
+
+    for (Size v = 0; v < ElementCount; ++v)
+        values[v] = static_cast<float>(v);
+
+    const auto update = [&](Size begin, Size end)
+    {
+        for (Size v = begin; v < end; ++v)
+            values[v] = std::sqrt(values[v] * values[v] + 1.0f);
+    };
+
+    double serialTime = 0.0;
+
+    for (uint threads = 1; threads <= maximumThreads; threads *= 2)
+    {
+        double time = 0.0;
+
+        if (threads == 1)
+        {
+            time = serialTime = TestRegistry::Measure([&]
+            {
+                for (Size pass = 0; pass < Passes; ++pass)
+                    update(0, ElementCount);
+            });
+        }
+        else
+        {
+            jobSystem->Shutdown();
+            jobSystem->Initialize(threads - 1);
+
+            time = TestRegistry::Measure([&]
+            {
+                for (Size pass = 0; pass < Passes; ++pass)
+                    jobSystem->ParallelFor(ElementCount, BatchSize, update);
+            });
+        }
+
+        TestRegistry::Report("ParallelFor over " + std::to_string(ElementCount) + " elements on " + std::to_string(threads) + " thread(s)", time / Passes, "ms");
+        TestRegistry::Report("Speedup on " + std::to_string(threads) + " thread(s)", serialTime / time, "x");
+    }
+
+    Test_Assert(std::isfinite(values.back()));
+
+    jobSystem->Shutdown();
+    jobSystem->Initialize(Settings::GetInstance()->Get<uint>("workerThreadCount"));
+}
\ No newline at end of file
@@ -0,0 +1,54 @@
+#include "Test.hpp"
+
+using namespace RenderStar::Render;
+
+static const Array<uchar, 8> FirstBytecode = { 1, 2, 3, 4, 5, 6, 7, 8 };
+static const Array<uchar, 8> SecondBytecode = { 1, 2, 3, 4, 5, 6, 7, 9 };
+
+static D3D12_GRAPHICS_PIPELINE_STATE_DESC CreateCachedDescription(const Array<uchar, 8>& bytecode)
+{
+    D3D12_GRAPHICS_PIPELINE_STATE_DESC description = {};
+
+    description.VS = { bytecode.data(), bytecode.size() };
+    description.InputLayout = { Vertex::GetInputLayout().data(), static_cast<UINT>(Vertex::GetInputLayout().size()) };
+    description.SampleMask = UINT_MAX;
+    description.PrimitiveTopologyType = D3D12_PRIMITIVE_TOPOLOGY_TYPE_TRIANGLE;
+    description.SampleDesc.Count = 1;
+
+    return description;
+}
+
+Test_Case(PipelineStatesAreKeyedOnStateNotName)
+{
+    const Shared<PipelineStateCache> cache = PipelineStateCache::GetInstance();
+
+    const Shared<RootSignature> firstRootSignature = RootSignature::Create({ RootSignatureParameter::Create(RootSignatureParameterType::CONSTANT_BUFFER_VIEW, 0) });
+    const Shared<RootSignature> sameRootSignature = RootSignature::Create({ RootSignatureParameter::Create(RootSignatureParameterType::CONSTANT_BUFFER_VIEW, 0) });
+    const Shared<RootSignature> otherRootSignature = RootSignature::Create({ RootSignatureParameter::Create(RootSignatureParameterType::SHADER_RESOURCE_VIEW, 0) });
+
+    Test_Assert(firstRootSignature->GetHash() == sameRootSignature->GetHash());
+    Test_Assert(firstRootSignature->GetHash() != otherRootSignature->GetHash());
+
+    const PipelineStateCacheStatistics before = cache->GetStatistics();
+
+    const CachedPipelineState* first = cache->GetOrCreate(firstRootSignature->GetHash(), {}, CreateCachedDescription(FirstBytecode));
+    const CachedPipelineState* shared = cache->GetOrCreate(sameRootSignature->GetHash(), {}, CreateCachedDescription(FirstBytecode));
+    const CachedPipelineState* otherRoot = cache->GetOrCreate(otherRootSignature->GetHash(), {}, CreateCachedDescription(FirstBytecode));
+    const CachedPipelineState* otherBytecode = cache->GetOrCreate(firstRootSignature->GetHash(), {}, CreateCachedDescription(SecondBytecode));
+    const CachedPipelineState* otherState = cache->GetOrCreate(firstRootSignature->GetHash(), PipelineStateVariant::Wireframe(), CreateCachedDescription(FirstBytecode));
+
+    D3D12_GRAPHICS_PIPELINE_STATE_DESC multisampled = CreateCachedDescription(FirstBytecode);
+
+    multisampled.SampleDesc.Count = 4;
+
+    const CachedPipelineState* otherSampling = cache->GetOrCreate(firstRootSignature->GetHash(), {}, multisampled);
+
+    const PipelineStateCacheStatistics after = cache->GetStatistics();
+
+    Test_Assert(first == shared);
+    Test_Assert(first != otherRoot);
+    Test_Assert(first != otherBytecode);
+    Test_Assert(first != otherState);
+    Test_Assert(first != otherSampling);
+    Test_Assert(after.memoryHits - before.memoryHits == 1);
+}
\ No newline at end of file
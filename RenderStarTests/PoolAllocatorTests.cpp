@@ -0,0 +1,180 @@
+#include "Test.hpp"
+
+struct PooledParticle
+{
+    Vector3f position;
+    Vector3f velocity;
+
+    float age = 0.0f;
+    uint seed = 0;
+};
+
+struct alignas(64) AlignedPooledBlock
+{
+    float values[5] = {};
+};
+
+Test_Case(SlabPoolGrowsOneSlabAtATime)
+{
+    SlabPool pool(sizeof(PooledParticle), alignof(PooledParticle), "PooledParticleTest");
+
+    Vector<void*> blocks = { pool.Allocate() };
+
+    const PoolStatistics first = pool.GetStatistics();
+    const Size blocksPerSlab = first.reservedBytes / first.blockSize;
+
+    Test_Assert(first.slabCount == 1);
+    Test_Assert(blocksPerSlab >= 64);
+
+    while (blocks.size() < blocksPerSlab)
+        blocks.push_back(pool.Allocate());
+
+    Test_Assert(pool.GetStatistics().slabCount == 1);
+
+    blocks.push_back(pool.Allocate());
+
+    const PoolStatistics grown = pool.GetStatistics();
+
+    Test_Assert(grown.slabCount == 2);
+    Test_Assert(grown.liveCount == blocksPerSlab + 1);
+    Test_Assert(grown.peakCount == blocksPerSlab + 1);
+
+    std::sort(blocks.begin(), blocks.end());
+
+    Test_Assert(std::adjacent_find(blocks.begin(), blocks.end()) == blocks.end());
+
+    for (void* block : blocks)
+        pool.Deallocate(block);
+
+    const PoolStatistics released = pool.GetStatistics();
+
+    Test_Assert(released.liveCount == 0);
+    Test_Assert(released.peakCount == blocksPerSlab + 1);
+    Test_Assert(released.deallocationCount == released.allocationCount);
+}
+
+Test_Case(FreedBlocksAreReused)
+{
+    SlabPool pool(sizeof(PooledParticle), alignof(PooledParticle), "PooledParticleReuseTest");
+
+    void* first = pool.Allocate();
+
+    pool.Deallocate(first);
+
+    Test_Assert(pool.Allocate() == first);
+
+    pool.Deallocate(first);
+
+    for (Size cycle = 0; cycle < 10000; ++cycle)
+    {
+        Array<void*, 16> blocks;
+
+        for (void*& block : blocks)
+            block = pool.Allocate();
+
+        for (void* block : blocks)
+            pool.Deallocate(block);
+    }
+
+    Test_Assert(pool.GetStatistics().slabCount == 1);
+
+    Shared<PooledParticle> particle = MakePooled<PooledParticle>();
+    const void* address = particle.get();
+
+    particle.reset();
+    particle = MakePooled<PooledParticle>();
+
+    Test_Assert(particle.get() == address);
+}
+
+Test_Case(PooledBlocksHonorAlignment)
+{
+    SlabPool pool(24, 64, "AlignedPoolTest");
+
+    Test_Assert(pool.GetStatistics().blockSize == 64);
+
+    Vector<void*> blocks;
+
+    for (Size b = 0; b < 300; ++b)
+    {
+        blocks.push_back(pool.Allocate());
+
+        Test_Assert(reinterpret_cast<uintptr_t>(blocks.back()) % 64 == 0);
+    }
+
+    for (void* block : blocks)
+        pool.Deallocate(block);
+
+    Vector<Shared<AlignedPooledBlock>> pooled;
+
+    for (Size b = 0; b < 300; ++b)
+    {
+        pooled.push_back(MakePooled<AlignedPooledBlock>());
+
+        Test_Assert(reinterpret_cast<uintptr_t>(pooled.back().get()) % alignof(AlignedPooledBlock) == 0);
+    }
+}
+
+Test_Benchmark(PooledVersusHeapSharedAllocation)
+{
+    constexpr Size Count = 100000;
+    constexpr Size Rounds = 20;
+
+    Vector<Shared<PooledParticle>> particles(Count);
+
+    const auto churn = [&particles](const auto& create)
+    {
+        for (Size round = 0; round < Rounds; ++round)
+        {
+            for (Size p = 0; p < Count; ++p)
+                particles[p] = create();
+
+            for (Size p = round % 2; p < Count; p += 2)
+                particles[p].reset();
+        }
+
+        particles.assign(Count, nullptr);
+    };
+
+    churn([] { return MakePooled<PooledParticle>(); });
+
+    const double pooledTime = TestRegistry::Measure([&] { churn([] { return MakePooled<PooledParticle>(); }); });
+    const double heapTime = TestRegistry::Measure([&] { churn([] { return std::make_shared<PooledParticle>(); }); });
+
+    const double parallelPooledTime = TestRegistry::Measure([&]
+    {
+        JobSystem::GetInstance()->ParallelFor(Count, 1024, [&particles](Size begin, Size end)
+        {
+            for (Size round = 0; round < Rounds; ++round)
+            {
+                for (Size p = begin; p < end; ++p)
+                    particles[p] = MakePooled<PooledParticle>();
+
+                for (Size p = begin; p < end; ++p)
+                    particles[p].reset();
+            }
+        });
+    });
+
+    const double parallelHeapTime = TestRegistry::Measure([&]
+    {
+        JobSystem::GetInstance()->ParallelFor(Count, 1024, [&particles](Size begin, Size end)
+        {
+            for (Size round = 0; round < Rounds; ++round)
+            {
+                for (Size p = begin; p < end; ++p)
+                    particles[p] = std::make_shared<PooledParticle>();
+
+                for (Size p = begin; p < end; ++p)
+                    particles[p].reset();
+            }
+        });
+    });
+
+    Test_Assert(std::all_of(particles.begin(), particles.end(), [](const Shared<PooledParticle>& particle) { return !particle; }));
+
+    TestRegistry::Report("MakePooled churn of " + std::to_string(Count) + " objects", pooledTime / Rounds, "ms");
+    TestRegistry::Report("std::make_shared churn of " + std::to_string(Count) + " objects", heapTime / Rounds, "ms");
+    TestRegistry::Report("MakePooled churn across workers", parallelPooledTime / Rounds, "ms");
+    TestRegistry::Report("std::make_shared churn across workers", parallelHeapTime / Rounds, "ms");
+}
\ No newline at end of file
@@ -0,0 +1,175 @@
+#include "Test.hpp"
+
+using namespace RenderStar::Render;
+
+static const Vector<Vertex> QuadVertices =
+{
+    { { -0.5f, -0.5f, 0.0f }, { 1.0f, 1.0f, 1.0f }, { 0.0f, 0.0f, 1.0f }, { 0.0f, 1.0f } },
+    { { 0.5f, -0.5f, 0.0f }, { 1.0f, 1.0f, 1.0f }, { 0.0f, 0.0f, 1.0f }, { 1.0f, 1.0f } },
+    { { 0.5f, 0.5f, 0.0f }, { 1.0f, 1.0f, 1.0f }, { 0.0f, 0.0f, 1.0f }, { 1.0f, 0.0f } },
+    { { -0.5f, 0.5f, 0.0f }, { 1.0f, 1.0f, 1.0f }, { 0.0f, 0.0f, 1.0f }, { 0.0f, 0.0f } }
+};
+
+static const Vector<uint> QuadIndices = { 2, 1, 0, 3, 2, 0 };
+
+Test_Case(RedundantStateChangesAreFlagged)
+{
+    RecordingCommandContext context;
+
+    ID3D12PipelineState* pipelineA = reinterpret_cast<ID3D12PipelineState*>(0x1000);
+    ID3D12PipelineState* pipelineB = reinterpret_cast<ID3D12PipelineState*>(0x2000);
+
+    context.SetPipelineState(pipelineA);
+    context.SetPipelineState(pipelineA);
+    context.SetPipelineState(pipelineB);
+    context.SetRootConstantBufferView(1, 0x10000);
+    context.SetRootConstantBufferView(2, 0x10000);
+    context.SetRootConstantBufferView(1, 0x10000);
+    context.DrawIndexed(6, 1, 0, 0, 0);
+
+    const CommandStatistics& statistics = context.GetStatistics();
+
+    Test_Assert(context.GetStream().GetSize() == 7);
+    Test_Assert(statistics.drawCount == 1 && statistics.indexCount == 6);
+    Test_Assert(statistics.pipelineStateChanges == 3);
+    Test_Assert(statistics.redundantStateChanges == 2);
+    Test_Assert(context.GetRedundantCommands() == Vector<Size>({ 1, 5 }));
+}
+
+Test_Case(BarriersAreRecordedByType)
+{
+    RecordingCommandContext context;
+
+    ID3D12Resource* first = reinterpret_cast<ID3D12Resource*>(0x1000);
+    ID3D12Resource* second = reinterpret_cast<ID3D12Resource*>(0x2000);
+
+    Array<D3D12_RESOURCE_BARRIER, 2> barriers = {};
+
+    barriers[0].Type = D3D12_RESOURCE_BARRIER_TYPE_ALIASING;
+    barriers[0].Aliasing.pResourceBefore = first;
+    barriers[0].Aliasing.pResourceAfter = second;
+
+    barriers[1].Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+    barriers[1].Transition.pResource = second;
+    barriers[1].Transition.StateBefore = D3D12_RESOURCE_STATE_COMMON;
+    barriers[1].Transition.StateAfter = D3D12_RESOURCE_STATE_RENDER_TARGET;
+
+    context.ResourceBarriers(barriers);
+    context.DiscardResource(second);
+
+    const Vector<RenderCommand>& commands = context.GetStream().GetCommands();
+
+    Test_Assert(commands.size() == 3);
+    Test_Assert(commands[0].type == RenderCommandType::ALIASING_BARRIER);
+    Test_Assert(commands[1].type == RenderCommandType::RESOURCE_BARRIER && commands[1].arguments[2] == D3D12_RESOURCE_STATE_RENDER_TARGET);
+    Test_Assert(commands[2].type == RenderCommandType::DISCARD_RESOURCE);
+    Test_Assert(context.GetStatistics().barrierCount == 2 && context.GetStatistics().barrierBatchCount == 1 && context.GetStatistics().discardCount == 1);
+}
+
+Test_Case(HeadlessFramesRecordIdenticalStreams)
+{
+    Shared<GameObjectManager> manager = GameObjectManager::GetInstance();
+
+    for (uint n = 0; n < 20; ++n)
+        Mesh::CreateGameObject("mesh" + std::to_string(n), "default", "test", QuadVertices, QuadIndices)->GetComponent<Mesh>()->Generate();
+
+    RenderStar::RenderStarEngine::RunHeadless(2);
+
+    const CommandStream previous = Renderer::GetInstance()->GetFrameRecording().GetStream();
+
+    RenderStar::RenderStarEngine::RunHeadless(1);
+
+    const RecordingCommandContext& recording = Renderer::GetInstance()->GetFrameRecording();
+
+    Test_Assert(recording.GetStatistics().drawCount > 0);
+    Test_Assert(recording.GetStatistics().instanceCount == manager->GetCount());
+    Test_Assert(recording.GetRedundantCommands().empty());
+
+    const Size difference = previous.FindFirstDifference(recording.GetStream());
+
+    if (difference != CommandStream::NoDifference)
+        Logger_WriteConsole("First difference at command " + std::to_string(difference) + ": " + (difference < recording.GetStream().GetSize() ? CommandStream::ToString(recording.GetStream().GetCommands()[difference]) : String("<end>")), LogLevel::ERROR);
+
+    Test_Assert(difference == CommandStream::NoDifference);
+}
+
+static Vector<RenderCommand> CollectDraws(const RecordingCommandContext& recording)
+{
+    Vector<RenderCommand> out;
+
+    for (const RenderCommand& command : recording.GetStream().GetCommands())
+    {
+        if (command.type == RenderCommandType::DRAW_INDEXED)
+            out.push_back(command);
+    }
+
+    return out;
+}
+
+Test_Case(ParallelRecordingMatchesSerialRecording)
+{
+    constexpr uint MeshCount = 200;
+
+    const bool parallelRender = Settings::GetInstance()->Get<bool>("parallelRender");
+    const uint parallelRenderBatchSize = Settings::GetInstance()->Get<uint>("parallelRenderBatchSize");
+
+    for (uint n = 0; n < MeshCount; ++n)
+    {
+        GameObject* gameObject = Mesh::CreateGameObject("mesh" + std::to_string(n), "default", "test", QuadVertices, QuadIndices);
+
+        gameObject->GetComponent<Transform>()->SetLocalPosition(Vector3f{ static_cast<float>(n % 20), static_cast<float>(n / 20), static_cast<float>(n) });
+        gameObject->GetComponent<Mesh>()->Generate();
+    }
+
+    Settings::GetInstance()->Set<bool>("parallelRender", false);
+
+    RenderStar::RenderStarEngine::RunHeadless(1);
+
+    const Vector<RenderCommand> serialDraws = CollectDraws(Renderer::GetInstance()->GetFrameRecording());
+    const uint serialListCount = Renderer::GetInstance()->GetFrameStatistics().commandListCount;
+    const Size serialDrawCount = RenderQueue::GetInstance()->GetStatistics().drawCount;
+
+    Settings::GetInstance()->Set<bool>("parallelRender", true);
+    Settings::GetInstance()->Set<uint>("parallelRenderBatchSize", 8);
+
+    RenderStar::RenderStarEngine::RunHeadless(1);
+
+    const Vector<RenderCommand> parallelDraws = CollectDraws(Renderer::GetInstance()->GetFrameRecording());
+    const uint parallelListCount = Renderer::GetInstance()->GetFrameStatistics().commandListCount;
+    const Size parallelDrawCount = RenderQueue::GetInstance()->GetStatistics().drawCount;
+
+    Settings::GetInstance()->Set<bool>("parallelRender", parallelRender);
+    Settings::GetInstance()->Set<uint>("parallelRenderBatchSize", parallelRenderBatchSize);
+
+    Test_Assert(serialDraws.size() == MeshCount);
+    Test_Assert(parallelDraws.size() == serialDraws.size());
+    Test_Assert(parallelDraws == serialDraws);
+    Test_Assert(serialDrawCount == MeshCount);
+    Test_Assert(parallelDrawCount == serialDrawCount);
+    Test_Assert(parallelListCount > serialListCount);
+
+    for (Size d = 0; d < parallelDraws.size(); ++d)
+        Test_Assert(parallelDraws[d].arguments[4] == d);
+}
+
+Test_Benchmark(HeadlessFrameCost)
+{
+    constexpr uint MeshCount = 10000;
+    constexpr uint Frames = 100;
+
+    for (uint n = 0; n < MeshCount; ++n)
+    {
+        GameObject* gameObject = Mesh::CreateGameObject("mesh" + std::to_string(n), "default", "test", QuadVertices, QuadIndices);
+
+        gameObject->GetComponent<Transform>()->SetLocalPosition(Vector3f{ static_cast<float>(n % 100), static_cast<float>(n / 100), 0.0f });
+        gameObject->GetComponent<Mesh>()->Generate();
+    }
+
+    RenderStar::RenderStarEngine::RunHeadless(1);
+
+    const double time = TestRegistry::Measure([&] { RenderStar::RenderStarEngine::RunHeadless(Frames); });
+
+    const CommandStatistics& statistics = Renderer::GetInstance()->GetFrameRecording().GetStatistics();
+
+    TestRegistry::Report("CPU frame time for " + std::to_string(MeshCount) + " meshes (" + std::to_string(statistics.drawCount) + " draws, " + std::to_string(statistics.commandCount) + " commands)", time / Frames, "ms");
+}
\ No newline at end of file
@@ -0,0 +1,223 @@
+#include "Test.hpp"
+
+using namespace RenderStar::Render;
+
+struct SampleGraph
+{
+    RenderGraph graph;
+
+    RenderGraphHandle backBuffer;
+    RenderGraphHandle shadowMap;
+    RenderGraphHandle hdr;
+    RenderGraphHandle bloom;
+    RenderGraphHandle unused;
+
+    Vector<String> executed;
+
+    SampleGraph()
+    {
+        graph.Initialize(nullptr, nullptr, nullptr);
+        graph.SetOutputDimensions({ 750, 450 });
+
+        backBuffer = graph.ImportTexture("BackBuffer", D3D12_RESOURCE_STATE_PRESENT);
+        shadowMap = graph.CreateTexture("ShadowMap", { 2048, 2048, DXGI_FORMAT_D32_FLOAT });
+        hdr = graph.CreateTexture("HDR", { 0, 0, DXGI_FORMAT_R16G16B16A16_FLOAT });
+        bloom = graph.CreateTexture("Bloom", { 375, 225, DXGI_FORMAT_R8G8B8A8_UNORM });
+        unused = graph.CreateTexture("Unused", { 0, 0 });
+
+        graph.AddPass("Shadow", [this](RenderGraphBuilder& builder) { builder.Write(shadowMap, D3D12_RESOURCE_STATE_DEPTH_WRITE); }, Record("Shadow"));
+        graph.AddPass("Scene", [this](RenderGraphBuilder& builder) { builder.Read(shadowMap); builder.Write(hdr); }, Record("Scene"));
+        graph.AddPass("Bloom", [this](RenderGraphBuilder& builder) { builder.Read(hdr); builder.Write(bloom); }, Record("Bloom"));
+        graph.AddPass("Tonemap", [this](RenderGraphBuilder& builder) { builder.Read(hdr); builder.Read(bloom); builder.Write(backBuffer); }, Record("Tonemap"));
+        graph.AddPass("Debug", [this](RenderGraphBuilder& builder) { builder.Write(unused); }, Record("Debug"));
+
+        graph.AddPass("Present", [this](RenderGraphBuilder& builder)
+        {
+            builder.Read(backBuffer, D3D12_RESOURCE_STATE_PRESENT);
+            builder.SetSideEffect();
+        },
+        Record("Present"));
+    }
+
+    Function<void(const RenderGraph&)> Record(const String& name)
+    {
+        return [this, name](const RenderGraph&) { executed.push_back(name); };
+    }
+};
+
+Test_Case(CompilationCullsUnusedPassesAndKeepsDependencyOrder)
+{
+    SampleGraph sample;
+
+    Test_Assert(sample.graph.IsDirty());
+
+    sample.graph.Compile();
+
+    Test_Assert(!sample.graph.IsDirty());
+
+    const String expected[] = { "Shadow", "Scene", "Bloom", "Tonemap", "Present" };
+
+    Test_Assert(sample.graph.GetScheduledPassCount() == 5);
+
+    for (Size p = 0; p < 5; ++p)
+        Test_Assert(sample.graph.GetScheduledPassName(p) == expected[p]);
+
+    Test_Assert(sample.graph.GetStatistics().culledPassCount == 1);
+
+    RecordingCommandContext context;
+    context.Reset();
+
+    for (Size p = 0; p < sample.graph.GetScheduledPassCount(); ++p)
+        sample.graph.Execute(p, &context);
+
+    Test_Assert(sample.executed.size() == 5);
+    Test_Assert(sample.executed.front() == "Shadow" && sample.executed.back() == "Present");
+}
+
+Test_Case(TransientTexturesAliasWhenLifetimesDoNotOverlap)
+{
+    SampleGraph sample;
+
+    sample.graph.Compile();
+
+    const RenderGraphStatistics& statistics = sample.graph.GetStatistics();
+
+    const Size shadowSize = 2048 * 2048 * 4;
+    const Size hdrSize = (750 * 450 * 8 + 65535) / 65536 * 65536;
+    const Size bloomSize = (375 * 225 * 4 + 65535) / 65536 * 65536;
+
+    Test_Assert(statistics.transientTextureCount == 3);
+    Test_Assert(statistics.unaliasedMemory == shadowSize + hdrSize + bloomSize);
+    Test_Assert(statistics.aliasedMemory == shadowSize + hdrSize);
+    Test_Assert(statistics.GetSavedMemory() == bloomSize);
+
+    Test_Assert(*sample.graph.GetHeapOffset(sample.shadowMap) == 0);
+    Test_Assert(*sample.graph.GetHeapOffset(sample.bloom) == 0);
+    Test_Assert(*sample.graph.GetHeapOffset(sample.hdr) == shadowSize);
+    Test_Assert(!sample.graph.GetHeapOffset(sample.unused));
+
+    Size aliasingBarriers = 0;
+
+    for (Size p = 0; p < sample.graph.GetScheduledPassCount(); ++p)
+    {
+        for (const RenderGraphBarrier& barrier : sample.graph.GetBarriers(p))
+        {
+            if (!barrier.isAliasing || barrier.texture.index != sample.bloom.index)
+                continue;
+
+            Test_Assert(barrier.aliasedTexture.index == sample.shadowMap.index);
+
+            aliasingBarriers++;
+        }
+    }
+
+    Test_Assert(aliasingBarriers > 0);
+    Test_Assert(statistics.aliasingBarrierCount == 2);
+    Test_Assert(statistics.discardCount == 3);
+}
+
+Test_Case(PassBarriersMoveTexturesIntoTheirDeclaredStates)
+{
+    SampleGraph sample;
+
+    sample.graph.Compile();
+
+    const Span<const RenderGraphBarrier> barriers = sample.graph.GetBarriers(1);
+
+    Test_Assert(barriers.size() == 2);
+    Test_Assert(barriers[0].texture.index == sample.shadowMap.index && barriers[0].before == D3D12_RESOURCE_STATE_DEPTH_WRITE);
+    Test_Assert(barriers[1].texture.index == sample.hdr.index && barriers[1].after == D3D12_RESOURCE_STATE_RENDER_TARGET);
+}
+
+Test_Case(ReadersRunBeforeTheNextWriter)
+{
+    RenderGraph graph;
+    graph.Initialize(nullptr, nullptr, nullptr);
+    graph.SetOutputDimensions({ 64, 64 });
+
+    const RenderGraphHandle texture = graph.CreateTexture("Texture", { 0, 0 });
+    const RenderGraphHandle output = graph.ImportTexture("Output", D3D12_RESOURCE_STATE_COMMON);
+
+    graph.AddPass("A", [&](RenderGraphBuilder& builder) { builder.Write(texture); }, [](const RenderGraph&) { });
+    graph.AddPass("B", [&](RenderGraphBuilder& builder) { builder.Read(texture); builder.Write(output); builder.SetSideEffect(); }, [](const RenderGraph&) { });
+    graph.AddPass("C", [&](RenderGraphBuilder& builder) { builder.Read(texture); builder.Write(texture); }, [](const RenderGraph&) { });
+    graph.AddPass("D", [&](RenderGraphBuilder& builder) { builder.Read(texture); builder.Write(output); builder.SetSideEffect(); }, [](const RenderGraph&) { });
+
+    graph.Compile();
+
+    const String expected[] = { "A", "B", "C", "D" };
+
+    Test_Assert(graph.GetScheduledPassCount() == 4);
+
+    for (Size p = 0; p < 4; ++p)
+        Test_Assert(graph.GetScheduledPassName(p) == expected[p]);
+}
+
+Test_Case(AliasingAndDiscardCommandsAreRecorded)
+{
+    ID3D12Resource* before = reinterpret_cast<ID3D12Resource*>(0x4000);
+    ID3D12Resource* after = reinterpret_cast<ID3D12Resource*>(0x5000);
+
+    RecordingCommandContext context;
+    context.Reset();
+
+    context.AliasResource(before, after);
+    context.DiscardResource(after);
+
+    const Vector<RenderCommand>& commands = context.GetStream().GetCommands();
+
+    Test_Assert(commands.size() == 2);
+    Test_Assert(commands[0].type == RenderCommandType::ALIASING_BARRIER);
+    Test_Assert(commands[0].arguments[0] == 0x4000 && commands[0].arguments[1] == 0x5000);
+    Test_Assert(commands[1].type == RenderCommandType::DISCARD_RESOURCE && commands[1].arguments[0] == 0x5000);
+    Test_Assert(CommandStream::ToString(commands[1]).rfind("DiscardResource", 0) == 0);
+}
+
+Test_Benchmark(RenderGraphCompileTwoHundredPasses)
+{
+    constexpr Size PassCount = 200;
+    constexpr Size Iterations = 100;
+
+    double time = 0.0;
+
+    for (Size iteration = 0; iteration < Iterations; ++iteration)
+    {
+        RenderGraph graph;
+        graph.Initialize(nullptr, nullptr, nullptr);
+        graph.SetOutputDimensions({ 1920, 1080 });
+
+        const RenderGraphHandle output = graph.ImportTexture("Output", D3D12_RESOURCE_STATE_PRESENT);
+
+        Vector<RenderGraphHandle> textures;
+
+        for (Size t = 0; t < PassCount; ++t)
+            textures.push_back(graph.CreateTexture("Texture" + std::to_string(t), { 0, 0 }));
+
+        for (Size p = 0; p < PassCount; ++p)
+        {
+            graph.AddPass("Pass" + std::to_string(p), [&, p](RenderGraphBuilder& builder)
+            {
+                if (p > 0)
+                    builder.Read(textures[p - 1]);
+
+                if (p > 1)
+                    builder.Read(textures[p / 2]);
+
+                builder.Write(textures[p]);
+
+                if (p + 1 == PassCount)
+                {
+                    builder.Write(output);
+                    builder.SetSideEffect();
+                }
+            },
+            [](const RenderGraph&) { });
+        }
+
+        time += TestRegistry::Measure([&] { graph.Compile(); });
+
+        Test_Assert(graph.GetScheduledPassCount() == PassCount);
+    }
+
+    TestRegistry::Report("Compile " + std::to_string(PassCount) + " pass render graph", time / Iterations, "ms");
+}
\ No newline at end of file
@@ -0,0 +1,112 @@
+#include "Test.hpp"
+
+using namespace RenderStar::Render;
+
+static constexpr uint QueueShaderCount = 4;
+static constexpr uint QueueTextureCount = 5;
+static constexpr uint QueueGeometryCount = 10;
+
+static void RegisterQueueMaterials()
+{
+    if (ShaderManager::GetInstance()->Get("queueShader0"))
+        return;
+
+    Shared<RootSignature> rootSignature = RootSignature::Create({});
+
+    for (uint s = 0; s < QueueShaderCount; ++s)
+        ShaderManager::GetInstance()->Register(Shader::Create("queueShader" + std::to_string(s), "Shader/Default", rootSignature));
+
+    for (uint t = 0; t < QueueTextureCount; ++t)
+        TextureManager::GetInstance()->Register(Texture::Create("queueTexture" + std::to_string(t), "Texture/Test.dds"));
+
+    ShaderManager::GetInstance()->WaitAll();
+}
+
+static void CreateQueueScene(Size count)
+{
+    RegisterQueueMaterials();
+
+    Vector<Shared<MeshGeometry>> geometries;
+
+    for (uint g = 0; g < QueueGeometryCount; ++g)
+        geometries.push_back(MeshGeometry::Create({ { { 0.0f, 0.0f, 0.0f }, { 1.0f, 1.0f, 1.0f }, { 0.0f, 0.0f, 1.0f }, { 0.0f, 1.0f } } }, { 0, 0, 0 }));
+
+    std::mt19937 random(1);
+
+    for (Size n = 0; n < count; ++n)
+    {
+        const uint material = random() % (QueueShaderCount * QueueTextureCount);
+
+        GameObject* gameObject = GameObjectManager::GetInstance()->Create("queueMesh" + std::to_string(n));
+
+        gameObject->AddComponent(ShaderManager::GetInstance()->Get("queueShader" + std::to_string(material / QueueTextureCount)));
+        gameObject->AddComponent(TextureManager::GetInstance()->Get("queueTexture" + std::to_string(material % QueueTextureCount)));
+        gameObject->AddComponent(Mesh::Create("queueMesh", geometries[random() % QueueGeometryCount]))->Generate();
+        gameObject->GetComponent<Transform>()->SetLocalPosition(Vector3f{ static_cast<float>(n % 100), 0.0f, static_cast<float>(n / 100) });
+    }
+}
+
+Test_Case(SortKeyPacksEveryField)
+{
+    const ullong key = SortKey::Create(3, 17, 900, 40000, 2000, 1.0f);
+
+    Test_Assert(SortKey::GetPass(key) == 3);
+    Test_Assert(SortKey::GetRootSignature(key) == 17);
+    Test_Assert(SortKey::GetPipeline(key) == 900);
+    Test_Assert(SortKey::GetMaterial(key) == 40000);
+    Test_Assert(SortKey::GetGeometry(key) == 2000);
+
+    Test_Assert(SortKey::Create(1, 0, 0, 0, 0, 0.0f) > SortKey::Create(0, 255, 4095, 65535, 4095, 1000.0f));
+    Test_Assert(SortKey::Create(0, 0, 1, 0, 0, 0.0f) > SortKey::Create(0, 0, 0, 65535, 4095, 1000.0f));
+}
+
+Test_Case(SortKeyOrdersDepth)
+{
+    const Array<float, 6> depths = { -50.0f, -1.0f, 0.0f, 1.0f, 8.0f, 500.0f };
+
+    for (Size d = 1; d < depths.size(); ++d)
+    {
+        Test_Assert(SortKey::Create(0, 0, 0, 0, 0, depths[d - 1]) < SortKey::Create(0, 0, 0, 0, 0, depths[d]));
+        Test_Assert(SortKey::Create(0, 0, 0, 0, 0, depths[d - 1], true) > SortKey::Create(0, 0, 0, 0, 0, depths[d], true));
+    }
+
+    Test_Assert(SortKey::Create(0, 0, 0, 1, 0, 500.0f, true) > SortKey::Create(0, 0, 0, 0, 0, -50.0f, true));
+}
+
+Test_Case(QueueEmitsStateOnlyWhenKeysChange)
+{
+    constexpr Size MeshCount = 2000;
+
+    CreateQueueScene(MeshCount);
+
+    RenderStar::RenderStarEngine::RunHeadless(2);
+
+    const RenderQueueStatistics& statistics = RenderQueue::GetInstance()->GetStatistics();
+    const RecordingCommandContext& recording = Renderer::GetInstance()->GetFrameRecording();
+
+    const Size materialCount = QueueShaderCount * QueueTextureCount;
+
+    Test_Assert(statistics.itemCount == MeshCount);
+    Test_Assert(statistics.pipelineChanges <= QueueShaderCount);
+    Test_Assert(statistics.materialChanges <= materialCount);
+    Test_Assert(statistics.drawCount <= materialCount * QueueGeometryCount);
+    Test_Assert(statistics.stateChangesAvoided > 0);
+    Test_Assert(recording.GetStatistics().instanceCount == MeshCount);
+    Test_Assert(recording.GetRedundantCommands().empty());
+}
+
+Test_Benchmark(QueueFiftyThousandDrawsOverTwentyMaterials)
+{
+    constexpr Size MeshCount = 50000;
+    constexpr uint Frames = 20;
+
+    CreateQueueScene(MeshCount);
+
+    RenderStar::RenderStarEngine::RunHeadless(2);
+
+    const double time = TestRegistry::Measure([&] { RenderStar::RenderStarEngine::RunHeadless(Frames); });
+
+    const RenderQueueStatistics& statistics = RenderQueue::GetInstance()->GetStatistics();
+
+    TestRegistry::Report("Frame with " + std::to_string(statistics.itemCount) + " items in " + std::to_string(statistics.drawCount) + " draws (" + std::to_string(statistics.stateChangesAvoided) + " state changes avoided)", time / Frames, "ms");
+}
\ No newline at end of file
@@ -0,0 +1,28 @@
+#include "Test.hpp"
+
+int main(int argc, char** argv)
+{
+	String filter;
+	bool includeBenchmarks = false;
+
+	for (int argument = 1; argument < argc; ++argument)
+	{
+		if (String(argv[argument]) == "--benchmarks")
+			includeBenchmarks = true;
+		else
+			filter = argv[argument];
+	}
+
+	RenderStar::RenderStarEngine::PreInitialize();
+
+	RenderStar::Core::Settings::GetInstance()->Set<String>("defaultDomain", "RenderStar");
+	RenderStar::Core::Settings::GetInstance()->Set<bool>("headless", true);
+
+	RenderStar::RenderStarEngine::Initialize();
+
+	const int result = RenderStar::Tests::TestRegistry::GetInstance()->Run(filter, includeBenchmarks);
+
+	RenderStar::RenderStarEngine::CleanUp();
+
+	return result;
+}
\ No newline at end of file
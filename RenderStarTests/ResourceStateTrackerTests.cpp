@@ -0,0 +1,159 @@
+#include "Test.hpp"
+
+using namespace RenderStar::Render;
+
+static ID3D12Resource* const TrackedTexture = reinterpret_cast<ID3D12Resource*>(0x7000);
+static ID3D12Resource* const TrackedBuffer = reinterpret_cast<ID3D12Resource*>(0x8000);
+
+static bool IsTransition(const D3D12_RESOURCE_BARRIER& barrier, ID3D12Resource* resource, D3D12_RESOURCE_STATES before, D3D12_RESOURCE_STATES after)
+{
+    return barrier.Type == D3D12_RESOURCE_BARRIER_TYPE_TRANSITION && barrier.Transition.pResource == resource && barrier.Transition.StateBefore == before && barrier.Transition.StateAfter == after;
+}
+
+class ParallelTransitionComponent : public Component
+{
+
+public:
+
+    void Render() override
+    {
+        Renderer::GetInstance()->RecordParallel(2, 1, [](Size begin, Size end)
+        {
+            for (Size b = begin; b < end; ++b)
+            {
+                CommandContext* context = Renderer::GetInstance()->GetCommandContext();
+
+                context->TransitionResource(TrackedTexture, b == 0 ? D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE : D3D12_RESOURCE_STATE_RENDER_TARGET);
+                context->TransitionResource(TrackedBuffer, D3D12_RESOURCE_STATE_VERTEX_AND_CONSTANT_BUFFER);
+                context->FlushBarriers();
+            }
+        });
+    }
+};
+
+Test_Case(TransitionThereAndBackCancels)
+{
+    ResourceStateRegistry registry;
+    ResourceStateTracker tracker;
+
+    registry.Register(TrackedTexture, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+
+    tracker.Reset(&registry);
+    tracker.Transition(TrackedTexture, D3D12_RESOURCE_STATE_RENDER_TARGET);
+    tracker.Transition(TrackedTexture, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+
+    Test_Assert(tracker.GetPendingBarriers().empty());
+    Test_Assert(tracker.GetStatistics().droppedCount == 2);
+
+    Vector<D3D12_RESOURCE_BARRIER> preamble;
+    ResourceStateStatistics statistics;
+
+    tracker.Resolve(registry, preamble, statistics);
+
+    Test_Assert(preamble.empty());
+    Test_Assert(registry.GetState(TrackedTexture) == D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+
+    tracker.Reset();
+    tracker.Transition(TrackedTexture, D3D12_RESOURCE_STATE_RENDER_TARGET);
+    tracker.Transition(TrackedTexture, D3D12_RESOURCE_STATE_COPY_SOURCE);
+    tracker.Transition(TrackedTexture, D3D12_RESOURCE_STATE_RENDER_TARGET);
+
+    Test_Assert(tracker.GetPendingBarriers().empty());
+
+    tracker.Resolve(registry, preamble, statistics);
+
+    Test_Assert(preamble.size() == 1);
+    Test_Assert(IsTransition(preamble[0], TrackedTexture, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE, D3D12_RESOURCE_STATE_RENDER_TARGET));
+    Test_Assert(registry.GetState(TrackedTexture) == D3D12_RESOURCE_STATE_RENDER_TARGET);
+}
+
+Test_Case(ChainedTransitionsMerge)
+{
+    ResourceStateRegistry registry;
+    ResourceStateTracker tracker;
+
+    registry.Register(TrackedTexture, D3D12_RESOURCE_STATE_COPY_DEST);
+
+    tracker.Reset(&registry);
+    tracker.Transition(TrackedTexture, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+    tracker.Transition(TrackedTexture, D3D12_RESOURCE_STATE_RENDER_TARGET);
+
+    Span<const D3D12_RESOURCE_BARRIER> barriers = tracker.GetPendingBarriers();
+
+    Test_Assert(barriers.size() == 1);
+    Test_Assert(IsTransition(barriers[0], TrackedTexture, D3D12_RESOURCE_STATE_COPY_DEST, D3D12_RESOURCE_STATE_RENDER_TARGET));
+
+    tracker.Reset();
+    tracker.Transition(TrackedTexture, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+    tracker.Transition(TrackedTexture, D3D12_RESOURCE_STATE_COPY_SOURCE);
+    tracker.Transition(TrackedTexture, D3D12_RESOURCE_STATE_RENDER_TARGET);
+
+    barriers = tracker.GetPendingBarriers();
+
+    Test_Assert(barriers.size() == 1);
+    Test_Assert(IsTransition(barriers[0], TrackedTexture, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE, D3D12_RESOURCE_STATE_RENDER_TARGET));
+}
+
+Test_Case(BuffersPromoteFromCommonAndDecay)
+{
+    ResourceStateRegistry registry;
+    ResourceStateTracker tracker;
+
+    registry.Register(TrackedBuffer, D3D12_RESOURCE_STATE_COMMON, true);
+    registry.Register(TrackedTexture, D3D12_RESOURCE_STATE_COMMON);
+
+    tracker.Reset(&registry);
+    tracker.Transition(TrackedBuffer, D3D12_RESOURCE_STATE_VERTEX_AND_CONSTANT_BUFFER);
+    tracker.Transition(TrackedTexture, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+
+    Span<const D3D12_RESOURCE_BARRIER> barriers = tracker.GetPendingBarriers();
+
+    Test_Assert(barriers.size() == 1);
+    Test_Assert(IsTransition(barriers[0], TrackedTexture, D3D12_RESOURCE_STATE_COMMON, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE));
+    Test_Assert(tracker.GetStatistics().promotedCount == 1);
+    Test_Assert(registry.GetState(TrackedBuffer) == D3D12_RESOURCE_STATE_VERTEX_AND_CONSTANT_BUFFER);
+
+    registry.Decay();
+
+    Test_Assert(registry.GetState(TrackedBuffer) == D3D12_RESOURCE_STATE_COMMON);
+    Test_Assert(registry.GetState(TrackedTexture) == D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+}
+
+Test_Case(ParallelRecordingResolvesPreambleBarriers)
+{
+    ResourceStateRegistry& registry = Renderer::GetInstance()->GetResourceStates();
+
+    registry.Register(TrackedTexture, D3D12_RESOURCE_STATE_COPY_DEST);
+    registry.Register(TrackedBuffer, D3D12_RESOURCE_STATE_COMMON, true);
+
+    GameObjectManager::GetInstance()->Create("transitions")->AddComponent(std::make_shared<ParallelTransitionComponent>());
+
+    RenderStar::RenderStarEngine::RunHeadless(1);
+
+    Vector<Array<ullong, 3>> barriers;
+
+    for (const RenderCommand& command : Renderer::GetInstance()->GetFrameRecording().GetStream().GetCommands())
+    {
+        if (command.type != RenderCommandType::RESOURCE_BARRIER)
+            continue;
+
+        if (command.arguments[0] == reinterpret_cast<ullong>(TrackedTexture) || command.arguments[0] == reinterpret_cast<ullong>(TrackedBuffer))
+            barriers.push_back({ command.arguments[0], command.arguments[1], command.arguments[2] });
+    }
+
+    const ullong texture = reinterpret_cast<ullong>(TrackedTexture);
+
+    const Array<ullong, 3> firstPreamble = { texture, D3D12_RESOURCE_STATE_COPY_DEST, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE };
+    const Array<ullong, 3> secondPreamble = { texture, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE, D3D12_RESOURCE_STATE_RENDER_TARGET };
+
+    Test_Assert(Renderer::GetInstance()->GetFrameStatistics().commandListCount == 6);
+    Test_Assert(barriers.size() == 2);
+    Test_Assert(barriers[0] == firstPreamble);
+    Test_Assert(barriers[1] == secondPreamble);
+
+    Test_Assert(registry.GetState(TrackedTexture) == D3D12_RESOURCE_STATE_RENDER_TARGET);
+    Test_Assert(registry.GetState(TrackedBuffer) == D3D12_RESOURCE_STATE_COMMON);
+
+    registry.Unregister(TrackedTexture);
+    registry.Unregister(TrackedBuffer);
+}
\ No newline at end of file
@@ -0,0 +1,148 @@
+#include "Test.hpp"
+
+Test_Case(RingAllocatorWrapsAroundRetiredSubmissions)
+{
+    RingAllocator ring(1024);
+
+    Test_Assert(*ring.Allocate(400) == 0);
+    Test_Assert(*ring.Allocate(100, 256) == 512);
+
+    ring.Close(1);
+
+    Test_Assert(*ring.Allocate(300) == 612);
+
+    ring.Close(2);
+
+    Test_Assert(!ring.Allocate(200));
+
+    ring.Retire(1);
+
+    const Optional<Size> wrapped = ring.Allocate(200);
+
+    Test_Assert(wrapped && *wrapped == 0);
+    Test_Assert(ring.GetStatistics().wrapCount == 1);
+    Test_Assert(!ring.Allocate(413));
+
+    ring.Close(3);
+    ring.Retire(2);
+
+    Test_Assert(!ring.Allocate(713));
+    Test_Assert(*ring.Allocate(712) == 200);
+    Test_Assert(!ring.Allocate(1));
+
+    ring.Close(4);
+    ring.Retire(4);
+
+    Test_Assert(ring.GetStatistics().usedSize == 0);
+    Test_Assert(ring.GetStatistics().pendingFenceCount == 0);
+    Test_Assert(*ring.Allocate(1024) == 0);
+    Test_Assert(!ring.Allocate(1));
+}
+
+Test_Case(RingAllocatorHoldsMemoryUntilFenceCompletes)
+{
+    RingAllocator ring(256);
+
+    Test_Assert(*ring.Allocate(256) == 0);
+    Test_Assert(ring.HasOpenAllocations());
+
+    ring.Close(7);
+
+    Test_Assert(!ring.HasOpenAllocations());
+    Test_Assert(*ring.GetOldestFence() == 7);
+
+    ring.Retire(6);
+
+    Test_Assert(!ring.Allocate(1));
+    Test_Assert(ring.GetStatistics().pendingFenceCount == 1);
+
+    ring.Retire(7);
+
+    Test_Assert(!ring.GetOldestFence());
+    Test_Assert(*ring.Allocate(1) == 0);
+}
+
+Test_Case(RingAllocatorChurnNeverOverlapsLiveAllocations)
+{
+    constexpr Size Capacity = 4096;
+
+    RingAllocator ring(Capacity);
+
+    RandomEngine random(7);
+
+    struct LiveAllocation
+    {
+        ullong fenceValue;
+
+        Size offset;
+        Size size;
+    };
+
+    Vector<LiveAllocation> live;
+
+    ullong fenceValue = 1;
+    ullong completedValue = 0;
+
+    for (Size n = 0; n < 200000; ++n)
+    {
+        const Size size = 1 + random() % 700;
+        const Size alignment = Size(1) << (random() % 9);
+
+        const Optional<Size> offset = ring.Allocate(size, alignment);
+
+        if (offset)
+        {
+            Test_Assert(*offset % alignment == 0);
+            Test_Assert(*offset + size <= Capacity);
+
+            for (const LiveAllocation& allocation : live)
+                Test_Assert(*offset + size <= allocation.offset || allocation.offset + allocation.size <= *offset);
+
+            live.push_back({ fenceValue, *offset, size });
+        }
+
+        if (!offset || random() % 4 == 0)
+            ring.Close(fenceValue++);
+
+        if (!offset)
+            completedValue = fenceValue - 1;
+        else if (random() % 3 == 0 && completedValue + 1 < fenceValue)
+            completedValue++;
+
+        ring.Retire(completedValue);
+
+        std::erase_if(live, [completedValue](const LiveAllocation& allocation) { return allocation.fenceValue <= completedValue; });
+    }
+
+    Test_Assert(ring.GetStatistics().wrapCount > 0);
+    Test_Assert(ring.GetStatistics().peakUsedSize <= Capacity);
+}
+
+Test_Benchmark(RingAllocatorMillionAllocations)
+{
+    RingAllocator ring(64 * 1024 * 1024);
+
+    constexpr Size Allocations = 1000000;
+    constexpr Size AllocationsPerFrame = 1000;
+
+    ullong fenceValue = 0;
+
+    const double time = TestRegistry::Measure([&]
+    {
+        for (Size n = 0; n < Allocations; ++n)
+        {
+            ring.Allocate(256 + n % 1024, 256);
+
+            if ((n + 1) % AllocationsPerFrame == 0)
+            {
+                ring.Close(++fenceValue);
+
+                if (fenceValue > 3)
+                    ring.Retire(fenceValue - 3);
+            }
+        }
+    });
+
+    TestRegistry::Report("Ring allocate " + std::to_string(Allocations) + " blocks", time, "ms");
+    TestRegistry::Report("Ring allocator wrapped", static_cast<double>(ring.GetStatistics().wrapCount), "times");
+}
\ No newline at end of file
@@ -0,0 +1,417 @@
+#include "Test.hpp"
+#include "RenderStar/Render/SceneSerializer.hpp"
+
+using namespace RenderStar::ECS;
+using namespace RenderStar::Render;
+
+static const Vector<Vertex> TriangleVertices =
+{
+    { { 0.0f, 0.5f, 0.0f }, { 1.0f, 1.0f, 1.0f }, { 0.0f, 0.0f, 1.0f }, { 0.5f, 0.0f } },
+    { { 0.5f, -0.5f, 0.0f }, { 1.0f, 1.0f, 1.0f }, { 0.0f, 0.0f, 1.0f }, { 1.0f, 1.0f } },
+    { { -0.5f, -0.5f, 0.0f }, { 1.0f, 1.0f, 1.0f }, { 0.0f, 0.0f, 1.0f }, { 0.0f, 1.0f } }
+};
+
+static const Vector<uint> TriangleIndices = { 0, 1, 2 };
+
+static String GetScenePath(const String& name)
+{
+    return (std::filesystem::temp_directory_path() / (name + ".rscene")).string();
+}
+
+static void RegisterSceneTextures()
+{
+    if (!TextureManager::GetInstance()->Get("sceneTextureA"))
+        TextureManager::GetInstance()->Register(Texture::Create("sceneTextureA", "Texture/Test.dds"));
+
+    if (!TextureManager::GetInstance()->Get("sceneTextureB"))
+        TextureManager::GetInstance()->Register(Texture::Create("sceneTextureB", "Texture/Test.dds"));
+}
+
+static GameObject* CreateSceneObject(const String& name, const String& texture, const Shared<MeshGeometry>& geometry)
+{
+    GameObject* out = GameObjectManager::GetInstance()->Create(name);
+
+    out->AddComponent(ShaderManager::GetInstance()->Get("default"));
+    out->AddComponent(TextureManager::GetInstance()->Get(texture));
+    out->AddComponent(Mesh::Create(name, geometry));
+
+    return out;
+}
+
+static Vector<uchar> ReadSceneBytes(const String& path)
+{
+    InputFileStream stream(path, std::ios::binary);
+
+    return Vector<uchar>(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+}
+
+static void WriteSceneBytes(const String& path, const Vector<uchar>& bytes, Size size)
+{
+    OutputFileStream stream(path, std::ios::binary | std::ios::trunc);
+
+    stream.write(reinterpret_cast<const char*>(bytes.data()), static_cast<StreamSize>(size));
+}
+
+template<typename T>
+static void PatchScene(Vector<uchar>& bytes, ullong offset, const T& value)
+{
+    memcpy(bytes.data() + offset, &value, sizeof(T));
+}
+
+static bool IsRejected(const String& path, const Vector<uchar>& bytes, Size size)
+{
+    WriteSceneBytes(path, bytes, size);
+
+    return !SceneSerializer::Load(path, false) && GameObjectManager::GetInstance()->GetCount() == 0;
+}
+
+static void SaveTextScene(const String& path)
+{
+    OutputFileStream stream(path, std::ios::trunc);
+
+    UnorderedMap<const MeshGeometry*, Size> geometryIndices;
+    Vector<Shared<const MeshGeometry>> geometries;
+    UnorderedMap<Entity, Size> entityIndices;
+
+    for (GameObject* gameObject : GameObjectManager::GetInstance()->GetGameObjects())
+    {
+        Shared<const MeshGeometry> geometry = gameObject->GetComponent<Mesh>()->GetGeometry();
+
+        if (geometryIndices.emplace(geometry.get(), geometries.size()).second)
+            geometries.push_back(geometry);
+    }
+
+    stream << geometries.size() << '\n';
+
+    for (const Shared<const MeshGeometry>& geometry : geometries)
+    {
+        stream << geometry->GetVertices().size() << ' ' << geometry->GetIndices().size() << '\n';
+
+        for (const Vertex& vertex : geometry->GetVertices())
+            stream << vertex.position.x << ' ' << vertex.position.y << ' ' << vertex.position.z << ' ' << vertex.color.x << ' ' << vertex.color.y << ' ' << vertex.color.z << ' ' << vertex.normal.x << ' ' << vertex.normal.y << ' ' << vertex.normal.z << ' ' << vertex.textureCoordinates.x << ' ' << vertex.textureCoordinates.y << '\n';
+
+        for (uint index : geometry->GetIndices())
+            stream << index << ' ';
+
+        stream << '\n';
+    }
+
+    stream << GameObjectManager::GetInstance()->GetCount() << '\n';
+
+    for (GameObject* gameObject : GameObjectManager::GetInstance()->GetGameObjects())
+    {
+        Transform* transform = gameObject->GetComponent<Transform>();
+
+        Vector3f position, rotation, scale;
+
+        DirectX::XMStoreFloat3(&position, transform->GetLocalPosition());
+        DirectX::XMStoreFloat3(&rotation, transform->GetLocalRotation());
+        DirectX::XMStoreFloat3(&scale, transform->GetLocalScale());
+
+        const long long parent = gameObject->GetParentEntity().IsNull() ? -1 : static_cast<long long>(entityIndices[gameObject->GetParentEntity()]);
+
+        entityIndices[gameObject->GetEntity()] = entityIndices.size();
+
+        stream << gameObject->name << ' ' << parent << ' ' << geometryIndices[gameObject->GetComponent<Mesh>()->GetGeometry().get()] << ' ' << gameObject->GetComponent<Shader>()->GetName() << ' ' << gameObject->GetComponent<Texture>()->GetName() << ' ' << gameObject->isActive << ' ';
+        stream << position.x << ' ' << position.y << ' ' << position.z << ' ' << rotation.x << ' ' << rotation.y << ' ' << rotation.z << ' ' << scale.x << ' ' << scale.y << ' ' << scale.z << '\n';
+    }
+}
+
+static bool LoadTextScene(const String& path)
+{
+    InputFileStream stream(path);
+
+    if (!stream.is_open())
+        return false;
+
+    Size geometryCount = 0;
+    stream >> geometryCount;
+
+    Vector<Shared<MeshGeometry>> geometries(geometryCount);
+
+    for (Shared<MeshGeometry>& geometry : geometries)
+    {
+        Size vertexCount = 0, indexCount = 0;
+        stream >> vertexCount >> indexCount;
+
+        Vector<Vertex> vertices(vertexCount);
+        Vector<uint> indices(indexCount);
+
+        for (Vertex& vertex : vertices)
+            stream >> vertex.position.x >> vertex.position.y >> vertex.position.z >> vertex.color.x >> vertex.color.y >> vertex.color.z >> vertex.normal.x >> vertex.normal.y >> vertex.normal.z >> vertex.textureCoordinates.x >> vertex.textureCoordinates.y;
+
+        for (uint& index : indices)
+            stream >> index;
+
+        geometry = MeshGeometry::Create(vertices, indices);
+    }
+
+    Size entityCount = 0;
+    stream >> entityCount;
+
+    Vector<GameObject*> gameObjects(entityCount);
+
+    for (GameObject*& gameObject : gameObjects)
+    {
+        String name, shader, texture;
+        long long parent = -1;
+        Size geometry = 0;
+        bool isActive = true;
+        Vector3f position, rotation, scale;
+
+        stream >> name >> parent >> geometry >> shader >> texture >> isActive;
+        stream >> position.x >> position.y >> position.z >> rotation.x >> rotation.y >> rotation.z >> scale.x >> scale.y >> scale.z;
+
+        if (!stream || geometry >= geometries.size())
+            return false;
+
+        gameObject = GameObjectManager::GetInstance()->Create(name);
+
+        gameObject->AddComponent(ShaderManager::GetInstance()->Get(shader));
+        gameObject->AddComponent(TextureManager::GetInstance()->Get(texture));
+        gameObject->AddComponent(Mesh::Create(name, geometries[geometry]));
+
+        Transform* transform = gameObject->GetComponent<Transform>();
+
+        transform->SetLocalPosition(position);
+        transform->SetLocalRotation(rotation);
+        transform->SetLocalScale(scale);
+
+        if (parent >= 0)
+            gameObjects[parent]->AddChild(gameObject);
+
+        gameObject->isActive = isActive;
+    }
+
+    return true;
+}
+
+Test_Case(SceneRoundTripPreservesObjects)
+{
+    RegisterSceneTextures();
+
+    Shared<GameObjectManager> manager = GameObjectManager::GetInstance();
+    Shared<MeshGeometry> geometry = MeshGeometry::Create(TriangleVertices, TriangleIndices);
+
+    manager->CleanUp();
+
+    GameObject* root = CreateSceneObject("root", "sceneTextureA", geometry);
+    GameObject* child = CreateSceneObject("child", "sceneTextureB", geometry);
+
+    root->GetComponent<Transform>()->SetLocalPosition(Vector3f{ 1.0f, 2.0f, 3.0f });
+    root->AddChild(child);
+    child->isActive = false;
+
+    const String path = GetScenePath("SceneRoundTripPreservesObjects");
+
+    Test_Assert(SceneSerializer::Save(path));
+
+    manager->CleanUp();
+
+    const Size archetypeCount = World::GetInstance()->GetArchetypeCount();
+
+    Test_Assert(SceneSerializer::Load(path, false));
+
+    GameObject* loadedRoot = manager->Get("root");
+    GameObject* loadedChild = manager->Get("child");
+
+    Test_Assert(manager->GetCount() == 2);
+    Test_Assert(loadedRoot && loadedChild && loadedChild->GetParent() == loadedRoot);
+    Test_Assert(loadedRoot->isActive && !loadedChild->isActive);
+    Test_Assert(World::GetInstance()->GetArchetypeCount() == archetypeCount);
+
+    Vector3f position;
+    DirectX::XMStoreFloat3(&position, loadedRoot->GetComponent<Transform>()->GetLocalPosition());
+
+    Test_Assert(position.x == 1.0f && position.y == 2.0f && position.z == 3.0f);
+
+    Test_Assert(loadedRoot->GetComponent<Texture>()->GetName() == "sceneTextureA");
+    Test_Assert(loadedChild->GetComponent<Texture>()->GetName() == "sceneTextureB");
+
+    Shared<Mesh> rootMesh = loadedRoot->GetComponent<Mesh>();
+    Shared<Mesh> childMesh = loadedChild->GetComponent<Mesh>();
+
+    Test_Assert(rootMesh->GetName() == "root" && childMesh->GetName() == "child");
+    Test_Assert(rootMesh->GetGeometry()->IsView());
+    Test_Assert(rootMesh->GetGeometry()->GetVertices().size() == TriangleVertices.size());
+    Test_Assert(std::equal(TriangleIndices.begin(), TriangleIndices.end(), rootMesh->GetGeometry()->GetIndices().begin()));
+
+    rootMesh->GetMutableGeometry().indices.push_back(0);
+
+    Test_Assert(!rootMesh->GetGeometry()->IsView() && rootMesh->GetGeometry()->GetIndices().size() == TriangleIndices.size() + 1);
+    Test_Assert(childMesh->GetGeometry()->GetIndices().size() == TriangleIndices.size());
+
+    manager->CleanUp();
+
+    std::filesystem::remove(path);
+}
+
+Test_Case(TruncatedScenesAreRejected)
+{
+    RegisterSceneTextures();
+
+    Shared<GameObjectManager> manager = GameObjectManager::GetInstance();
+    Shared<MeshGeometry> geometry = MeshGeometry::Create(TriangleVertices, TriangleIndices);
+
+    manager->CleanUp();
+
+    CreateSceneObject("root", "sceneTextureA", geometry)->AddChild(CreateSceneObject("child", "sceneTextureB", geometry));
+
+    const String path = GetScenePath("TruncatedScenesAreRejected");
+
+    Test_Assert(SceneSerializer::Save(path));
+
+    manager->CleanUp();
+
+    const Vector<uchar> bytes = ReadSceneBytes(path);
+
+    SceneHeader header = {};
+    memcpy(&header, bytes.data(), sizeof(SceneHeader));
+
+    Test_Assert(header.fileSize == bytes.size());
+
+    const Array<Size, 7> lengths = { 0, sizeof(SceneHeader) - 1, sizeof(SceneHeader), header.entityTableOffset + 1, header.meshTableOffset + 1, header.meshTableOffset + header.meshCount * sizeof(SceneMesh), bytes.size() - 1 };
+
+    for (Size length : lengths)
+    {
+        Test_Assert(IsRejected(path, bytes, length));
+
+        if (length < sizeof(SceneHeader))
+            continue;
+
+        Vector<uchar> patched = bytes;
+
+        PatchScene(patched, offsetof(SceneHeader, fileSize), static_cast<ullong>(length));
+
+        Test_Assert(IsRejected(path, patched, length));
+    }
+
+    WriteSceneBytes(path, bytes, bytes.size());
+
+    Test_Assert(SceneSerializer::Load(path, false));
+    Test_Assert(manager->GetCount() == 2);
+
+    manager->CleanUp();
+
+    std::filesystem::remove(path);
+}
+
+Test_Case(ScenesWithBadHeadersOrOffsetsAreRejected)
+{
+    RegisterSceneTextures();
+
+    Shared<GameObjectManager> manager = GameObjectManager::GetInstance();
+
+    manager->CleanUp();
+
+    CreateSceneObject("root", "sceneTextureA", MeshGeometry::Create(TriangleVertices, TriangleIndices));
+
+    const String path = GetScenePath("ScenesWithBadHeadersOrOffsetsAreRejected");
+
+    Test_Assert(SceneSerializer::Save(path));
+
+    manager->CleanUp();
+
+    const Vector<uchar> bytes = ReadSceneBytes(path);
+
+    SceneHeader header = {};
+    memcpy(&header, bytes.data(), sizeof(SceneHeader));
+
+    const ullong meshOffset = header.meshTableOffset;
+    const ullong fileSize = bytes.size();
+
+    Vector<uchar> patched = bytes;
+    PatchScene(patched, offsetof(SceneHeader, magic), SceneMagic ^ 1u);
+
+    Test_Assert(IsRejected(path, patched, patched.size()));
+
+    patched = bytes;
+    PatchScene(patched, offsetof(SceneHeader, version), SceneVersion + 1);
+
+    Test_Assert(IsRejected(path, patched, patched.size()));
+
+    patched = bytes;
+    PatchScene(patched, offsetof(SceneHeader, entityCount), header.entityCount + 1024);
+
+    Test_Assert(IsRejected(path, patched, patched.size()));
+
+    patched = bytes;
+    PatchScene(patched, offsetof(SceneHeader, stringTableOffset), fileSize);
+
+    Test_Assert(IsRejected(path, patched, patched.size()));
+
+    patched = bytes;
+    PatchScene(patched, header.stringTableOffset + offsetof(SceneString, offset), fileSize - 1);
+
+    Test_Assert(IsRejected(path, patched, patched.size()));
+
+    patched = bytes;
+    PatchScene(patched, meshOffset + offsetof(SceneMesh, vertexOffset), fileSize);
+
+    Test_Assert(IsRejected(path, patched, patched.size()));
+
+    patched = bytes;
+    PatchScene(patched, meshOffset + offsetof(SceneMesh, indexCount), ~0u);
+
+    Test_Assert(IsRejected(path, patched, patched.size()));
+
+    patched = bytes;
+    PatchScene(patched, header.entityTableOffset + offsetof(SceneEntity, mesh), header.meshCount);
+
+    Test_Assert(IsRejected(path, patched, patched.size()));
+
+    std::filesystem::remove(path);
+}
+
+Test_Benchmark(SceneLoadHundredThousandObjects)
+{
+    RegisterSceneTextures();
+
+    Shared<GameObjectManager> manager = GameObjectManager::GetInstance();
+    Shared<MeshGeometry> geometry = MeshGeometry::Create(TriangleVertices, TriangleIndices);
+
+    constexpr Size ObjectCount = 100000;
+
+    manager->CleanUp();
+
+    const double createTime = TestRegistry::Measure([&]
+    {
+        for (Size n = 0; n < ObjectCount; ++n)
+            CreateSceneObject("object" + std::to_string(n), n % 2 ? "sceneTextureB" : "sceneTextureA", geometry);
+    });
+
+    const String path = GetScenePath("SceneLoadHundredThousandObjects");
+    const String textPath = path + ".txt";
+
+    Test_Assert(SceneSerializer::Save(path));
+
+    SaveTextScene(textPath);
+
+    manager->CleanUp();
+
+    const double loadTime = TestRegistry::Measure([&]
+    {
+        Test_Assert(SceneSerializer::Load(path, false));
+    });
+
+    Test_Assert(manager->GetCount() == ObjectCount);
+
+    manager->CleanUp();
+
+    const double textLoadTime = TestRegistry::Measure([&]
+    {
+        Test_Assert(LoadTextScene(textPath));
+    });
+
+    Test_Assert(manager->GetCount() == ObjectCount);
+
+    manager->CleanUp();
+
+    std::filesystem::remove(path);
+    std::filesystem::remove(textPath);
+
+    TestRegistry::Report("Create " + std::to_string(ObjectCount) + " objects through GameObject API", createTime, "ms");
+    TestRegistry::Report("Load " + std::to_string(ObjectCount) + " objects from a text scene", textLoadTime, "ms");
+    TestRegistry::Report("Load " + std::to_string(ObjectCount) + " objects through SceneSerializer", loadTime, "ms");
+    TestRegistry::Report("Binary load speedup over text", textLoadTime / loadTime, "x");
+}
\ No newline at end of file
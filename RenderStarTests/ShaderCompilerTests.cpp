@@ -0,0 +1,243 @@
+#include "Test.hpp"
+
+using namespace RenderStar::Render;
+
+static const String ShaderCommonSource =
+    "#ifndef VARIANT\n"
+    "#define VARIANT 1\n"
+    "#endif\n"
+    "static const float Scale = 1.0f;\n";
+
+static const String ShaderPixelSource = "float4 Main() : SV_TARGET { return float4(1.0f, 1.0f, 1.0f, 1.0f); }\n";
+
+class ShaderCacheDirectory
+{
+
+public:
+
+    explicit ShaderCacheDirectory(const String& name)
+    {
+        root = std::filesystem::temp_directory_path() / ("RenderStarTests" + name);
+
+        std::error_code error;
+
+        std::filesystem::remove_all(root, error);
+        std::filesystem::create_directories(root, error);
+
+        previousCachePath = Settings::GetInstance()->Get<String>("shaderCachePath");
+
+        Settings::GetInstance()->Set<String>("shaderCachePath", (root / "Cache").string());
+
+        WriteCommon(ShaderCommonSource);
+    }
+
+    ~ShaderCacheDirectory()
+    {
+        Settings::GetInstance()->Set<String>("shaderCachePath", previousCachePath);
+
+        std::error_code error;
+
+        std::filesystem::remove_all(root, error);
+    }
+
+    void WriteCommon(const String& source) const
+    {
+        Write("Common.hlsli", source);
+    }
+
+    String WriteVertex(const String& name) const
+    {
+        return Write(name + "Vertex.hlsl", "#include \"" + (root / "Common.hlsli").generic_string() + "\"\nfloat4 Main(float3 position : POSITION) : SV_POSITION { return float4(position * Scale * VARIANT, 1.0f); }\n");
+    }
+
+    String WritePixel(const String& name) const
+    {
+        return Write(name + "Pixel.hlsl", ShaderPixelSource);
+    }
+
+    static Shared<ShaderCompiler> CreateCompiler()
+    {
+        Shared<ShaderCompiler> out = std::make_shared<ShaderCompiler>();
+
+        out->Initialize();
+
+        return out;
+    }
+
+private:
+
+    String Write(const String& name, const String& source) const
+    {
+        const Path path = root / name;
+
+        OutputFileStream stream(path, std::ios::binary | std::ios::trunc);
+
+        stream << source;
+
+        return path.string();
+    }
+
+    Path root;
+
+    String previousCachePath;
+};
+
+Test_Case(ShaderCacheHitsOnSecondCompile)
+{
+    ShaderCacheDirectory directory("ShaderCacheHitsOnSecondCompile");
+
+    const String vertexPath = directory.WriteVertex("Cached");
+    const String pixelPath = directory.WritePixel("Cached");
+
+    Shared<ShaderCompiler> cold = ShaderCacheDirectory::CreateCompiler();
+
+    Test_Assert(cold->Compile(vertexPath, L"vs_6_6").Get() != nullptr);
+    Test_Assert(cold->Compile(pixelPath, L"ps_6_6").Get() != nullptr);
+    Test_Assert(cold->Compile(vertexPath + ".missing", L"vs_6_6").Get() == nullptr);
+
+    Test_Assert(cold->GetStatistics().cacheMisses == 2);
+    Test_Assert(cold->GetStatistics().absentStages == 1);
+
+    Shared<ShaderCompiler> warm = ShaderCacheDirectory::CreateCompiler();
+
+    Test_Assert(warm->Compile(vertexPath, L"vs_6_6").Get() != nullptr);
+    Test_Assert(warm->Compile(pixelPath, L"ps_6_6").Get() != nullptr);
+    Test_Assert(warm->Compile(vertexPath, L"vs_6_6", { "VARIANT=2" }).Get() != nullptr);
+
+    Test_Assert(warm->GetStatistics().cacheHits == 2);
+    Test_Assert(warm->GetStatistics().cacheMisses == 1);
+    Test_Assert(warm->GetStatistics().permutationCompiles == 1);
+}
+
+Test_Case(TouchingAnIncludeInvalidatesDependentShaders)
+{
+    ShaderCacheDirectory directory("TouchingAnIncludeInvalidatesDependentShaders");
+
+    const String vertexPath = directory.WriteVertex("Include");
+    const String pixelPath = directory.WritePixel("Include");
+
+    Shared<ShaderCompiler> cold = ShaderCacheDirectory::CreateCompiler();
+
+    cold->Compile(vertexPath, L"vs_6_6");
+    cold->Compile(pixelPath, L"ps_6_6");
+
+    directory.WriteCommon(ShaderCommonSource + "static const float Bias = 0.0f;\n");
+
+    Shared<ShaderCompiler> touched = ShaderCacheDirectory::CreateCompiler();
+
+    Test_Assert(touched->Compile(vertexPath, L"vs_6_6").Get() != nullptr);
+    Test_Assert(touched->Compile(pixelPath, L"ps_6_6").Get() != nullptr);
+
+    Test_Assert(touched->GetStatistics().invalidations == 1);
+    Test_Assert(touched->GetStatistics().cacheMisses == 1);
+    Test_Assert(touched->GetStatistics().cacheHits == 1);
+
+    Shared<ShaderCompiler> warm = ShaderCacheDirectory::CreateCompiler();
+
+    warm->Compile(vertexPath, L"vs_6_6");
+
+    Test_Assert(warm->GetStatistics().cacheHits == 1);
+    Test_Assert(warm->GetStatistics().invalidations == 0);
+}
+
+Test_Case(IncludeEditsAreSeenByALongLivedCompiler)
+{
+    ShaderCacheDirectory directory("IncludeEditsAreSeenByALongLivedCompiler");
+
+    const String vertexPath = directory.WriteVertex("LongLived");
+
+    Shared<ShaderCompiler> compiler = ShaderCacheDirectory::CreateCompiler();
+
+    Test_Assert(compiler->Compile(vertexPath, L"vs_6_6").Get() != nullptr);
+    Test_Assert(compiler->Compile(vertexPath, L"vs_6_6").Get() != nullptr);
+
+    Test_Assert(compiler->GetStatistics().cacheMisses == 1);
+    Test_Assert(compiler->GetStatistics().cacheHits == 1);
+
+    directory.WriteCommon(ShaderCommonSource + "static const float Bias = 0.0f;\n");
+
+    Test_Assert(compiler->Compile(vertexPath, L"vs_6_6").Get() != nullptr);
+
+    Test_Assert(compiler->GetStatistics().invalidations == 1);
+    Test_Assert(compiler->GetStatistics().cacheMisses == 2);
+
+    Test_Assert(compiler->Compile(vertexPath, L"vs_6_6").Get() != nullptr);
+
+    Test_Assert(compiler->GetStatistics().invalidations == 1);
+    Test_Assert(compiler->GetStatistics().cacheHits == 2);
+}
+
+Test_Benchmark(ShaderCompileColdVersusWarmCache)
+{
+    ShaderCacheDirectory directory("ShaderCompileColdVersusWarmCache");
+
+    constexpr Size VariantCount = 32;
+
+    const String vertexPath = directory.WriteVertex("Benchmark");
+
+    const auto compileAll = [&vertexPath](ShaderCompiler& compiler)
+    {
+        for (Size v = 0; v < VariantCount; ++v)
+            compiler.Compile(vertexPath, L"vs_6_6", { "VARIANT=" + std::to_string(v + 1) });
+    };
+
+    Shared<ShaderCompiler> cold = ShaderCacheDirectory::CreateCompiler();
+    Shared<ShaderCompiler> warm = ShaderCacheDirectory::CreateCompiler();
+
+    const double coldTime = TestRegistry::Measure([&] { compileAll(*cold); });
+    const double warmTime = TestRegistry::Measure([&] { compileAll(*warm); });
+
+    Test_Assert(cold->GetStatistics().cacheMisses == VariantCount);
+    Test_Assert(warm->GetStatistics().cacheHits == VariantCount);
+
+    TestRegistry::Report("Compile " + std::to_string(VariantCount) + " vertex stages, cold cache", coldTime, "ms");
+    TestRegistry::Report("Compile " + std::to_string(VariantCount) + " vertex stages, warm cache", warmTime, "ms");
+}
+
+Test_Benchmark(ParallelShaderCompileScaling)
+{
+    ShaderCacheDirectory directory("ParallelShaderCompileScaling");
+
+    Settings::GetInstance()->Set<String>("shaderCachePath", "");
+
+    constexpr Size PermutationCount = 128;
+
+    const String vertexPath = directory.WriteVertex("Parallel");
+
+    const Shared<JobSystem> jobSystem = JobSystem::GetInstance();
+    const uint maximumThreads = std::max(2u, Thread::hardware_concurrency());
+
+    double serialTime = 0.0;
+
+    for (uint threads = 1; threads <= maximumThreads; threads *= 2)
+    {
+        Shared<ShaderCompiler> compiler = ShaderCacheDirectory::CreateCompiler();
+
+        const auto compile = [&](Size begin, Size end)
+        {
+            for (Size p = begin; p < end; ++p)
+                compiler->Compile(vertexPath, L"vs_6_6", { "VARIANT=" + std::to_string(p + 1) });
+        };
+
+        double time = 0.0;
+
+        if (threads == 1)
+            time = serialTime = TestRegistry::Measure([&] { compile(0, PermutationCount); });
+        else
+        {
+            jobSystem->Shutdown();
+            jobSystem->Initialize(threads - 1);
+
+            time = TestRegistry::Measure([&] { jobSystem->ParallelFor(PermutationCount, 1, compile); });
+        }
+
+        Test_Assert(compiler->GetStatistics().cacheMisses == PermutationCount);
+        Test_Assert(compiler->GetStatistics().compilerInstances <= threads + 1);
+
+        TestRegistry::Report("Compile " + std::to_string(PermutationCount) + " permutations on " + std::to_string(threads) + " thread(s)", time, "ms");
+        TestRegistry::Report("Speedup on " + std::to_string(threads) + " thread(s)", serialTime / time, "x");
+    }
+
+    jobSystem->Shutdown();
+    jobSystem->Initialize(Settings::GetInstance()->Get<uint>("workerThreadCount"));
+}
\ No newline at end of file
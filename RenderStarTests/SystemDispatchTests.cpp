@@ -0,0 +1,161 @@
+#include "Test.hpp"
+
+using namespace RenderStar::ECS;
+
+class CountingComponent : public Component
+{
+
+public:
+
+    void Update() override
+    {
+        ++updateCount;
+        value = value * 0.5f + 1.0f;
+    }
+
+    uint updateCount = 0;
+    float value = 0.0f;
+};
+
+class BatchedCountingComponent : public Component
+{
+
+public:
+
+    void Update() override
+    {
+        ++updateCount;
+        value = value * 0.5f + 1.0f;
+    }
+
+    static void UpdateAll(Span<Shared<BatchedCountingComponent>> components)
+    {
+        for (const Shared<BatchedCountingComponent>& component : components)
+        {
+            ++component->updateCount;
+            component->value = component->value * 0.5f + 1.0f;
+        }
+    }
+
+    uint updateCount = 0;
+    float value = 0.0f;
+};
+
+class IdleComponent : public Component
+{
+
+public:
+
+    uint value = 0;
+};
+
+class DispatchSettings
+{
+
+public:
+
+    DispatchSettings()
+    {
+        batched = Settings::GetInstance()->Get<bool>("batchedComponentDispatch");
+        parallel = Settings::GetInstance()->Get<bool>("parallelUpdate");
+
+        Settings::GetInstance()->Set<bool>("parallelUpdate", false);
+    }
+
+    ~DispatchSettings()
+    {
+        Settings::GetInstance()->Set<bool>("batchedComponentDispatch", batched);
+        Settings::GetInstance()->Set<bool>("parallelUpdate", parallel);
+    }
+
+    void SetBatched(bool value) const
+    {
+        Settings::GetInstance()->Set<bool>("batchedComponentDispatch", value);
+    }
+
+private:
+
+    bool batched = false;
+    bool parallel = false;
+};
+
+static Vector<GameObject*> CreateDispatchScene(Size count)
+{
+    Vector<GameObject*> out;
+
+    out.reserve(count);
+
+    for (Size n = 0; n < count; ++n)
+    {
+        GameObject* gameObject = GameObjectManager::GetInstance()->Create("dispatch" + std::to_string(n));
+
+        gameObject->AddComponent(std::make_shared<CountingComponent>());
+        gameObject->AddComponent(std::make_shared<BatchedCountingComponent>());
+        gameObject->AddComponent(std::make_shared<IdleComponent>());
+
+        out.push_back(gameObject);
+    }
+
+    return out;
+}
+
+Test_Case(BatchedAndPerObjectDispatchUpdateEveryComponentOnce)
+{
+    constexpr Size Count = 1000;
+
+    DispatchSettings settings;
+
+    const Vector<GameObject*> gameObjects = CreateDispatchScene(Count);
+
+    settings.SetBatched(false);
+    GameObjectManager::GetInstance()->Update();
+
+    settings.SetBatched(true);
+    GameObjectManager::GetInstance()->Update();
+
+    for (GameObject* gameObject : gameObjects)
+    {
+        Test_Assert(gameObject->GetComponent<CountingComponent>()->updateCount == 2);
+        Test_Assert(gameObject->GetComponent<BatchedCountingComponent>()->updateCount == 2);
+        Test_Assert(gameObject->GetComponent<CountingComponent>()->value == gameObject->GetComponent<BatchedCountingComponent>()->value);
+    }
+}
+
+Test_Benchmark(BatchedVersusPerObjectDispatch)
+{
+    constexpr Size Frames = 20;
+
+    DispatchSettings settings;
+
+    for (Size count : { Size(10000), Size(100000) })
+    {
+        GameObjectManager::GetInstance()->CleanUp();
+
+        const Vector<GameObject*> gameObjects = CreateDispatchScene(count);
+
+        settings.SetBatched(false);
+        GameObjectManager::GetInstance()->Update();
+
+        const double perObjectTime = TestRegistry::Measure([&]
+        {
+            for (Size frame = 0; frame < Frames; ++frame)
+                GameObjectManager::GetInstance()->Update();
+        });
+
+        settings.SetBatched(true);
+        GameObjectManager::GetInstance()->Update();
+
+        const double batchedTime = TestRegistry::Measure([&]
+        {
+            for (Size frame = 0; frame < Frames; ++frame)
+                GameObjectManager::GetInstance()->Update();
+        });
+
+        Test_Assert(gameObjects.front()->GetComponent<CountingComponent>()->updateCount == 2 * Frames + 2);
+        Test_Assert(gameObjects.back()->GetComponent<BatchedCountingComponent>()->updateCount == 2 * Frames + 2);
+
+        TestRegistry::Report("Per-object virtual dispatch over " + std::to_string(count) + " objects", perObjectTime / Frames, "ms");
+        TestRegistry::Report("Batched per-type dispatch over " + std::to_string(count) + " objects", batchedTime / Frames, "ms");
+        TestRegistry::Report("Dispatch speedup at " + std::to_string(count) + " objects", perObjectTime / batchedTime, "x");
+    }
+}
\ No newline at end of file
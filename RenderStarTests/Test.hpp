@@ -0,0 +1,116 @@
+#pragma once
+
+#include "RenderStar/RenderStar.hpp"
+
+#define Test_Case(name) static void name(); static RenderStar::Tests::TestRegistration name##Registration(#name, name, false); static void name()
+#define Test_Benchmark(name) static void name(); static RenderStar::Tests::TestRegistration name##Registration(#name, name, true); static void name()
+#define Test_Assert(condition) RenderStar::Tests::TestRegistry::Assert(condition, #condition, __FILE__, __LINE__)
+
+using namespace RenderStar::Core;
+using namespace RenderStar::Util;
+
+namespace RenderStar
+{
+	namespace Tests
+	{
+        struct TestFailure
+        {
+            String message;
+        };
+
+        struct TestCase
+        {
+            String name;
+            Function<void()> function;
+            bool isBenchmark = false;
+        };
+
+        class TestRegistry
+        {
+
+        public:
+
+            void Register(const String& name, Function<void()> function, bool isBenchmark)
+            {
+                tests.push_back({ name, std::move(function), isBenchmark });
+            }
+
+            int Run(const String& filter, bool includeBenchmarks)
+            {
+                Size passed = 0;
+                Size failed = 0;
+
+                for (const TestCase& test : tests)
+                {
+                    if ((test.isBenchmark && !includeBenchmarks) || test.name.find(filter) == String::npos)
+                        continue;
+
+                    GameObjectManager::GetInstance()->CleanUp();
+
+                    const TimePoint start = Clock::now();
+
+                    try
+                    {
+                        test.function();
+
+                        Logger_WriteConsole("Passed " + test.name + " in " + std::to_string(std::chrono::duration<double, std::milli>(Clock::now() - start).count()) + " ms", LogLevel::INFORMATION);
+                        passed++;
+                    }
+                    catch (const TestFailure& failure)
+                    {
+                        Logger_WriteConsole("Failed " + test.name + ": " + failure.message, LogLevel::ERROR);
+                        failed++;
+                    }
+                }
+
+                GameObjectManager::GetInstance()->CleanUp();
+
+                Logger_WriteConsole(std::to_string(passed) + " passed, " + std::to_string(failed) + " failed", failed == 0 ? LogLevel::INFORMATION : LogLevel::ERROR);
+
+                return failed == 0 ? 0 : 1;
+            }
+
+            static void Assert(bool condition, const char* expression, const char* file, int line)
+            {
+                if (!condition)
+                    throw TestFailure{ String(file) + "(" + std::to_string(line) + "): " + expression };
+            }
+
+            static void Report(const String& name, double value, const String& unit)
+            {
+                Logger_WriteConsole(name + ": " + std::to_string(value) + " " + unit, LogLevel::INFORMATION);
+            }
+
+            template<typename F>
+            static double Measure(F&& function)
+            {
+                const TimePoint start = Clock::now();
+
+                function();
+
+                return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+            }
+
+            static Shared<TestRegistry> GetInstance()
+            {
+                static Shared<TestRegistry> instance = std::make_shared<TestRegistry>();
+
+                return instance;
+            }
+
+        private:
+
+            Vector<TestCase> tests;
+        };
+
+        struct TestRegistration
+        {
+            TestRegistration(const char* name, void(*function)(), bool isBenchmark)
+            {
+                TestRegistry::GetInstance()->Register(name, function, isBenchmark);
+            }
+        };
+	}
+}
+
+using namespace RenderStar::Tests;
\ No newline at end of file
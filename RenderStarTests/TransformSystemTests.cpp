@@ -0,0 +1,242 @@
+#include "Test.hpp"
+
+using namespace RenderStar::Math;
+
+static constexpr Size RootNode = std::numeric_limits<Size>::max();
+
+class ReferenceTransform
+{
+
+public:
+
+    Matrix4f GetWorldMatrix()
+    {
+        if (isDirty)
+        {
+            const Matrix4f local = DirectX::XMMatrixMultiply(DirectX::XMMatrixMultiply(DirectX::XMMatrixScalingFromVector(scale), DirectX::XMMatrixRotationRollPitchYawFromVector(rotation)), DirectX::XMMatrixTranslationFromVector(position));
+
+            worldMatrix = parent ? DirectX::XMMatrixMultiply(local, parent->GetWorldMatrix()) : local;
+            isDirty = false;
+        }
+
+        return worldMatrix;
+    }
+
+    XMVector position = DirectX::XMVectorSet(0.0f, 0.0f, 0.0f, 0.0f);
+    XMVector rotation = DirectX::XMVectorSet(0.0f, 0.0f, 0.0f, 0.0f);
+    XMVector scale = DirectX::XMVectorSet(1.0f, 1.0f, 1.0f, 1.0f);
+
+    ReferenceTransform* parent = nullptr;
+    bool isDirty = true;
+
+private:
+
+    Matrix4f worldMatrix = DirectX::XMMatrixIdentity();
+};
+
+struct TransformHierarchy
+{
+    TransformSystem system;
+
+    Vector<TransformHandle> handles;
+    Vector<Unique<ReferenceTransform>> references;
+    Vector<Size> parents;
+
+    void Build(Size count, const Function<Size(Size)>& parentOf)
+    {
+        std::mt19937 random(7);
+        std::uniform_real_distribution<float> position(-10.0f, 10.0f);
+        std::uniform_real_distribution<float> angle(-3.14159f, 3.14159f);
+        std::uniform_real_distribution<float> scale(0.5f, 2.0f);
+
+        system.Reserve(count);
+
+        handles.resize(count);
+        references.resize(count);
+        parents.resize(count);
+
+        for (Size n = count; n-- > 0;)
+        {
+            handles[n] = system.Allocate();
+            references[n] = std::make_unique<ReferenceTransform>();
+        }
+
+        for (Size n = 0; n < count; ++n)
+        {
+            ReferenceTransform& reference = *references[n];
+
+            reference.position = DirectX::XMVectorSet(position(random), position(random), position(random), 0.0f);
+            reference.rotation = DirectX::XMVectorSet(angle(random), angle(random), angle(random), 0.0f);
+            reference.scale = DirectX::XMVectorSet(scale(random), scale(random), scale(random), 0.0f);
+
+            system.SetLocalPosition(handles[n], reference.position);
+            system.SetLocalRotation(handles[n], reference.rotation);
+            system.SetLocalScale(handles[n], reference.scale);
+
+            SetParent(n, parentOf(n));
+        }
+    }
+
+    void SetParent(Size node, Size parent)
+    {
+        parents[node] = parent;
+
+        references[node]->parent = parent == RootNode ? nullptr : references[parent].get();
+        system.SetParent(handles[node], parent == RootNode ? InvalidTransformHandle : handles[parent]);
+    }
+
+    void SetLocalPosition(Size node, const XMVector& position)
+    {
+        references[node]->position = position;
+        system.SetLocalPosition(handles[node], position);
+    }
+
+    void InvalidateReferences()
+    {
+        for (const Unique<ReferenceTransform>& reference : references)
+            reference->isDirty = true;
+    }
+
+    Size CountSubtree(Size root) const
+    {
+        Size out = 0;
+
+        for (Size n = 0; n < parents.size(); ++n)
+        {
+            Size ancestor = n;
+
+            while (ancestor != RootNode && ancestor != root)
+                ancestor = parents[ancestor];
+
+            out += ancestor == root;
+        }
+
+        return out;
+    }
+};
+
+static bool MatricesMatch(const Matrix4f& first, const Matrix4f& second)
+{
+    DirectX::XMFLOAT4X4 a;
+    DirectX::XMFLOAT4X4 b;
+
+    DirectX::XMStoreFloat4x4(&a, first);
+    DirectX::XMStoreFloat4x4(&b, second);
+
+    for (int r = 0; r < 4; ++r)
+    {
+        for (int c = 0; c < 4; ++c)
+        {
+            if (std::fabs(a.m[r][c] - b.m[r][c]) > 1e-3f * std::max(1.0f, std::fabs(b.m[r][c])))
+                return false;
+        }
+    }
+
+    return true;
+}
+
+static bool HierarchyMatchesReference(TransformHierarchy& hierarchy)
+{
+    for (Size n = 0; n < hierarchy.handles.size(); ++n)
+    {
+        if (!MatricesMatch(hierarchy.system.GetWorldMatrix(hierarchy.handles[n]), hierarchy.references[n]->GetWorldMatrix()))
+            return false;
+    }
+
+    return true;
+}
+
+Test_Case(SoAWorldMatricesMatchPerObjectMath)
+{
+    constexpr Size Count = 256;
+
+    TransformHierarchy hierarchy;
+
+    hierarchy.Build(Count, [](Size n) { return n == 0 ? RootNode : (n - 1) / 3; });
+    hierarchy.system.Update();
+
+    Test_Assert(hierarchy.system.GetLastUpdatedCount() == Count);
+    Test_Assert(HierarchyMatchesReference(hierarchy));
+
+    hierarchy.SetLocalPosition(1, DirectX::XMVectorSet(4.0f, -2.0f, 9.0f, 0.0f));
+    hierarchy.InvalidateReferences();
+
+    Test_Assert(MatricesMatch(hierarchy.system.GetWorldMatrix(hierarchy.handles[13]), hierarchy.references[13]->GetWorldMatrix()));
+
+    hierarchy.system.Update();
+
+    Test_Assert(hierarchy.system.GetLastUpdatedCount() == hierarchy.CountSubtree(1));
+    Test_Assert(HierarchyMatchesReference(hierarchy));
+
+    hierarchy.SetParent(2, 4);
+    hierarchy.InvalidateReferences();
+    hierarchy.system.Update();
+
+    Test_Assert(hierarchy.system.GetLastUpdatedCount() == hierarchy.CountSubtree(2));
+    Test_Assert(HierarchyMatchesReference(hierarchy));
+}
+
+Test_Benchmark(TransformPropagationDeepAndWide)
+{
+    constexpr Size Count = 100000;
+    constexpr Size ChainLength = 64;
+    constexpr Size Frames = 10;
+
+    const Array<Pair<String, Function<Size(Size)>>, 2> shapes =
+    {
+        Pair<String, Function<Size(Size)>>{ "deep", [](Size n) { return n % ChainLength == 0 ? RootNode : n - 1; } },
+        Pair<String, Function<Size(Size)>>{ "wide", [](Size n) { return n == 0 ? RootNode : 0; } }
+    };
+
+    for (const auto& [name, parentOf] : shapes)
+    {
+        TransformHierarchy hierarchy;
+
+        hierarchy.Build(Count, parentOf);
+
+        Vector<Size> roots;
+
+        for (Size n = 0; n < Count; ++n)
+        {
+            if (hierarchy.parents[n] == RootNode)
+                roots.push_back(n);
+        }
+
+        const auto moveRoots = [&](Size frame)
+        {
+            for (Size root : roots)
+                hierarchy.SetLocalPosition(root, DirectX::XMVectorSet(static_cast<float>(frame), 0.0f, 0.0f, 0.0f));
+        };
+
+        hierarchy.system.Update();
+
+        const double systemTime = TestRegistry::Measure([&]
+        {
+            for (Size frame = 0; frame < Frames; ++frame)
+            {
+                moveRoots(frame);
+                hierarchy.system.Update();
+            }
+        });
+
+        Test_Assert(hierarchy.system.GetLastUpdatedCount() == Count);
+
+        const double referenceTime = TestRegistry::Measure([&]
+        {
+            for (Size frame = 0; frame < Frames; ++frame)
+            {
+                hierarchy.InvalidateReferences();
+
+                for (const Unique<ReferenceTransform>& reference : hierarchy.references)
+                    reference->GetWorldMatrix();
+            }
+        });
+
+        Test_Assert(HierarchyMatchesReference(hierarchy));
+
+        TestRegistry::Report("SoA transform update, " + name + " hierarchy of " + std::to_string(Count), systemTime / Frames, "ms");
+        TestRegistry::Report("SoA transform throughput, " + name + " hierarchy", Count * Frames / (systemTime / 1000.0) / 1e6, "M matrices/s");
+        TestRegistry::Report("Per-object transform update, " + name + " hierarchy of " + std::to_string(Count), referenceTime / Frames, "ms");
+        TestRegistry::Report("Per-object transform throughput, " + name + " hierarchy", Count * Frames / (referenceTime / 1000.0) / 1e6, "M matrices/s");
+    }
+}
\ No newline at end of file